@@ -19,7 +19,9 @@
  * Initializes all private members with default values.
  */
 Appetizer::Appetizer()
-    : Dish(), serving_style_(PLATED), spiciness_level_(0), vegetarian_(false) {}
+    : Dish(), serving_style_(PLATED), spiciness_level_(0), vegetarian_(false) {
+    updateCompatibility();
+}
 
 /**
  * Parameterized constructor.
@@ -33,7 +35,9 @@ Appetizer::Appetizer()
  * @param vegetarian Flag indicating if the appetizer is vegetarian.
  */
 Appetizer::Appetizer(const std::string& name, const std::vector<std::string>& ingredients, const int &prep_time, const double &price, const CuisineType &cuisine_type, const ServingStyle &serving_style, const int &spiciness_level, const bool &vegetarian)
-    : Dish(name, ingredients, prep_time, price, cuisine_type), serving_style_(serving_style), spiciness_level_(spiciness_level), vegetarian_(vegetarian) {}
+    : Dish(name, ingredients, prep_time, price, cuisine_type), serving_style_(serving_style), spiciness_level_(spiciness_level), vegetarian_(vegetarian) {
+    updateCompatibility();
+}
 
 /**
  * Sets the serving style of the appetizer.
@@ -42,6 +46,7 @@ Appetizer::Appetizer(const std::string& name, const std::vector<std::string>& in
  */
 void Appetizer::setServingStyle(const ServingStyle &serving_style) {
     serving_style_ = serving_style;
+    touch();
 }
 
 /**
@@ -58,6 +63,7 @@ Appetizer::ServingStyle Appetizer::getServingStyle() const {
  */
 void Appetizer::setSpicinessLevel(const int &spiciness_level) {
     spiciness_level_ = spiciness_level;
+    touch();
 }
 
 /**
@@ -74,6 +80,7 @@ int Appetizer::getSpicinessLevel() const {
  */
 void Appetizer::setVegetarian(const bool &vegetarian) {
     vegetarian_ = vegetarian;
+    touch();
 }
 
 /**
@@ -154,45 +161,70 @@ void Appetizer::display() const {
     "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust".
 */
 void Appetizer::dietaryAccommodations(const DietaryRequest& request) {
-    std::vector<std::string> ingredients = getIngredients();
+    // The rules are in dietaryDelta(), so that DietaryViews can present the adjusted appetizer without changing it.
+    Appetizer::applyDietaryDelta(Appetizer::dietaryDelta(request));
+}
+
+/**
+ * @return What dietaryAccommodations(request) would change, leaving the appetizer unchanged.
+ */
+Dish::DietaryDelta Appetizer::dietaryDelta(const DietaryRequest& request) const {
+    DietaryDelta delta;
+    const IngredientList& ingredients = getIngredientList();
 
     // Handle vegetarian request
     if (request.vegetarian) {
-        vegetarian_ = true;
-
-        std::vector<std::string> non_veg_ingredients = {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"};
-        int replacement_count = 0;
-        for (auto& ingredient : ingredients) {
-            if (std::find(non_veg_ingredients.begin(), non_veg_ingredients.end(), ingredient) != non_veg_ingredients.end()) {
-                if (replacement_count == 0) {
-                    ingredient = "Beans";  // First replacement
-                } else if (replacement_count == 1) {
-                    ingredient = "Mushrooms";  // Second replacement
-                } else {
-                    ingredient = "";  // Remove additional non-veg ingredients
-                }
-                replacement_count++;
-            }
-        }
-        ingredients.erase(std::remove(ingredients.begin(), ingredients.end(), ""), ingredients.end());
+        delta.marks |= DietaryDelta::MARK_VEGETARIAN;
+        replaceMeatAndFish(ingredients, delta);
     }
 
     // Handle low sodium request
-    if (request.low_sodium) {
-        spiciness_level_ = std::max(spiciness_level_ - 2, 0);  // Reduce spiciness, minimum 0
+    if (request.low_sodium && std::max(spiciness_level_ - 2, 0) != spiciness_level_) {
+        delta.level = std::max(spiciness_level_ - 2, 0);  // Reduce spiciness, minimum 0
     }
 
     // Handle gluten-free request
     if (request.gluten_free) {
-        std::vector<std::string> gluten_ingredients = {"Wheat", "Flour", "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust"};
-        for (auto& ingredient : ingredients) {
-            if (std::find(gluten_ingredients.begin(), gluten_ingredients.end(), ingredient) != gluten_ingredients.end()) {
-                ingredient = "";  // Remove gluten ingredients
-            }
-        }
-        ingredients.erase(std::remove(ingredients.begin(), ingredients.end(), ""), ingredients.end());
+        static const std::vector<std::string> gluten_ingredients = {"Wheat", "Flour", "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust"};
+        dropIngredients(ingredients, gluten_ingredients, delta);
+        dropEmptyIngredients(ingredients, delta);
     }
+    return delta;
+}
 
+/**
+ * Applies a delta from dietaryDelta(), as dietaryAccommodations() would.
+ */
+void Appetizer::applyDietaryDelta(const DietaryDelta& delta) {
+    if (delta.marks & DietaryDelta::MARK_VEGETARIAN) {
+        vegetarian_ = true;
+    }
+    if (delta.level >= 0) {
+        spiciness_level_ = delta.level;
+    }
     // Set the updated ingredients
-    setIngredients(ingredients);
+    setIngredients(delta.applyTo(getIngredientList()));
+}
+
+/**
+ * @return A newly allocated copy of this appetizer. The caller owns it.
+ */
+Appetizer* Appetizer::clone() const {
+    return new Appetizer(*this);
+}
+
+/**
+ * @return The Dish mask, narrowed by the vegetarian flag (required for VEGETARIAN and VEGAN) and
+ * spiciness (LOW_SODIUM only at level 0, where the accommodation changes
+ * nothing).
+ */
+uint8_t Appetizer::computeCompatibility() const {
+    uint8_t mask = Dish::computeCompatibility();
+    if (!vegetarian_) {
+        mask &= ~(VEGETARIAN | VEGAN);
+    }
+    if (spiciness_level_ > 0) {
+        mask &= ~LOW_SODIUM;
+    }
+    return mask;
 }
@@ -129,6 +129,29 @@ public:
     */
     void dietaryAccommodations(const DietaryRequest& request) override;
 
+    /**
+     * @return What dietaryAccommodations(request) would change, leaving the appetizer unchanged.
+     */
+    DietaryDelta dietaryDelta(const DietaryRequest& request) const override;
+
+    /**
+     * Applies a delta from dietaryDelta(), as dietaryAccommodations() would.
+     */
+    void applyDietaryDelta(const DietaryDelta& delta) override;
+
+    /**
+     * @return A newly allocated copy of this appetizer. The caller owns it.
+     */
+    Appetizer* clone() const override;
+
+protected:
+    /**
+     * @return The Dish mask, narrowed by the vegetarian flag (required for VEGETARIAN and VEGAN) and
+     * spiciness (LOW_SODIUM only at level 0, where the accommodation changes
+     * nothing).
+     */
+    uint8_t computeCompatibility() const override;
+
 private:
     ServingStyle serving_style_; ///< The serving style of the appetizer.
     int spiciness_level_; ///< The spiciness level of the appetizer.
@@ -0,0 +1,118 @@
+/**
+ * @file Benchmark.cpp
+ * @brief This file contains the implementation of the Benchmark class, a small self-contained timing harness.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+/**
+ * Parameterized constructor.
+ * @param warmup The number of untimed repetitions run before measuring.
+ * @param repetitions The number of timed repetitions (at least 1).
+ * @param filter Only cases whose name contains this substring are run; empty runs every case.
+ */
+Benchmark::Benchmark(const int& warmup, const int& repetitions, const std::string& filter)
+    : warmup_(std::max(warmup, 0)), repetitions_(std::max(repetitions, 1)), filter_(filter) {}
+
+/**
+ * Runs one case and records its result.
+ * @param name The case name, e.g. "arraybag.add".
+ * @param size The catalog size the case runs at.
+ * @param ops The number of operations one repetition of `body` performs, used to report per-op times.
+ * @param setup Called before every repetition, outside the timed region. May be empty.
+ * @param body The timed code.
+ * @param teardown Called after every repetition, outside the timed region. May be empty.
+ */
+void Benchmark::run(const std::string& name, const int& size, const long& ops,
+                    const std::function<void()>& setup, const std::function<void()>& body,
+                    const std::function<void()>& teardown) {
+    if (!filter_.empty() && name.find(filter_) == std::string::npos) {
+        return;
+    }
+
+    std::vector<double> samples;
+    for (int rep = 0; rep < warmup_ + repetitions_; rep++) {
+        if (setup) {
+            setup();
+        }
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        if (teardown) {
+            teardown();
+        }
+        if (rep >= warmup_) {
+            double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+            samples.push_back(elapsed / std::max(ops, 1L));
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    size_t p99_rank = static_cast<size_t>(std::ceil(0.99 * samples.size()));
+
+    Result result;
+    result.name = name;
+    result.size = size;
+    result.ops = ops;
+    result.repetitions = repetitions_;
+    result.min_ns = samples.front();
+    result.median_ns = samples.size() % 2 == 1 ? samples[samples.size() / 2]
+        : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2;
+    result.p99_ns = samples[p99_rank == 0 ? 0 : p99_rank - 1];
+    result.mean_ns = sum / samples.size();
+    results_.push_back(result);
+
+    std::cerr << "  " << name << " @ " << size << ": " << std::fixed << std::setprecision(1)
+              << result.median_ns << " ns/op" << std::endl;
+}
+
+/**
+ * @return The results recorded so far, in the order the cases ran.
+ */
+const std::vector<Benchmark::Result>& Benchmark::getResults() const {
+    return results_;
+}
+
+/**
+ * Prints every recorded result.
+ * @param out The stream to print to.
+ * @param format The output format.
+ */
+void Benchmark::report(std::ostream& out, const Format& format) const {
+    out << std::fixed << std::setprecision(1);
+    if (format == CSV) {
+        out << "name,size,ops,repetitions,min_ns,median_ns,p99_ns,mean_ns" << std::endl;
+        for (const Result& r : results_) {
+            out << r.name << ',' << r.size << ',' << r.ops << ',' << r.repetitions << ','
+                << r.min_ns << ',' << r.median_ns << ',' << r.p99_ns << ',' << r.mean_ns << std::endl;
+        }
+    } else if (format == JSON) {
+        out << "{\"unit\": \"ns/op\", \"results\": [";
+        for (size_t i = 0; i < results_.size(); i++) {
+            const Result& r = results_[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "  {\"name\": \"" << r.name << "\", \"size\": " << r.size << ", \"ops\": " << r.ops
+                << ", \"repetitions\": " << r.repetitions << ", \"min\": " << r.min_ns
+                << ", \"median\": " << r.median_ns << ", \"p99\": " << r.p99_ns << ", \"mean\": " << r.mean_ns << "}";
+        }
+        out << "\n]}" << std::endl;
+    } else {
+        out << std::left << std::setw(36) << "case" << std::right << std::setw(8) << "size"
+            << std::setw(14) << "median ns/op" << std::setw(14) << "p99 ns/op" << std::setw(14) << "min ns/op" << std::endl;
+        for (const Result& r : results_) {
+            out << std::left << std::setw(36) << r.name << std::right << std::setw(8) << r.size
+                << std::setw(14) << r.median_ns << std::setw(14) << r.p99_ns << std::setw(14) << r.min_ns << std::endl;
+        }
+    }
+}
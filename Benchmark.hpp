@@ -0,0 +1,96 @@
+/**
+ * @file Benchmark.hpp
+ * @brief This file contains the declaration of the Benchmark class, a small self-contained timing harness.
+ *
+ * Each case is run a number of untimed warmup repetitions followed by timed repetitions. An optional setup
+ * and teardown run outside the timed region of every repetition, so cases that consume their input (such as
+ * serving every dish) can rebuild it. Results are reported per operation as min, median, p99 and mean, in a
+ * human-readable table, CSV, or JSON.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class Benchmark {
+    public:
+        /**
+         * @enum Format
+         * @brief How report() prints results.
+         */
+        enum Format { TEXT, CSV, JSON };
+
+        /**
+         * @struct Result
+         * @brief Timings of one case at one size. All times are nanoseconds per operation.
+         */
+        struct Result {
+            std::string name;
+            int size;
+            long ops;           ///< Operations performed by one repetition of the body.
+            int repetitions;
+            double min_ns;
+            double median_ns;
+            double p99_ns;
+            double mean_ns;
+        };
+
+        /**
+         * Parameterized constructor.
+         * @param warmup The number of untimed repetitions run before measuring.
+         * @param repetitions The number of timed repetitions (at least 1).
+         * @param filter Only cases whose name contains this substring are run; empty runs every case.
+         */
+        Benchmark(const int& warmup, const int& repetitions, const std::string& filter = "");
+
+        /**
+         * Runs one case and records its result.
+         * @param name The case name, e.g. "arraybag.add".
+         * @param size The catalog size the case runs at.
+         * @param ops The number of operations one repetition of `body` performs, used to report per-op times.
+         * @param setup Called before every repetition, outside the timed region. May be empty.
+         * @param body The timed code.
+         * @param teardown Called after every repetition, outside the timed region. May be empty.
+         */
+        void run(const std::string& name, const int& size, const long& ops,
+                 const std::function<void()>& setup, const std::function<void()>& body,
+                 const std::function<void()>& teardown);
+
+        /**
+         * @return The results recorded so far, in the order the cases ran.
+         */
+        const std::vector<Result>& getResults() const;
+
+        /**
+         * Prints every recorded result.
+         * @param out The stream to print to.
+         * @param format The output format.
+         */
+        void report(std::ostream& out, const Format& format) const;
+
+    private:
+        int warmup_;
+        int repetitions_;
+        std::string filter_;
+        std::vector<Result> results_;
+};
+
+/**
+ * A stream buffer that discards everything written to it, used to time output-heavy functions such as
+ * Kitchen::displayMenu without measuring the terminal. Unlike a null rdbuf, it keeps the stream in a good
+ * state, so all formatting work still happens.
+ */
+class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+#endif // BENCHMARK_HPP
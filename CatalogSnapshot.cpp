@@ -0,0 +1,464 @@
+/**
+ * @file CatalogSnapshot.cpp
+ * @brief This file contains the implementation of the CatalogSnapshot class: the snapshot writer, the mmap
+ * reader and dish materialization.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "CatalogSnapshot.hpp"
+#include "DishCodec.hpp"
+#include "Kitchen.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(CatalogSnapshot::Header) == 96, "snapshot header layout changed");
+static_assert(sizeof(CatalogSnapshot::Record) == 48, "snapshot record layout changed");
+
+namespace {
+    const char MAGIC[8] = {'K', 'C', 'A', 'T', 'S', 'N', 'A', 'P'};
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /**
+     * Assigns each distinct string one id, in order of first appearance.
+     */
+    class StringTable {
+        public:
+            uint32_t intern(const std::string& text) {
+                auto found = ids_.find(text);
+                if (found != ids_.end()) {
+                    return found->second;
+                }
+                uint32_t id = static_cast<uint32_t>(index_.size() / 2);
+                index_.push_back(static_cast<uint32_t>(bytes_.size()));
+                index_.push_back(static_cast<uint32_t>(text.size()));
+                bytes_ += text;
+                ids_.emplace(text, id);
+                return id;
+            }
+
+            const std::vector<uint32_t>& index() const {
+                return index_;
+            }
+
+            const std::string& bytes() const {
+                return bytes_;
+            }
+
+        private:
+            std::unordered_map<std::string, uint32_t> ids_;
+            std::vector<uint32_t> index_;
+            std::string bytes_;
+    };
+
+    /**
+     * @return `offset` rounded up to a multiple of `alignment`.
+     */
+    uint64_t alignUp(const uint64_t& offset, const uint64_t& alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @return True if [offset, offset + count * size) lies within an image of `image_size` bytes.
+     */
+    bool sectionFits(const uint64_t& offset, const uint64_t& count, const uint64_t& size,
+                     const uint64_t& image_size) {
+        return offset <= image_size && count <= (image_size - offset) / size;
+    }
+}
+
+/**
+ * Serializes dishes into a snapshot image.
+ * @param dishes The dishes to store, in order.
+ * @param sequence Stored in the header and returned by getSequence().
+ * @return The image bytes.
+ */
+std::vector<char> CatalogSnapshot::serialize(const std::vector<Dish*>& dishes, const uint64_t& sequence) {
+    KITCHEN_TRACE_SCOPE("snapshot.serialize");
+    StringTable strings;
+    std::vector<Record> records(dishes.size());
+    std::vector<uint32_t> refs;
+
+    for (size_t i = 0; i < dishes.size(); i++) {
+        const Dish* dish = dishes[i];
+        Record& record = records[i];
+        std::memset(&record, 0, sizeof(record));
+        record.cuisine = static_cast<uint8_t>(DishCodec::cuisineOf(*dish));
+        record.prep_time = dish->getPrepTime();
+        record.price = dish->getPrice();
+        record.name = strings.intern(dish->getName());
+
+        const Dish::IngredientList& ingredients = dish->getIngredientList();
+        record.ingredients_first = static_cast<uint32_t>(refs.size());
+        record.ingredients_count = static_cast<uint32_t>(ingredients.size());
+        for (const std::string& ingredient : ingredients) {
+            refs.push_back(strings.intern(ingredient));
+        }
+
+        if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(dish)) {
+            record.type = APPETIZER;
+            record.style = static_cast<uint8_t>(appetizer->getServingStyle());
+            record.level = appetizer->getSpicinessLevel();
+            record.flag = appetizer->isVegetarian();
+        } else if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(dish)) {
+            record.type = MAINCOURSE;
+            record.style = static_cast<uint8_t>(main_course->getCookingMethod());
+            record.flag = main_course->isGlutenFree();
+            record.protein = strings.intern(main_course->getProteinType());
+            const MainCourse::SideDishList& sides = main_course->getSideDishList();
+            record.sides_first = static_cast<uint32_t>(refs.size());
+            record.sides_count = static_cast<uint32_t>(sides.size());
+            for (const MainCourse::SideDish& side : sides) {
+                refs.push_back(strings.intern(side.name));
+                refs.push_back(static_cast<uint32_t>(side.category));
+            }
+        } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(dish)) {
+            record.type = DESSERT;
+            record.style = static_cast<uint8_t>(dessert->getFlavorProfile());
+            record.level = dessert->getSweetnessLevel();
+            record.flag = dessert->containsNuts();
+        }
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.sequence = sequence;
+    header.record_count = records.size();
+    header.records_offset = sizeof(Header);
+    header.ref_count = refs.size();
+    header.refs_offset = header.records_offset + records.size() * sizeof(Record);
+    header.string_count = strings.index().size() / 2;
+    header.string_index_offset = header.refs_offset + refs.size() * sizeof(uint32_t);
+    header.string_bytes_offset = header.string_index_offset + strings.index().size() * sizeof(uint32_t);
+    header.string_bytes_size = strings.bytes().size();
+    // Padding the image keeps the records of a following image 8-byte aligned when images are concatenated.
+    header.image_size = alignUp(header.string_bytes_offset + header.string_bytes_size, alignof(Record));
+
+    std::vector<char> image(header.image_size, 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    if (!records.empty()) {
+        std::memcpy(image.data() + header.records_offset, records.data(), records.size() * sizeof(Record));
+    }
+    if (!refs.empty()) {
+        std::memcpy(image.data() + header.refs_offset, refs.data(), refs.size() * sizeof(uint32_t));
+    }
+    if (!strings.index().empty()) {
+        std::memcpy(image.data() + header.string_index_offset, strings.index().data(),
+                    strings.index().size() * sizeof(uint32_t));
+        std::memcpy(image.data() + header.string_bytes_offset, strings.bytes().data(), strings.bytes().size());
+    }
+    return image;
+}
+
+/**
+ * Writes a snapshot of every dish in `kitchen` to `path`. The image is written to a temporary file and
+ * renamed into place, so readers never see a partial snapshot.
+ * @return True if the snapshot was written.
+ */
+bool CatalogSnapshot::save(const Kitchen& kitchen, const std::string& path, const uint64_t& sequence) {
+    std::vector<char> image = serialize(kitchen.toVector(), sequence);
+    std::string temp_path = path + ".tmp";
+    int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < image.size()) {
+        ssize_t n = ::write(fd, image.data() + written, image.size() - written);
+        if (n <= 0) {
+            ::close(fd);
+            std::remove(temp_path.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    bool ok = ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+CatalogSnapshot::CatalogSnapshot()
+    : data_(nullptr), size_(0), mapping_(nullptr), mapping_size_(0), header_(nullptr), records_(nullptr) {}
+
+/**
+ * Destructor.
+ * @post Unmaps the file, if one is open.
+ */
+CatalogSnapshot::~CatalogSnapshot() {
+    close();
+}
+
+/**
+ * Memory-maps a snapshot file read-only.
+ * @param path The snapshot file.
+ * @return True if the file was mapped and its header is valid; false leaves the snapshot closed.
+ */
+bool CatalogSnapshot::open(const std::string& path) {
+    KITCHEN_TIME_SCOPE("snapshot.open.ns");
+    KITCHEN_TRACE_SCOPE("snapshot.open");
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = mapping;
+    mapping_size_ = info.st_size;
+    data_ = static_cast<const char*>(mapping);
+    size_ = mapping_size_;
+    if (!validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Reads a snapshot image that lives elsewhere in memory, without copying it.
+ * @param data The start of the image; must stay valid until close() or destruction.
+ * @param size The number of readable bytes at `data`.
+ * @return True if the header is valid; false leaves the snapshot closed.
+ */
+bool CatalogSnapshot::attach(const void* data, const size_t& size) {
+    close();
+    data_ = static_cast<const char*>(data);
+    size_ = size;
+    if (!validate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Releases the mapping or attached image.
+ */
+void CatalogSnapshot::close() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    header_ = nullptr;
+    records_ = nullptr;
+}
+
+bool CatalogSnapshot::isOpen() const {
+    return header_ != nullptr;
+}
+
+/**
+ * @return The number of dishes in the snapshot.
+ */
+size_t CatalogSnapshot::size() const {
+    return header_ == nullptr ? 0 : header_->record_count;
+}
+
+/**
+ * @return The sequence number given to serialize() or save().
+ */
+uint64_t CatalogSnapshot::getSequence() const {
+    return header_ == nullptr ? 0 : header_->sequence;
+}
+
+/**
+ * @pre i < size()
+ * @return The fixed-size record of dish i, read directly from the image.
+ */
+const CatalogSnapshot::Record& CatalogSnapshot::record(const size_t& i) const {
+    return records_[i];
+}
+
+/**
+ * @return The text of string `id`, or an empty view if the id is out of range.
+ */
+std::string_view CatalogSnapshot::string(const uint32_t& id) const {
+    if (header_ == nullptr || id >= header_->string_count) {
+        return std::string_view();
+    }
+    uint32_t entry[2];
+    std::memcpy(entry, data_ + header_->string_index_offset + id * sizeof(entry), sizeof(entry));
+    if (entry[0] > header_->string_bytes_size || entry[1] > header_->string_bytes_size - entry[0]) {
+        return std::string_view();
+    }
+    return std::string_view(data_ + header_->string_bytes_offset + entry[0], entry[1]);
+}
+
+/**
+ * @pre i < size()
+ * @return The name of dish i.
+ */
+std::string_view CatalogSnapshot::name(const size_t& i) const {
+    return string(records_[i].name);
+}
+
+/**
+ * @pre i < size()
+ * @return The ingredients of dish i, as views into the image.
+ */
+std::vector<std::string_view> CatalogSnapshot::ingredients(const size_t& i) const {
+    const Record entry = records_[i];
+    std::vector<std::string_view> result;
+    if (static_cast<uint64_t>(entry.ingredients_first) + entry.ingredients_count > header_->ref_count) {
+        return result;
+    }
+    result.reserve(entry.ingredients_count);
+    for (uint32_t k = 0; k < entry.ingredients_count; k++) {
+        result.push_back(string(ref(entry.ingredients_first + k)));
+    }
+    return result;
+}
+
+/**
+ * Builds dish i as a heap-allocated Appetizer, MainCourse or Dessert.
+ * @pre i < size()
+ * @return The new dish, owned by the caller, or nullptr if the record is corrupt.
+ */
+Dish* CatalogSnapshot::materialize(const size_t& i) const {
+    // Copied once, so the fields checked below are the ones used.
+    const Record entry = records_[i];
+    if (entry.cuisine > Dish::OTHER
+        || static_cast<uint64_t>(entry.ingredients_first) + entry.ingredients_count > header_->ref_count
+        || static_cast<uint64_t>(entry.sides_first) + 2 * static_cast<uint64_t>(entry.sides_count)
+               > header_->ref_count) {
+        return nullptr;
+    }
+
+    std::string dish_name(string(entry.name));
+    std::vector<std::string> dish_ingredients;
+    dish_ingredients.reserve(entry.ingredients_count);
+    for (uint32_t k = 0; k < entry.ingredients_count; k++) {
+        dish_ingredients.emplace_back(string(ref(entry.ingredients_first + k)));
+    }
+    Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(entry.cuisine);
+
+    switch (entry.type) {
+        case APPETIZER:
+            if (entry.style > Appetizer::BUFFET) {
+                return nullptr;
+            }
+            return new Appetizer(dish_name, dish_ingredients, entry.prep_time, entry.price, cuisine,
+                                 static_cast<Appetizer::ServingStyle>(entry.style), entry.level, entry.flag != 0);
+        case MAINCOURSE: {
+            if (entry.style > MainCourse::RAW) {
+                return nullptr;
+            }
+            std::vector<MainCourse::SideDish> sides;
+            sides.reserve(entry.sides_count);
+            for (uint32_t k = 0; k < entry.sides_count; k++) {
+                uint32_t category = ref(entry.sides_first + 2 * static_cast<uint64_t>(k) + 1);
+                if (category > MainCourse::VEGETABLE) {
+                    return nullptr;
+                }
+                sides.push_back({std::string(string(ref(entry.sides_first + 2 * static_cast<uint64_t>(k)))),
+                                 static_cast<MainCourse::Category>(category)});
+            }
+            return new MainCourse(dish_name, dish_ingredients, entry.prep_time, entry.price, cuisine,
+                                  static_cast<MainCourse::CookingMethod>(entry.style),
+                                  std::string(string(entry.protein)), sides, entry.flag != 0);
+        }
+        case DESSERT:
+            if (entry.style > Dessert::UMAMI) {
+                return nullptr;
+            }
+            return new Dessert(dish_name, dish_ingredients, entry.prep_time, entry.price, cuisine,
+                               static_cast<Dessert::FlavorProfile>(entry.style), entry.level, entry.flag != 0);
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * Materializes every dish and adds it to `kitchen` through newOrder().
+ * @return The number of dishes the kitchen accepted. Rejected dishes are deallocated.
+ */
+int CatalogSnapshot::loadInto(Kitchen& kitchen) const {
+    KITCHEN_TIME_SCOPE("snapshot.loadInto.ns");
+    KITCHEN_TRACE_SCOPE("snapshot.loadInto");
+    // Every page is about to be read, so the kernel is asked to read the whole file ahead now instead of faulting
+    // it in page by page; the dishes near the start are materialized while the rest is still arriving.
+    if (mapping_ != nullptr) {
+        ::madvise(mapping_, mapping_size_, MADV_WILLNEED);
+    }
+    int accepted = 0;
+    for (size_t i = 0; i < size(); i++) {
+        Dish* dish = materialize(i);
+        if (dish == nullptr) {
+            continue;
+        }
+        if (kitchen.newOrder(dish)) {
+            accepted++;
+        } else {
+            delete dish;
+        }
+    }
+    return accepted;
+}
+
+/**
+ * Checks the header and that every section lies within the image.
+ * @return True if the image can be read.
+ * @post header_ points to the checked copy of the header and records_ into the image on success.
+ */
+bool CatalogSnapshot::validate() {
+    if (data_ == nullptr || size_ < sizeof(Header) || reinterpret_cast<uintptr_t>(data_) % alignof(Header) != 0) {
+        return false;
+    }
+    // The header is checked and kept as a copy, so every later bounds check uses the values checked here even
+    // if the image is rewritten underneath the reader.
+    std::memcpy(&header_copy_, data_, sizeof(Header));
+    const Header* header = &header_copy_;
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION
+        || header->byte_order != BYTE_ORDER_MARK || header->image_size > size_
+        || header->records_offset % alignof(Record) != 0 || header->refs_offset % alignof(uint32_t) != 0
+        || header->string_index_offset % alignof(uint32_t) != 0
+        || !sectionFits(header->records_offset, header->record_count, sizeof(Record), header->image_size)
+        || !sectionFits(header->refs_offset, header->ref_count, sizeof(uint32_t), header->image_size)
+        || !sectionFits(header->string_index_offset, header->string_count, 2 * sizeof(uint32_t), header->image_size)
+        || !sectionFits(header->string_bytes_offset, header->string_bytes_size, 1, header->image_size)) {
+        return false;
+    }
+    header_ = header;
+    records_ = reinterpret_cast<const Record*>(data_ + header->records_offset);
+    return true;
+}
+
+/**
+ * @pre index < header_->ref_count
+ * @return Entry `index` of the refs section.
+ */
+uint32_t CatalogSnapshot::ref(const uint64_t& index) const {
+    uint32_t value;
+    std::memcpy(&value, data_ + header_->refs_offset + index * sizeof(uint32_t), sizeof(value));
+    return value;
+}
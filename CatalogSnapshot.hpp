@@ -0,0 +1,196 @@
+/**
+ * @file CatalogSnapshot.hpp
+ * @brief This file contains the declaration of the CatalogSnapshot class, a versioned binary image of a
+ * catalog of dishes that can be memory-mapped and read without parsing.
+ *
+ * Layout (native byte order, all offsets relative to the start of the image):
+ *
+ *     Header       fixed 96 bytes: magic, version, byte-order mark, section offsets and counts
+ *     Records      record_count fixed-size Record structs, one per dish
+ *     Refs         uint32 array; a dish's ingredients are string ids, its side dishes are (string id,
+ *                  category) pairs
+ *     String index string_count {offset, length} pairs into the string bytes
+ *     String bytes the text of every distinct name, ingredient, protein and side dish, stored once
+ *
+ * Records refer to strings and lists by index, never by pointer, so the image is position-independent and
+ * can be read straight from an mmap'd file or a shared-memory segment. Opening only validates the header and
+ * section bounds; individual references are bounds-checked when they are read, so opening costs the same for
+ * ten dishes or ten million and pages are faulted in only as records are touched. The header is copied when it
+ * is validated and every bounds check uses that copy, so even an image rewritten while it is being read (as a
+ * SharedKitchen reader's can be) yields wrong values at worst, never a read outside it.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef CATALOG_SNAPSHOT_HPP
+#define CATALOG_SNAPSHOT_HPP
+
+#include "Dish.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Kitchen;
+
+class CatalogSnapshot {
+    public:
+        static const uint32_t VERSION = 1;
+
+        /**
+         * @enum DishType
+         * @brief The subclass a record materializes as.
+         */
+        enum DishType : uint8_t { APPETIZER, MAINCOURSE, DESSERT };
+
+        /**
+         * @struct Header
+         * @brief The first bytes of every image.
+         */
+        struct Header {
+            char magic[8];                  ///< "KCATSNAP"
+            uint32_t version;
+            uint32_t byte_order;            ///< 0x01020304 as written by the producing machine.
+            uint64_t sequence;              ///< Caller-defined, e.g. the journal position the image reflects.
+            uint64_t record_count;
+            uint64_t records_offset;
+            uint64_t ref_count;
+            uint64_t refs_offset;
+            uint64_t string_count;
+            uint64_t string_index_offset;
+            uint64_t string_bytes_offset;
+            uint64_t string_bytes_size;
+            uint64_t image_size;
+        };
+
+        /**
+         * @struct Record
+         * @brief One dish. Fields that do not apply to the record's type are zero.
+         */
+        struct Record {
+            uint8_t type;                   ///< A DishType.
+            uint8_t cuisine;                ///< A Dish::CuisineType.
+            uint8_t style;                  ///< ServingStyle, CookingMethod or FlavorProfile, by type.
+            uint8_t flag;                   ///< Vegetarian, gluten-free or contains-nuts, by type.
+            int32_t prep_time;
+            double price;
+            uint32_t name;                  ///< String id.
+            uint32_t ingredients_first;     ///< Index into refs.
+            uint32_t ingredients_count;
+            int32_t level;                  ///< Spiciness (appetizer) or sweetness (dessert).
+            uint32_t protein;               ///< String id (main course).
+            uint32_t sides_first;           ///< Index into refs; each side dish uses two refs.
+            uint32_t sides_count;
+            uint32_t reserved;
+        };
+
+        /**
+         * Serializes dishes into a snapshot image.
+         * @param dishes The dishes to store, in order.
+         * @param sequence Stored in the header and returned by getSequence().
+         * @return The image bytes.
+         */
+        static std::vector<char> serialize(const std::vector<Dish*>& dishes, const uint64_t& sequence = 0);
+
+        /**
+         * Writes a snapshot of every dish in `kitchen` to `path`. The image is written to a temporary file and
+         * renamed into place, so readers never see a partial snapshot.
+         * @return True if the snapshot was written.
+         */
+        static bool save(const Kitchen& kitchen, const std::string& path, const uint64_t& sequence = 0);
+
+        CatalogSnapshot();
+
+        /**
+         * Destructor.
+         * @post Unmaps the file, if one is open.
+         */
+        ~CatalogSnapshot();
+
+        CatalogSnapshot(const CatalogSnapshot&) = delete;
+        CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+
+        /**
+         * Memory-maps a snapshot file read-only.
+         * @param path The snapshot file.
+         * @return True if the file was mapped and its header is valid; false leaves the snapshot closed.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * Reads a snapshot image that lives elsewhere in memory, without copying it.
+         * @param data The start of the image; must stay valid until close() or destruction.
+         * @param size The number of readable bytes at `data`.
+         * @return True if the header is valid; false leaves the snapshot closed.
+         */
+        bool attach(const void* data, const size_t& size);
+
+        /**
+         * Releases the mapping or attached image.
+         */
+        void close();
+
+        bool isOpen() const;
+
+        /**
+         * @return The number of dishes in the snapshot.
+         */
+        size_t size() const;
+
+        /**
+         * @return The sequence number given to serialize() or save().
+         */
+        uint64_t getSequence() const;
+
+        /**
+         * @pre i < size()
+         * @return The fixed-size record of dish i, read directly from the image.
+         */
+        const Record& record(const size_t& i) const;
+
+        /**
+         * @return The text of string `id`, or an empty view if the id is out of range.
+         */
+        std::string_view string(const uint32_t& id) const;
+
+        /**
+         * @pre i < size()
+         * @return The name of dish i.
+         */
+        std::string_view name(const size_t& i) const;
+
+        /**
+         * @pre i < size()
+         * @return The ingredients of dish i, as views into the image.
+         */
+        std::vector<std::string_view> ingredients(const size_t& i) const;
+
+        /**
+         * Builds dish i as a heap-allocated Appetizer, MainCourse or Dessert.
+         * @pre i < size()
+         * @return The new dish, owned by the caller, or nullptr if the record is corrupt.
+         */
+        Dish* materialize(const size_t& i) const;
+
+        /**
+         * Materializes every dish and adds it to `kitchen` through newOrder().
+         * @return The number of dishes the kitchen accepted. Rejected dishes are deallocated.
+         */
+        int loadInto(Kitchen& kitchen) const;
+
+    private:
+        bool validate();
+        uint32_t ref(const uint64_t& index) const;
+
+        const char* data_;
+        size_t size_;
+        void* mapping_;
+        size_t mapping_size_;
+        const Header* header_;              // Points to header_copy_ while open.
+        Header header_copy_;
+        const Record* records_;
+};
+
+#endif // CATALOG_SNAPSHOT_HPP
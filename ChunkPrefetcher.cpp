@@ -0,0 +1,140 @@
+/**
+ * @file ChunkPrefetcher.cpp
+ * @brief This file contains the implementation of the ChunkPrefetcher class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "ChunkPrefetcher.hpp"
+#include "Metrics.hpp"
+#include <cerrno>
+#include <unistd.h>
+
+/**
+ * Starts reading `fd` from its current offset.
+ * @param fd An open file the prefetcher reads but does not close; it must stay open until the prefetcher is
+ * destroyed and must not be read by anyone else meanwhile.
+ * @param chunk_size The bytes in each of the two buffers.
+ */
+ChunkPrefetcher::ChunkPrefetcher(const int& fd, const size_t& chunk_size)
+    : fd_(fd), held_(-1), next_(0), stopping_(false), failed_(false), stalls_(0) {
+    for (Slot& slot : slots_) {
+        slot.data.resize(chunk_size > 0 ? chunk_size : 1);
+        slot.size = 0;
+        slot.full = false;
+    }
+    thread_ = std::thread(&ChunkPrefetcher::readLoop, this);
+}
+
+/**
+ * Destructor.
+ * @post Stops the reader thread, whether or not the file was read to the end.
+ */
+ChunkPrefetcher::~ChunkPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+/**
+ * Hands the previous chunk back to the reader thread and waits for the next one.
+ * @param data Set to the chunk's bytes, valid until the next call.
+ * @param size Set to the number of bytes, which is the chunk size except at the end of the file.
+ * @return False at the end of the file or on a read error.
+ */
+bool ChunkPrefetcher::next(const char*& data, size_t& size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (held_ >= 0) {
+        slots_[held_].full = false;
+        held_ = -1;
+        changed_.notify_all();
+    }
+    Slot& slot = slots_[next_];
+    if (!slot.full) {
+        stalls_++;
+        KITCHEN_COUNTER_ADD("prefetcher.stalls", 1);
+        changed_.wait(lock, [&]() { return slot.full; });
+    }
+    // An empty chunk marks the end and stays full, so later calls return false too.
+    if (slot.size == 0) {
+        return false;
+    }
+    held_ = next_;
+    next_ ^= 1;
+    data = slot.data.data();
+    size = slot.size;
+    return true;
+}
+
+/**
+ * @return True if reading stopped because of an error rather than the end of the file.
+ */
+bool ChunkPrefetcher::failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+/**
+ * @return The number of times next() had to wait for the reader thread, i.e. the chunks that were not read by
+ * the time the consumer wanted them.
+ */
+uint64_t ChunkPrefetcher::getStalls() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stalls_;
+}
+
+/**
+ * The reader thread: fills the two slots in turn, each as soon as the consumer hands it back, and ends with an
+ * empty chunk.
+ */
+void ChunkPrefetcher::readLoop() {
+    int current = 0;
+    bool ok = true;
+    while (true) {
+        Slot& slot = slots_[current];
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [&]() { return !slot.full || stopping_; });
+            if (stopping_) {
+                return;
+            }
+        }
+        // The slot is neither full nor held, so the consumer does not touch it while it is read into.
+        slot.size = 0;
+        if (ok) {
+            ok = readChunk(slot);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slot.full = true;
+            failed_ = !ok;
+        }
+        changed_.notify_all();
+        if (slot.size == 0) {
+            return;
+        }
+        current ^= 1;
+    }
+}
+
+/**
+ * Reads until `slot` is full or the file ends.
+ * @return False on a read error; the bytes read before it are kept.
+ */
+bool ChunkPrefetcher::readChunk(Slot& slot) {
+    while (slot.size < slot.data.size()) {
+        ssize_t got = ::read(fd_, slot.data.data() + slot.size, slot.data.size() - slot.size);
+        if (got > 0) {
+            slot.size += got;
+        } else if (got == 0) {
+            return true;
+        } else if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
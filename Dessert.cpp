@@ -20,7 +20,9 @@
  * Initializes all private members with default values.
  */
 Dessert::Dessert()
-    : Dish(), flavor_profile_(SWEET), sweetness_level_(0), contains_nuts_(false) {}
+    : Dish(), flavor_profile_(SWEET), sweetness_level_(0), contains_nuts_(false) {
+    updateCompatibility();
+}
 
 /**
  * Parameterized constructor.
@@ -34,7 +36,9 @@ Dessert::Dessert()
  * @param contains_nuts Flag indicating if the dessert contains nuts.
  */
 Dessert::Dessert(const std::string& name, const std::vector<std::string>& ingredients, const int &prep_time, const double &price, const CuisineType &cuisine_type, const FlavorProfile &flavor_profile, const int &sweetness_level, const bool &contains_nuts)
-    : Dish(name, ingredients, prep_time, price, cuisine_type), flavor_profile_(flavor_profile), sweetness_level_(sweetness_level), contains_nuts_(contains_nuts) {}
+    : Dish(name, ingredients, prep_time, price, cuisine_type), flavor_profile_(flavor_profile), sweetness_level_(sweetness_level), contains_nuts_(contains_nuts) {
+    updateCompatibility();
+}
 
 /**
  * Sets the flavor profile of the dessert.
@@ -43,6 +47,7 @@ Dessert::Dessert(const std::string& name, const std::vector<std::string>& ingred
  */
 void Dessert::setFlavorProfile(const FlavorProfile &flavor_profile) {
     flavor_profile_ = flavor_profile;
+    touch();
 }
 
 /**
@@ -59,6 +64,7 @@ Dessert::FlavorProfile Dessert::getFlavorProfile() const {
  */
 void Dessert::setSweetnessLevel(const int &sweetness_level) {
     sweetness_level_ = sweetness_level;
+    touch();
 }
 
 /**
@@ -75,6 +81,7 @@ int Dessert::getSweetnessLevel() const {
  */
 void Dessert::setContainsNuts(const bool &contains_nuts) {
     contains_nuts_ = contains_nuts;
+    touch();
 }
 
 /**
@@ -152,36 +159,70 @@ Dairy and egg ingredients are: "Milk", "Eggs", "Cheese",
 "Butter", "Cream", "Yogurt".
  */
 void Dessert::dietaryAccommodations(const DietaryRequest& request) {
-    std::vector<std::string> ingredients = getIngredients();
+    // The rules are in dietaryDelta(), so that DietaryViews can present the adjusted dessert without changing it.
+    Dessert::applyDietaryDelta(Dessert::dietaryDelta(request));
+}
+
+/**
+ * @return What dietaryAccommodations(request) would change, leaving the dessert unchanged.
+ */
+Dish::DietaryDelta Dessert::dietaryDelta(const DietaryRequest& request) const {
+    DietaryDelta delta;
+    const IngredientList& ingredients = getIngredientList();
 
     // Handle nut-free request
     if (request.nut_free) {
-        contains_nuts_ = false;
+        delta.marks |= DietaryDelta::MARK_NUT_FREE;
         // Remove any nuts from the ingredients
         static const std::vector<std::string> nuts = {"Almonds", "Walnuts", "Pecans", "Hazelnuts", "Peanuts", "Cashews", "Pistachios"};
-        for (const auto& nut : nuts) {
-            auto nut_end_iter = std::remove(ingredients.begin(), ingredients.end(), nut);
-            if (nut_end_iter != ingredients.end()) {
-                ingredients.erase(nut_end_iter, ingredients.end());  // Remove the nuts
-            }
-        }
+        dropIngredients(ingredients, nuts, delta);
     }
 
     // Handle low sugar request
-    if (request.low_sugar) {
-        sweetness_level_ = std::max(0, sweetness_level_ - 3);  // Reduce sweetness level by 3, minimum 0
+    if (request.low_sugar && std::max(0, sweetness_level_ - 3) != sweetness_level_) {
+        delta.level = std::max(0, sweetness_level_ - 3);  // Reduce sweetness level by 3, minimum 0
     }
 
     // Handle vegan request
     if (request.vegan) {
         static const std::vector<std::string> dairy_egg = {"Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"};
-        for (const auto& item : dairy_egg) {
-            auto vegan_end_iter = std::remove(ingredients.begin(), ingredients.end(), item);
-            if (vegan_end_iter != ingredients.end()) {
-                ingredients.erase(vegan_end_iter, ingredients.end());  // Remove dairy and egg ingredients
-            }
-        }
+        dropIngredients(ingredients, dairy_egg, delta);
+    }
+    return delta;
+}
+
+/**
+ * Applies a delta from dietaryDelta(), as dietaryAccommodations() would.
+ */
+void Dessert::applyDietaryDelta(const DietaryDelta& delta) {
+    if (delta.marks & DietaryDelta::MARK_NUT_FREE) {
+        contains_nuts_ = false;
+    }
+    if (delta.level >= 0) {
+        sweetness_level_ = delta.level;
     }
     // Set the updated ingredients
-    setIngredients(ingredients);
-}
\ No newline at end of file
+    setIngredients(delta.applyTo(getIngredientList()));
+}
+
+/**
+ * @return A newly allocated copy of this dessert. The caller owns it.
+ */
+Dessert* Dessert::clone() const {
+    return new Dessert(*this);
+}
+
+/**
+ * @return The Dish mask, narrowed by the nuts flag (clears NUT_FREE) and sweetness (LOW_SUGAR only at
+ * level 0, where the accommodation changes nothing).
+ */
+uint8_t Dessert::computeCompatibility() const {
+    uint8_t mask = Dish::computeCompatibility();
+    if (contains_nuts_) {
+        mask &= ~NUT_FREE;
+    }
+    if (sweetness_level_ > 0) {
+        mask &= ~LOW_SUGAR;
+    }
+    return mask;
+}
@@ -125,6 +125,28 @@ public:
     */
     void dietaryAccommodations(const DietaryRequest& request) override;
 
+    /**
+     * @return What dietaryAccommodations(request) would change, leaving the dessert unchanged.
+     */
+    DietaryDelta dietaryDelta(const DietaryRequest& request) const override;
+
+    /**
+     * Applies a delta from dietaryDelta(), as dietaryAccommodations() would.
+     */
+    void applyDietaryDelta(const DietaryDelta& delta) override;
+
+    /**
+     * @return A newly allocated copy of this dessert. The caller owns it.
+     */
+    Dessert* clone() const override;
+
+protected:
+    /**
+     * @return The Dish mask, narrowed by the nuts flag (clears NUT_FREE) and sweetness (LOW_SUGAR only at
+     * level 0, where the accommodation changes nothing).
+     */
+    uint8_t computeCompatibility() const override;
+
 private:
     FlavorProfile flavor_profile_; ///< The flavor profile of the dessert.
     int sweetness_level_; ///< The sweetness level of the dessert.
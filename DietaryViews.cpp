@@ -0,0 +1,174 @@
+/**
+ * @file DietaryViews.cpp
+ * @brief This file contains the implementation of the DietaryViews class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "DietaryViews.hpp"
+#include "Metrics.hpp"
+
+/**
+ * @return The overlay stored under `key`, or nullptr.
+ */
+std::shared_ptr<DietaryViews::Overlay> DietaryViews::Entry::find(const uint8_t& key) const {
+    for (const auto& overlay : overlays) {
+        if (overlay.first == key) {
+            return overlay.second;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * An empty view, never valid.
+ */
+DietaryViews::View::View() : dish_(nullptr) {}
+
+DietaryViews::View::View(const Dish* dish, const std::shared_ptr<const Overlay>& overlay)
+    : dish_(dish), overlay_(overlay) {}
+
+/**
+ * @return True while the dish is unchanged since the view was made and has not been forgotten.
+ */
+bool DietaryViews::View::isValid() const {
+    // The flag is checked first: once it is set the dish may have been deleted, so its version must not be read.
+    return overlay_ != nullptr && !overlay_->forgotten.load(std::memory_order_acquire)
+        && dish_->getVersion() == overlay_->version;
+}
+
+const Dish& DietaryViews::View::getDish() const {
+    return *dish_;
+}
+
+const Dish::DietaryDelta& DietaryViews::View::getDelta() const {
+    return overlay_->delta;
+}
+
+/**
+ * @return The adjusted dish's ingredients.
+ */
+std::vector<std::string> DietaryViews::View::getIngredients() const {
+    return overlay_->delta.applyTo(dish_->getIngredientList()).toVector();
+}
+
+/**
+ * @return A new copy of the adjusted dish, owned by the caller.
+ */
+std::unique_ptr<Dish> DietaryViews::View::materialize() const {
+    std::unique_ptr<Dish> adjusted(dish_->clone());
+    adjusted->applyDietaryDelta(overlay_->delta);
+    return adjusted;
+}
+
+/**
+ * Destructor.
+ * @post Every view handed out is invalid.
+ */
+DietaryViews::~DietaryViews() {
+    clear();
+}
+
+/**
+ * @return `dish` as adjusted by `request`, built on first use and shared afterwards. Safe to call from several
+ * threads.
+ */
+DietaryViews::View DietaryViews::view(const Dish* dish, const Dish::DietaryRequest& request) {
+    uint8_t key = keyOf(request);
+    uint64_t version = dish->getVersion();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = entries_.find(dish);
+        if (found != entries_.end() && found->second.version == version) {
+            if (std::shared_ptr<Overlay> overlay = found->second.find(key)) {
+                KITCHEN_COUNTER_ADD("dietaryViews.hit", 1);
+                return View(dish, overlay);
+            }
+        }
+    }
+
+    // Built outside the lock so that other tables are not held up; if two threads race, the first to store
+    // its overlay wins and the other's is dropped.
+    KITCHEN_COUNTER_ADD("dietaryViews.build", 1);
+    std::shared_ptr<Overlay> built = std::make_shared<Overlay>();
+    built->delta = dish->dietaryDelta(request);
+    built->version = version;
+    built->forgotten = false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto inserted = entries_.emplace(dish, Entry{version, {}});
+    Entry& entry = inserted.first->second;
+    if (version < entry.version) {
+        // Another thread has already cached views of a newer version of the dish; this one is stale, so it
+        // is returned, already invalid, but not kept.
+        return View(dish, built);
+    }
+    if (version > entry.version) {
+        entry.version = version;
+        entry.overlays.clear();
+    }
+    if (std::shared_ptr<Overlay> overlay = entry.find(key)) {
+        return View(dish, overlay);
+    }
+    entry.overlays.emplace_back(key, built);
+    return View(dish, built);
+}
+
+/**
+ * Drops every view of `dish` and marks them invalid, e.g. because it is about to be deleted.
+ */
+void DietaryViews::forget(const Dish* dish) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = entries_.find(dish);
+    if (found != entries_.end()) {
+        invalidate(found->second);
+        entries_.erase(found);
+    }
+}
+
+/**
+ * Forgets every dish.
+ */
+void DietaryViews::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+        invalidate(entry.second);
+    }
+    entries_.clear();
+}
+
+/**
+ * @return The number of deltas held.
+ */
+size_t DietaryViews::overlayCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& entry : entries_) {
+        count += entry.second.overlays.size();
+    }
+    return count;
+}
+
+/**
+ * Marks every overlay of `entry` forgotten.
+ */
+void DietaryViews::invalidate(const Entry& entry) {
+    for (const auto& overlay : entry.overlays) {
+        overlay.second->forgotten.store(true, std::memory_order_release);
+    }
+}
+
+/**
+ * @return `request` as a 6-bit key, in the field order of Dish::DietaryRequest, first field lowest.
+ */
+uint8_t DietaryViews::keyOf(const Dish::DietaryRequest& request) {
+    return Dish::maskOf(request);
+}
+
+/**
+ * @return The request encoded by `key`.
+ */
+Dish::DietaryRequest DietaryViews::requestOf(const uint8_t& key) {
+    return {(key & 1) != 0, (key & 2) != 0, (key & 4) != 0, (key & 8) != 0, (key & 16) != 0, (key & 32) != 0};
+}
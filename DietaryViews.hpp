@@ -0,0 +1,161 @@
+/**
+ * @file DietaryViews.hpp
+ * @brief This file contains the declaration of the DietaryViews class, a shared cache of dishes as they would
+ * be served under each Dish::DietaryRequest, leaving the dishes themselves untouched.
+ *
+ * A DietaryRequest is six flags, so it packs into a 6-bit key, and a view is identified by a dish and a key.
+ * A view is an overlay, not a copy: it holds the dish's Dish::DietaryDelta for the request (the replaced and
+ * dropped ingredients, dropped side dishes, lowered level and set flags) and reads everything else from the
+ * dish itself. The first request for a view computes the delta through Dish::dietaryDelta(), and every later
+ * request for the same dish and key, from any table or thread, shares it.
+ *
+ * Since a view refers to its dish, it is only valid while the dish is unchanged and still held. Views remember
+ * the dish's version (Dish::getVersion()) they were made from: once the dish is modified they report
+ * themselves invalid, and the next request rebuilds them. A build that read an older version than the views
+ * already cached, because the dish changed while it ran, is returned but never replaces them. forget() marks
+ * every view of the dish invalid before the dish is deleted, so a view held past that is never read through a
+ * dangling pointer.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef DIETARY_VIEWS_HPP
+#define DIETARY_VIEWS_HPP
+
+#include "Dish.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DietaryViews {
+    private:
+        struct Overlay;
+
+    public:
+        /**
+         * A dish as adjusted by a request, shared by everyone who asked for it. Cheap to copy.
+         */
+        class View {
+            public:
+                /**
+                 * An empty view, never valid.
+                 */
+                View();
+
+                /**
+                 * @return True while the dish is unchanged since the view was made and has not been forgotten.
+                 */
+                bool isValid() const;
+
+                /**
+                 * @return The dish the view adjusts.
+                 * @pre isValid().
+                 */
+                const Dish& getDish() const;
+
+                /**
+                 * @return What the view changes about the dish.
+                 * @pre The view is not empty.
+                 */
+                const Dish::DietaryDelta& getDelta() const;
+
+                /**
+                 * @return The adjusted dish's ingredients.
+                 * @pre isValid().
+                 */
+                std::vector<std::string> getIngredients() const;
+
+                /**
+                 * @return A new copy of the adjusted dish, owned by the caller, for whatever the view does not
+                 * present itself.
+                 * @pre isValid().
+                 */
+                std::unique_ptr<Dish> materialize() const;
+
+            private:
+                friend class DietaryViews;
+
+                View(const Dish* dish, const std::shared_ptr<const Overlay>& overlay);
+
+                const Dish* dish_;
+                std::shared_ptr<const Overlay> overlay_;
+        };
+
+        DietaryViews() = default;
+        DietaryViews(const DietaryViews&) = delete;
+        DietaryViews& operator=(const DietaryViews&) = delete;
+
+        /**
+         * Destructor.
+         * @post Every view handed out is invalid.
+         */
+        ~DietaryViews();
+
+        /**
+         * @return `dish` as adjusted by `request`, built on first use and shared afterwards. Safe to call from
+         * several threads.
+         */
+        View view(const Dish* dish, const Dish::DietaryRequest& request);
+
+        /**
+         * Drops every view of `dish` and marks them invalid, e.g. because it is about to be deleted.
+         */
+        void forget(const Dish* dish);
+
+        /**
+         * Forgets every dish.
+         */
+        void clear();
+
+        /**
+         * @return The number of deltas held.
+         */
+        size_t overlayCount() const;
+
+        /**
+         * @return `request` as a 6-bit key, in the field order of Dish::DietaryRequest, first field lowest.
+         */
+        static uint8_t keyOf(const Dish::DietaryRequest& request);
+
+        /**
+         * @return The request encoded by `key`.
+         */
+        static Dish::DietaryRequest requestOf(const uint8_t& key);
+
+    private:
+        /**
+         * @struct Overlay
+         * @brief One dish's delta for one request, and whether the dish it was made from is still there.
+         */
+        struct Overlay {
+            Dish::DietaryDelta delta;
+            uint64_t version;                      ///< The Dish::getVersion() the delta was computed at.
+            mutable std::atomic<bool> forgotten;   ///< Set by forget(), after which the dish may be gone.
+        };
+
+        struct Entry {
+            uint64_t version;
+            std::vector<std::pair<uint8_t, std::shared_ptr<Overlay>>> overlays;
+
+            /**
+             * @return The overlay stored under `key`, or nullptr.
+             */
+            std::shared_ptr<Overlay> find(const uint8_t& key) const;
+        };
+
+        /**
+         * Marks every overlay of `entry` forgotten.
+         */
+        static void invalidate(const Entry& entry);
+
+        mutable std::mutex mutex_;
+        std::unordered_map<const Dish*, Entry> entries_;
+};
+
+#endif // DIETARY_VIEWS_HPP
@@ -10,16 +10,20 @@
  */
 
 #include "Dish.hpp"
+#include "NameValidator.hpp"
+#include <algorithm>
 
 // Default Constructor
 Dish::Dish() 
-    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+    : name_("UNKNOWN"), ingredients_(), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER), version_(0), compatibility_(0) {
+    updateCompatibility();
 }
 
 // Parameterized Constructor
 Dish::Dish(const std::string& name, const std::vector<std::string>& ingredients, int prep_time, double price, CuisineType cuisine_type)
-    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
+    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type), version_(0), compatibility_(0) {
     setName(name);  // Use setName to validate the name
+    updateCompatibility();
 }
 
 // Accessor Functions
@@ -28,6 +32,13 @@ std::string Dish::getName() const {
 }
 
 std::vector<std::string> Dish::getIngredients() const {
+    return ingredients_.toVector();
+}
+
+/**
+ * @return The ingredients, read in place without the copy getIngredients() makes.
+ */
+const Dish::IngredientList& Dish::getIngredientList() const {
     return ingredients_;
 }
 
@@ -51,6 +62,20 @@ std::string Dish::getCuisineType() const {
     }
 }
 
+uint64_t Dish::getVersion() const {
+    return version_;
+}
+
+uint8_t Dish::getCompatibility() const {
+    return compatibility_;
+}
+
+uint8_t Dish::maskOf(const DietaryRequest& request) {
+    return static_cast<uint8_t>((request.vegetarian ? VEGETARIAN : 0) | (request.vegan ? VEGAN : 0)
+                                | (request.gluten_free ? GLUTEN_FREE : 0) | (request.nut_free ? NUT_FREE : 0)
+                                | (request.low_sodium ? LOW_SODIUM : 0) | (request.low_sugar ? LOW_SUGAR : 0));
+}
+
 // Mutator Functions
 void Dish::setName(const std::string& name) {
     if (isValidName(name)) {
@@ -58,32 +83,133 @@ void Dish::setName(const std::string& name) {
     } else {
         name_ = "UNKNOWN";
     }
+    touch();
 }
 
-void Dish::setIngredients(const std::vector<std::string>& ingredients) {
+void Dish::setIngredients(const IngredientList& ingredients) {
     ingredients_ = ingredients;
+    touch();
 }
 
 void Dish::setPrepTime(const int& prep_time) {
     prep_time_ = prep_time;
+    touch();
 }
 
 void Dish::setPrice(const double& price) {
     price_ = price;
+    touch();
 }
 
 void Dish::setCuisineType(const CuisineType& cuisine_type) {
     cuisine_type_ = cuisine_type;
+    touch();
 }
 
-// Helper function to check if the name is valid
-bool Dish::isValidName(const std::string& name) const {
-    for (char c : name) {
-        if (!std::isalpha(c) && !std::isspace(c)) {  // Check if each character is a letter or space
-            return false;  // Name contains non-alphabetic characters other than spaces
+void Dish::touch() {
+    version_++;
+    updateCompatibility();
+}
+
+// Called from a constructor this runs the Dish version of computeCompatibility(), so derived constructors
+// call it again once their own members are set.
+void Dish::updateCompatibility() {
+    compatibility_ = computeCompatibility();
+}
+
+uint8_t Dish::computeCompatibility() const {
+    static const std::vector<std::string> dairy_eggs = {"Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"};
+    static const std::vector<std::string> gluten = {"Wheat", "Flour", "Bread", "Pasta", "Barley", "Rye", "Oats", "Crust"};
+    static const std::vector<std::string> nuts = {"Almonds", "Walnuts", "Pecans", "Hazelnuts", "Peanuts", "Cashews", "Pistachios"};
+    uint8_t mask = VEGETARIAN | VEGAN | GLUTEN_FREE | NUT_FREE | LOW_SODIUM | LOW_SUGAR;
+    for (const std::string& ingredient : ingredients_) {
+        if (isMeatOrFish(ingredient)) {
+            mask &= ~(VEGETARIAN | VEGAN);
+        }
+        if (std::find(dairy_eggs.begin(), dairy_eggs.end(), ingredient) != dairy_eggs.end()) {
+            mask &= ~VEGAN;
+        }
+        if (std::find(gluten.begin(), gluten.end(), ingredient) != gluten.end()) {
+            mask &= ~GLUTEN_FREE;
+        }
+        if (std::find(nuts.begin(), nuts.end(), ingredient) != nuts.end()) {
+            mask &= ~NUT_FREE;
         }
     }
-    return true;  // Name is valid
+    return mask;
+}
+
+bool Dish::isMeatOrFish(const std::string& ingredient) {
+    static const std::vector<std::string> meat_fish = {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"};
+    return std::find(meat_fish.begin(), meat_fish.end(), ingredient) != meat_fish.end();
+}
+
+void Dish::replaceMeatAndFish(const IngredientList& ingredients, DietaryDelta& delta) {
+    int replacement_count = 0;
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        if (!delta.isEdited(i) && isMeatOrFish(ingredients[i])) {
+            delta.edit(i, replacement_count == 0 ? "Beans" : replacement_count == 1 ? "Mushrooms" : nullptr);
+            replacement_count++;
+        }
+    }
+    dropEmptyIngredients(ingredients, delta);
+}
+
+void Dish::dropIngredients(const IngredientList& ingredients, const std::vector<std::string>& dropped,
+                           DietaryDelta& delta) {
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        if (!delta.isEdited(i) && std::find(dropped.begin(), dropped.end(), ingredients[i]) != dropped.end()) {
+            delta.edit(i, nullptr);
+        }
+    }
+}
+
+void Dish::dropEmptyIngredients(const IngredientList& ingredients, DietaryDelta& delta) {
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        if (!delta.isEdited(i) && ingredients[i].empty()) {
+            delta.edit(i, nullptr);
+        }
+    }
+}
+
+bool Dish::DietaryDelta::isEdited(const size_t& position) const {
+    auto found = std::lower_bound(edits.begin(), edits.end(), position,
+                                  [](const Edit& edit, const size_t& p) { return edit.position < p; });
+    return found != edits.end() && found->position == position;
+}
+
+// Edits are few, so keeping them sorted by insertion costs less than sorting them once at the end would save.
+void Dish::DietaryDelta::edit(const size_t& position, const char* replacement) {
+    auto found = std::lower_bound(edits.begin(), edits.end(), position,
+                                  [](const Edit& edit, const size_t& p) { return edit.position < p; });
+    if (found != edits.end() && found->position == position) {
+        found->replacement = replacement;
+    } else {
+        edits.insert(found, Edit{static_cast<uint32_t>(position), replacement});
+    }
+}
+
+Dish::IngredientList Dish::DietaryDelta::applyTo(const IngredientList& ingredients) const {
+    IngredientList adjusted;
+    adjusted.reserve(ingredients.size());
+    auto next = edits.begin();
+    for (size_t i = 0; i < ingredients.size(); i++) {
+        if (next != edits.end() && next->position == i) {
+            if (next->replacement != nullptr) {
+                adjusted.emplace_back(next->replacement);
+            }
+            ++next;
+        } else {
+            adjusted.push_back(ingredients[i]);
+        }
+    }
+    return adjusted;
+}
+
+// Helper function to check if the name is valid
+bool Dish::isValidName(const std::string& name) const {
+    // The same letters and spaces as std::isalpha/std::isspace in the "C" locale, by table and SSE2.
+    return NameValidator::isValid(name);
 }
 
 bool Dish::operator==(const Dish& rhs) const {
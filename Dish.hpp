@@ -13,17 +13,24 @@
 #ifndef DISH_HPP
 #define DISH_HPP
 
+#include "SmallVector.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <iomanip> // For std::fixed and std::setprecision
-#include <cctype>  // For std::isalpha, std::isspace
 
 class Dish {
 public:
     // CuisineType enum definition
     enum CuisineType { ITALIAN, MEXICAN, CHINESE, INDIAN, AMERICAN, FRENCH, OTHER };
 
+    /**
+    * A dish's ingredients. Most dishes have three to six, which are kept
+    inside the dish; only longer lists are allocated separately.
+    */
+    typedef SmallVector<std::string, 6> IngredientList;
+
     /**
     * Structure to store dietary accommodation details.
     */
@@ -36,6 +43,54 @@ public:
         bool low_sugar;
     };
 
+    /**
+    * Bits of a dietary compatibility mask, one per DietaryRequest field in
+    the same order.
+    */
+    enum DietaryFlag : uint8_t { VEGETARIAN = 1, VEGAN = 2, GLUTEN_FREE = 4, NUT_FREE = 8, LOW_SODIUM = 16, LOW_SUGAR = 32 };
+
+    /**
+    * What dietaryAccommodations() would change about a dish for one
+    request, relative to the dish as it is, so that the adjusted dish can be
+    kept and read without copying the dish (see DietaryViews).
+    */
+    struct DietaryDelta {
+        /**
+        * Derived-class attributes a request sets outright.
+        */
+        enum Mark : uint8_t { MARK_VEGETARIAN = 1, MARK_TOFU = 2, MARK_GLUTEN_FREE = 4, MARK_NUT_FREE = 8 };
+
+        /**
+        * The ingredient at `position` of the dish's list is replaced by
+        `replacement`, or dropped if that is nullptr.
+        */
+        struct Edit {
+            uint32_t position;
+            const char* replacement;
+        };
+
+        std::vector<Edit> edits;              ///< At most one per position, in increasing position.
+        std::vector<uint32_t> dropped_sides;  ///< Positions of dropped side dishes, increasing.
+        int level = -1;                       ///< The new spiciness or sweetness level; -1 if it is unchanged.
+        uint8_t marks = 0;                    ///< Mark bits.
+
+        /**
+        * @return True if an edit already covers `position`.
+        */
+        bool isEdited(const size_t& position) const;
+
+        /**
+        * Records that the ingredient at `position` is replaced by
+        `replacement`, or dropped if that is nullptr.
+        */
+        void edit(const size_t& position, const char* replacement);
+
+        /**
+        * @return `ingredients` with the edits applied.
+        */
+        IngredientList applyTo(const IngredientList& ingredients) const;
+    };
+
     // Constructors
     /**
      * Default constructor.
@@ -59,6 +114,21 @@ public:
      */
     Dish(const std::string& name, const std::vector<std::string>& ingredients = {}, int prep_time = 0, double price = 0.0, CuisineType cuisine_type = CuisineType::OTHER);
 
+    /**
+     * Virtual destructor, so that dishes can be deallocated through a `Dish*`.
+     */
+    virtual ~Dish() = default;
+
+    /**
+     * Declared so that the destructor does not suppress moves: dishes held
+     * by value (see ValueKitchen) move their strings and lists instead of
+     * copying them.
+     */
+    Dish(const Dish&) = default;
+    Dish(Dish&&) = default;
+    Dish& operator=(const Dish&) = default;
+    Dish& operator=(Dish&&) = default;
+
     // Accessors
     /**
      * @return The name of the dish.
@@ -70,6 +140,11 @@ public:
      */
     std::vector<std::string> getIngredients() const;
 
+    /**
+     * @return The ingredients, read in place without the copy getIngredients() makes.
+     */
+    const IngredientList& getIngredientList() const;
+
     /**
      * @return The preparation time in minutes.
      */
@@ -85,6 +160,29 @@ public:
      */
     std::string getCuisineType() const;
 
+    /**
+     * @return A counter that every mutator advances, including
+     * `dietaryAccommodations()`, so that anything derived from the dish can
+     * tell when it is stale.
+     */
+    uint64_t getVersion() const;
+
+    /**
+     * @return The DietaryFlag bits of the requests the dish already meets
+     * without modification. Kept current by every mutator.
+     *
+     * Vegetarian: no meat or fish ingredient. Vegan: vegetarian and no dairy
+     * or egg ingredient. Gluten-free: no gluten ingredient. Nut-free: no nut
+     * ingredient. The ingredient lists are those dietaryAccommodations()
+     * uses, and derived classes add their own conditions.
+     */
+    uint8_t getCompatibility() const;
+
+    /**
+     * @return `request` as a mask of DietaryFlag bits.
+     */
+    static uint8_t maskOf(const DietaryRequest& request);
+
     // Mutators
     /**
      * Sets the name of the dish.
@@ -98,7 +196,7 @@ public:
      * @param ingredients A reference to the new list of ingredients.
      * @post Sets the private member `ingredients_` to the value of the parameter.
      */
-    void setIngredients(const std::vector<std::string>& ingredients);
+    void setIngredients(const IngredientList& ingredients);
 
     /**
      * Sets the preparation time.
@@ -145,6 +243,25 @@ public:
     */
     virtual void dietaryAccommodations(const DietaryRequest& request) = 0;
 
+    /**
+    * @return What dietaryAccommodations(request) would change, leaving the
+    dish unchanged.
+    */
+    virtual DietaryDelta dietaryDelta(const DietaryRequest& request) const = 0;
+
+    /**
+    * Applies a delta this dish's dietaryDelta() returned, as
+    dietaryAccommodations() would, so its ingredient positions must still
+    be those of the dish.
+    */
+    virtual void applyDietaryDelta(const DietaryDelta& delta) = 0;
+
+    /**
+     * @return A newly allocated dish of the same type with the same
+     * attributes. The caller owns it.
+     */
+    virtual Dish* clone() const = 0;
+
     /**
      @param : A const reference to the right-hand side of the `==` operator.
     @return : Returns true if the right-hand side dish is "equal", false
@@ -163,12 +280,59 @@ public:
     */
     bool operator!=(const Dish& rhs) const; // Overloading the != operator
 
+protected:
+    /**
+     * Advances the version and recomputes the compatibility mask. Derived
+     * classes call it from their own mutators.
+     */
+    void touch();
+
+    /**
+     * Recomputes the compatibility mask. Derived constructors call it once
+     * their own members are set.
+     */
+    void updateCompatibility();
+
+    /**
+     * @return The compatibility mask for the dish's current attributes.
+     * Derived classes narrow the result of this version with their own
+     * attributes.
+     */
+    virtual uint8_t computeCompatibility() const;
+
+    /**
+     * @return True if `ingredient` is one dietaryAccommodations() replaces
+     * for vegetarians.
+     */
+    static bool isMeatOrFish(const std::string& ingredient);
+
+    /**
+    * Replaces the first meat or fish ingredient not yet edited with
+    "Beans", the second with "Mushrooms", drops the rest, and drops empty
+    ingredients, as the vegetarian accommodation does.
+    */
+    static void replaceMeatAndFish(const IngredientList& ingredients, DietaryDelta& delta);
+
+    /**
+    * Drops every ingredient not yet edited that is one of `dropped`.
+    */
+    static void dropIngredients(const IngredientList& ingredients, const std::vector<std::string>& dropped,
+                                DietaryDelta& delta);
+
+    /**
+    * Drops every empty ingredient not yet edited; accommodations that
+    blank out ingredients remove empty ones along with them.
+    */
+    static void dropEmptyIngredients(const IngredientList& ingredients, DietaryDelta& delta);
+
 private:
     std::string name_;
-    std::vector<std::string> ingredients_;
+    IngredientList ingredients_;
     int prep_time_;
     double price_;
     CuisineType cuisine_type_;
+    uint64_t version_;
+    uint8_t compatibility_;
 
     // Helper function to check if the name is valid
     /**
@@ -0,0 +1,194 @@
+/**
+ * @file DishCodec.cpp
+ * @brief This file contains the implementation of the DishCodec class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "DishCodec.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+    const char* const CUISINE_NAMES[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"};
+    const int CUISINE_COUNT = sizeof(CUISINE_NAMES) / sizeof(CUISINE_NAMES[0]);
+    // Longest string accepted by getString; anything longer is treated as corruption.
+    const uint64_t MAX_STRING_SIZE = 1 << 20;
+    const uint64_t MAX_LIST_SIZE = 1 << 16;
+}
+
+/**
+ * Appends the encoding of `dish` to `out`.
+ */
+void DishCodec::encode(const Dish& dish, std::string& out) {
+    uint8_t prefix[4] = {0, static_cast<uint8_t>(cuisineOf(dish)), 0, 0};
+    int64_t level = 0;
+    const MainCourse* main_course = dynamic_cast<const MainCourse*>(&dish);
+    if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(&dish)) {
+        prefix[0] = APPETIZER;
+        prefix[2] = static_cast<uint8_t>(appetizer->getServingStyle());
+        prefix[3] = appetizer->isVegetarian();
+        level = appetizer->getSpicinessLevel();
+    } else if (main_course != nullptr) {
+        prefix[0] = MAINCOURSE;
+        prefix[2] = static_cast<uint8_t>(main_course->getCookingMethod());
+        prefix[3] = main_course->isGlutenFree();
+    } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(&dish)) {
+        prefix[0] = DESSERT;
+        prefix[2] = static_cast<uint8_t>(dessert->getFlavorProfile());
+        prefix[3] = dessert->containsNuts();
+        level = dessert->getSweetnessLevel();
+    }
+    out.append(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+    putDouble(out, dish.getPrice());
+    putVarint(out, zigzag(dish.getPrepTime()));
+    putVarint(out, zigzag(level));
+    putString(out, dish.getName());
+    const Dish::IngredientList& ingredients = dish.getIngredientList();
+    putVarint(out, ingredients.size());
+    for (const std::string& ingredient : ingredients) {
+        putString(out, ingredient);
+    }
+    if (main_course != nullptr) {
+        putString(out, main_course->getProteinType());
+        const MainCourse::SideDishList& sides = main_course->getSideDishList();
+        putVarint(out, sides.size());
+        for (const MainCourse::SideDish& side : sides) {
+            putString(out, side.name);
+            out.push_back(static_cast<char>(side.category));
+        }
+    }
+}
+
+/**
+ * Decodes one dish.
+ * @param cursor The start of the encoding; advanced past it on success.
+ * @param end One past the last readable byte.
+ * @return A newly allocated dish owned by the caller, or nullptr if the bytes are truncated or invalid, including a
+ * price that is not finite.
+ */
+Dish* DishCodec::decode(const char*& cursor, const char* end) {
+    const char* p = cursor;
+    if (end - p < 4) {
+        return nullptr;
+    }
+    uint8_t prefix[4];
+    std::memcpy(prefix, p, sizeof(prefix));
+    p += sizeof(prefix);
+
+    double price;
+    uint64_t prep_time, level, ingredient_count;
+    std::string name;
+    // The price arrives as raw bytes, so NaN and infinity are refused here as the CSV parser refuses them.
+    if (prefix[1] >= CUISINE_COUNT || !getDouble(p, end, price) || !std::isfinite(price)
+        || !getVarint(p, end, prep_time) || !getVarint(p, end, level) || !getString(p, end, name)
+        || !getVarint(p, end, ingredient_count) || ingredient_count > MAX_LIST_SIZE) {
+        return nullptr;
+    }
+    std::vector<std::string> ingredients(ingredient_count);
+    for (std::string& ingredient : ingredients) {
+        if (!getString(p, end, ingredient)) {
+            return nullptr;
+        }
+    }
+    Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(prefix[1]);
+    int dish_prep_time = static_cast<int>(unzigzag(prep_time));
+    int dish_level = static_cast<int>(unzigzag(level));
+
+    Dish* dish = nullptr;
+    if (prefix[0] == APPETIZER && prefix[2] <= Appetizer::BUFFET) {
+        dish = new Appetizer(name, ingredients, dish_prep_time, price, cuisine,
+                             static_cast<Appetizer::ServingStyle>(prefix[2]), dish_level, prefix[3] != 0);
+    } else if (prefix[0] == MAINCOURSE && prefix[2] <= MainCourse::RAW) {
+        std::string protein;
+        uint64_t side_count;
+        if (!getString(p, end, protein) || !getVarint(p, end, side_count) || side_count > MAX_LIST_SIZE) {
+            return nullptr;
+        }
+        std::vector<MainCourse::SideDish> sides(side_count);
+        for (MainCourse::SideDish& side : sides) {
+            if (!getString(p, end, side.name) || p == end
+                || static_cast<uint8_t>(*p) > MainCourse::VEGETABLE) {
+                return nullptr;
+            }
+            side.category = static_cast<MainCourse::Category>(static_cast<uint8_t>(*p++));
+        }
+        dish = new MainCourse(name, ingredients, dish_prep_time, price, cuisine,
+                              static_cast<MainCourse::CookingMethod>(prefix[2]), protein, sides, prefix[3] != 0);
+    } else if (prefix[0] == DESSERT && prefix[2] <= Dessert::UMAMI) {
+        dish = new Dessert(name, ingredients, dish_prep_time, price, cuisine,
+                           static_cast<Dessert::FlavorProfile>(prefix[2]), dish_level, prefix[3] != 0);
+    }
+    if (dish != nullptr) {
+        cursor = p;
+    }
+    return dish;
+}
+
+/**
+ * @return The CuisineType named by dish.getCuisineType().
+ */
+Dish::CuisineType DishCodec::cuisineOf(const Dish& dish) {
+    std::string name = dish.getCuisineType();
+    for (int i = 0; i < CUISINE_COUNT; i++) {
+        if (name == CUISINE_NAMES[i]) {
+            return static_cast<Dish::CuisineType>(i);
+        }
+    }
+    return Dish::OTHER;
+}
+
+void DishCodec::putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool DishCodec::getVarint(const char*& cursor, const char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && cursor < end; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(*cursor++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DishCodec::putString(std::string& out, const std::string_view& text) {
+    putVarint(out, text.size());
+    out.append(text.data(), text.size());
+}
+
+bool DishCodec::getString(const char*& cursor, const char* end, std::string& text) {
+    uint64_t size;
+    if (!getVarint(cursor, end, size) || size > MAX_STRING_SIZE || size > static_cast<uint64_t>(end - cursor)) {
+        return false;
+    }
+    text.assign(cursor, size);
+    cursor += size;
+    return true;
+}
+
+void DishCodec::putDouble(std::string& out, const double& value) {
+    char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(bytes));
+    out.append(bytes, sizeof(bytes));
+}
+
+bool DishCodec::getDouble(const char*& cursor, const char* end, double& value) {
+    if (end - cursor < static_cast<ptrdiff_t>(sizeof(double))) {
+        return false;
+    }
+    std::memcpy(&value, cursor, sizeof(double));
+    cursor += sizeof(double);
+    return true;
+}
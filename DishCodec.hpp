@@ -0,0 +1,69 @@
+/**
+ * @file DishCodec.hpp
+ * @brief This file contains the declaration of the DishCodec class, a compact binary encoding of a single
+ * Appetizer, MainCourse or Dessert.
+ *
+ * An encoded dish is a 4-byte prefix (dish type, cuisine, style, flag) followed by the price as 8 raw bytes and
+ * the remaining fields as varints and length-prefixed strings, so a typical dish fits in well under 100 bytes.
+ * Values are written in native byte order; the encoding is meant for files and sockets on one machine, not for
+ * interchange.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef DISH_CODEC_HPP
+#define DISH_CODEC_HPP
+
+#include "Dish.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class DishCodec {
+    public:
+        /**
+         * @enum DishType
+         * @brief The subclass an encoded dish decodes as.
+         */
+        enum DishType : uint8_t { APPETIZER, MAINCOURSE, DESSERT };
+
+        /**
+         * Appends the encoding of `dish` to `out`.
+         */
+        static void encode(const Dish& dish, std::string& out);
+
+        /**
+         * Decodes one dish.
+         * @param cursor The start of the encoding; advanced past it on success.
+         * @param end One past the last readable byte.
+         * @return A newly allocated dish owned by the caller, or nullptr if the bytes are truncated or invalid,
+         * including a price that is not finite.
+         */
+        static Dish* decode(const char*& cursor, const char* end);
+
+        /**
+         * @return The CuisineType named by dish.getCuisineType().
+         */
+        static Dish::CuisineType cuisineOf(const Dish& dish);
+
+        static void putVarint(std::string& out, uint64_t value);
+        static bool getVarint(const char*& cursor, const char* end, uint64_t& value);
+        static void putString(std::string& out, const std::string_view& text);
+        static bool getString(const char*& cursor, const char* end, std::string& text);
+        static void putDouble(std::string& out, const double& value);
+        static bool getDouble(const char*& cursor, const char* end, double& value);
+
+        /**
+         * Maps signed values to unsigned ones so that small magnitudes encode as short varints.
+         */
+        static uint64_t zigzag(const int64_t& value) {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        static int64_t unzigzag(const uint64_t& value) {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+};
+
+#endif // DISH_CODEC_HPP
@@ -0,0 +1,185 @@
+/**
+ * @file IngredientIndex.cpp
+ * @brief This file contains the implementation of the IngredientIndex class: posting-list maintenance and
+ * sorted intersection and union.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "IngredientIndex.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace {
+    const std::vector<Dish*> EMPTY_POSTINGS;
+    // Below this size ratio a linear merge beats binary-searching the longer list for each element.
+    const size_t GALLOP_RATIO = 16;
+
+    /**
+     * @return The sorted intersection of two sorted lists.
+     */
+    std::vector<Dish*> intersect(const std::vector<Dish*>& shorter, const std::vector<Dish*>& longer) {
+        std::vector<Dish*> result;
+        if (shorter.size() * GALLOP_RATIO < longer.size()) {
+            auto from = longer.begin();
+            for (Dish* dish : shorter) {
+                from = std::lower_bound(from, longer.end(), dish, std::less<Dish*>());
+                if (from == longer.end()) {
+                    break;
+                }
+                if (*from == dish) {
+                    result.push_back(dish);
+                }
+            }
+        } else {
+            std::set_intersection(shorter.begin(), shorter.end(), longer.begin(), longer.end(),
+                                  std::back_inserter(result), std::less<Dish*>());
+        }
+        return result;
+    }
+}
+
+/**
+ * Adds `dish` to the posting list of each of its ingredients.
+ * @pre The dish is not already indexed.
+ */
+void IngredientIndex::insert(Dish* dish) {
+    std::vector<const std::string*>& keys = filed_under_[dish];
+    for (const std::string& ingredient : dish->getIngredientList()) {
+        auto slot = postings_.try_emplace(ingredient).first;
+        std::vector<Dish*>& list = slot->second;
+        auto position = std::lower_bound(list.begin(), list.end(), dish, std::less<Dish*>());
+        // An ingredient listed twice is filed once.
+        if (position == list.end() || *position != dish) {
+            list.insert(position, dish);
+            keys.push_back(&slot->first);
+        }
+    }
+}
+
+/**
+ * Removes `dish` from every posting list it is in. Does nothing if it is not indexed.
+ */
+void IngredientIndex::erase(Dish* dish) {
+    auto filed = filed_under_.find(dish);
+    if (filed == filed_under_.end()) {
+        return;
+    }
+    for (const std::string* key : filed->second) {
+        std::vector<Dish*>& list = postings_.find(*key)->second;
+        auto position = std::lower_bound(list.begin(), list.end(), dish, std::less<Dish*>());
+        list.erase(position);
+    }
+    filed_under_.erase(filed);
+}
+
+/**
+ * Re-indexes `dish` after its ingredients changed, e.g. through dietaryAccommodations().
+ */
+void IngredientIndex::update(Dish* dish) {
+    erase(dish);
+    insert(dish);
+}
+
+/**
+ * Re-indexes the first `count` dishes of `dishes` from scratch, discarding every other entry. Cheaper than
+ * calling update() on each dish when most of them changed, since each list is sorted once rather than kept
+ * sorted through every insertion.
+ */
+void IngredientIndex::rebuild(Dish* const* dishes, const size_t& count) {
+    KITCHEN_TIME_SCOPE("ingredients.rebuild.ns");
+    // The lists are emptied rather than the map cleared, so pointers returned by find() stay valid.
+    for (auto& entry : postings_) {
+        entry.second.clear();
+    }
+    filed_under_.clear();
+    for (size_t i = 0; i < count; i++) {
+        std::vector<const std::string*>& keys = filed_under_[dishes[i]];
+        for (const std::string& ingredient : dishes[i]->getIngredientList()) {
+            auto slot = postings_.try_emplace(ingredient).first;
+            std::vector<Dish*>& list = slot->second;
+            // Dishes are appended in order, so a repeat of an ingredient within one dish is always last.
+            if (list.empty() || list.back() != dishes[i]) {
+                list.push_back(dishes[i]);
+                keys.push_back(&slot->first);
+            }
+        }
+    }
+    for (auto& entry : postings_) {
+        std::sort(entry.second.begin(), entry.second.end(), std::less<Dish*>());
+    }
+}
+
+/**
+ * @return The dishes listing `ingredient`, sorted by address, or an empty list.
+ */
+const std::vector<Dish*>& IngredientIndex::postings(const std::string& ingredient) const {
+    const std::vector<Dish*>* list = find(ingredient);
+    return list == nullptr ? EMPTY_POSTINGS : *list;
+}
+
+/**
+ * @return The posting list of `ingredient`, or nullptr if no dish ever listed it. The pointer stays valid for
+ * the life of the index.
+ */
+const std::vector<Dish*>* IngredientIndex::find(const std::string& ingredient) const {
+    auto found = postings_.find(ingredient);
+    return found == postings_.end() ? nullptr : &found->second;
+}
+
+/**
+ * @return True if `dish` lists `ingredient`, by binary search of the posting list.
+ */
+bool IngredientIndex::contains(const std::string& ingredient, const Dish* dish) const {
+    const std::vector<Dish*>& list = postings(ingredient);
+    return std::binary_search(list.begin(), list.end(), const_cast<Dish*>(dish), std::less<Dish*>());
+}
+
+/**
+ * @return The dishes listing every ingredient in `ingredients` (AND), sorted by address.
+ */
+std::vector<Dish*> IngredientIndex::all(const std::vector<std::string>& ingredients) const {
+    KITCHEN_TIME_SCOPE("ingredients.all.ns");
+    if (ingredients.empty()) {
+        return {};
+    }
+    std::vector<const std::vector<Dish*>*> lists;
+    for (const std::string& ingredient : ingredients) {
+        lists.push_back(&postings(ingredient));
+    }
+    // Smallest first keeps every intermediate result no larger than the shortest list.
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<Dish*>* a, const std::vector<Dish*>* b) { return a->size() < b->size(); });
+    std::vector<Dish*> result = *lists[0];
+    for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+        result = intersect(result, *lists[i]);
+    }
+    return result;
+}
+
+/**
+ * @return The dishes listing at least one ingredient in `ingredients` (OR), sorted by address.
+ */
+std::vector<Dish*> IngredientIndex::any(const std::vector<std::string>& ingredients) const {
+    KITCHEN_TIME_SCOPE("ingredients.any.ns");
+    std::vector<Dish*> result;
+    for (const std::string& ingredient : ingredients) {
+        const std::vector<Dish*>& list = postings(ingredient);
+        std::vector<Dish*> merged;
+        merged.reserve(result.size() + list.size());
+        std::set_union(result.begin(), result.end(), list.begin(), list.end(), std::back_inserter(merged),
+                       std::less<Dish*>());
+        result.swap(merged);
+    }
+    return result;
+}
+
+/**
+ * @return The number of distinct ingredients ever indexed.
+ */
+size_t IngredientIndex::ingredientCount() const {
+    return postings_.size();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file IngredientIndex.hpp
+ * @brief This file contains the declaration of the IngredientIndex class, an inverted index from each
+ * ingredient to the dishes that list it.
+ *
+ * Each posting list is kept sorted by dish address, so membership is a binary search and multi-ingredient
+ * queries are merges: all() intersects the lists smallest-first, switching to binary search when one list is
+ * much shorter than the other, and any() merges them into one sorted, duplicate-free list.
+ *
+ * Ingredient keys are never removed, even when their list becomes empty. That keeps the lists returned by
+ * postings() valid across updates, and the vocabulary of a menu is small.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef INGREDIENT_INDEX_HPP
+#define INGREDIENT_INDEX_HPP
+
+#include "Dish.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class IngredientIndex {
+    public:
+        /**
+         * Adds `dish` to the posting list of each of its ingredients.
+         * @pre The dish is not already indexed.
+         */
+        void insert(Dish* dish);
+
+        /**
+         * Removes `dish` from every posting list it is in. Does nothing if it is not indexed.
+         */
+        void erase(Dish* dish);
+
+        /**
+         * Re-indexes `dish` after its ingredients changed, e.g. through dietaryAccommodations().
+         */
+        void update(Dish* dish);
+
+        /**
+         * Re-indexes the first `count` dishes of `dishes` from scratch, discarding every other entry. Cheaper
+         * than calling update() on each dish when most of them changed, since each list is sorted once rather
+         * than kept sorted through every insertion.
+         */
+        void rebuild(Dish* const* dishes, const size_t& count);
+
+        /**
+         * @return The dishes listing `ingredient`, sorted by address, or an empty list.
+         */
+        const std::vector<Dish*>& postings(const std::string& ingredient) const;
+
+        /**
+         * @return The posting list of `ingredient`, or nullptr if no dish ever listed it. The pointer stays
+         * valid for the life of the index.
+         */
+        const std::vector<Dish*>* find(const std::string& ingredient) const;
+
+        /**
+         * @return True if `dish` lists `ingredient`, by binary search of the posting list.
+         */
+        bool contains(const std::string& ingredient, const Dish* dish) const;
+
+        /**
+         * @return The dishes listing every ingredient in `ingredients` (AND), sorted by address.
+         */
+        std::vector<Dish*> all(const std::vector<std::string>& ingredients) const;
+
+        /**
+         * @return The dishes listing at least one ingredient in `ingredients` (OR), sorted by address.
+         */
+        std::vector<Dish*> any(const std::vector<std::string>& ingredients) const;
+
+        /**
+         * @return The number of distinct ingredients ever indexed.
+         */
+        size_t ingredientCount() const;
+
+    private:
+        std::unordered_map<std::string, std::vector<Dish*>> postings_;
+        // The keys of postings_ each dish was filed under, so erase() does not depend on the dish's current
+        // ingredients. Keys of an unordered_map never move, so the pointers stay valid.
+        std::unordered_map<const Dish*, std::vector<const std::string*>> filed_under_;
+};
+
+#endif // INGREDIENT_INDEX_HPP
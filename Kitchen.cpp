@@ -13,193 +13,365 @@
 #include "Appetizer.hpp"
 #include "MainCourse.hpp"
 #include "Dessert.hpp"
-#include <fstream>
+#include "MenuReader.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
 
-Kitchen::Kitchen() : total_prep_time_(0), count_elaborate_(0) {}
+namespace {
+    /**
+     * Reads all of `text` as a number with std::from_chars.
+     * @return False if `text` is empty, out of range or has anything but the number, including whitespace, or if
+     * it is a floating-point "nan", "inf" or "infinity", which from_chars accepts but no price can be.
+     */
+    template <class T>
+    bool parseNumber(const std::string& text, T& value) {
+        const char* end = text.data() + text.size();
+        std::from_chars_result result = std::from_chars(text.data(), end, value);
+        if (result.ec != std::errc() || result.ptr != end) {
+            return false;
+        }
+        if constexpr (std::is_floating_point<T>::value) {
+            return std::isfinite(value);
+        }
+        return true;
+    }
+
+    /**
+     * Describes the rejected field in `error`.
+     * @return nullptr, for parseDish to return.
+     */
+    Dish* reject(Kitchen::ParseError& error, const int& column, const char* field, const std::string& value) {
+        error.column = column;
+        error.field = field;
+        error.value = value;
+        return nullptr;
+    }
+
+    /**
+     * Rejects the row if the Dish constructor replaced `name` with "UNKNOWN" because it has characters other
+     * than letters and whitespace, so the load reports it. The constructor's check is the only one a name goes
+     * through.
+     * @return `dish`, or nullptr after deleting it.
+     */
+    Dish* checkName(Dish* dish, const std::string& name, Kitchen::ParseError& error) {
+        if (dish->getName() != name) {
+            delete dish;
+            return reject(error, 2, "Name", name);
+        }
+        return dish;
+    }
+}
+
+Kitchen::Kitchen() : total_prep_time_(0), count_elaborate_(0), journal_(nullptr), track_quantiles_(false) {}
 
 /**
 * Parameterized constructor.
 * @param filename The name of the input CSV file containing dish
 information.
-* @pre The CSV file must be properly formatted.
+* @param policy Whether a row that cannot be parsed is skipped or ends the
+load. Either way it is recorded in getLoadReport().
 * @post Initializes the kitchen by reading dishes from the CSV file and
 storing them as `Dish*`.
 */
-Kitchen::Kitchen(const std::string& filename) {
-    std::ifstream file(filename);
+Kitchen::Kitchen(const std::string& filename, const ParsePolicy& policy) : total_prep_time_(0), count_elaborate_(0), journal_(nullptr), track_quantiles_(false) {
+    KITCHEN_TIME_SCOPE("kitchen.load.ns");
+    KITCHEN_TRACE_SCOPE("Kitchen::Kitchen(filename)");
+    // `phase` is restarted at each step of a row and paused while parseDish records its own steps, so
+    // consecutive spans tile the whole load.
+    // The reader reads the next chunk of the file on a background thread while this one parses the current one.
+    KITCHEN_TRACE_BEGIN(phase, "open file");
+    MenuReader file(filename, MenuReader::DEFAULT_BUFFER_SIZE, true);
 
+    std::string_view row;
     std::string line;
-    std::getline(file, line);
-
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string dish_type, name, ingredients_str, prep_time_str, price_str, cuisine_type_str, additional_attributes;
-
-        // Extract all parts of the CSV row
-        std::getline(ss, dish_type, ',');
-        std::getline(ss, name, ',');
-        std::getline(ss, ingredients_str, ',');
-        std::getline(ss, prep_time_str, ',');
-        std::getline(ss, price_str, ',');
-        std::getline(ss, cuisine_type_str, ',');
-        std::getline(ss, additional_attributes);
-
-        // Convert numeric fields
-        int prep_time = std::stoi(prep_time_str);
-        double price = std::stod(price_str);
-
-        // Parse ingredients
-        std::vector<std::string> ingredients;
-        std::stringstream ingredients_ss(ingredients_str);
-        std::string ingredient;
-        while (std::getline(ingredients_ss, ingredient, ';')) {
-            ingredients.push_back(ingredient);
-        }
-
-        // Determine the CuisineType
-        Dish::CuisineType cuisine_type;
-        if (cuisine_type_str == "ITALIAN") cuisine_type = Dish::CuisineType::ITALIAN;
-        else if (cuisine_type_str == "MEXICAN") cuisine_type = Dish::CuisineType::MEXICAN;
-        else if (cuisine_type_str == "CHINESE") cuisine_type = Dish::CuisineType::CHINESE;
-        else if (cuisine_type_str == "INDIAN") cuisine_type = Dish::CuisineType::INDIAN;
-        else if (cuisine_type_str == "AMERICAN") cuisine_type = Dish::CuisineType::AMERICAN;
-        else if (cuisine_type_str == "FRENCH") cuisine_type = Dish::CuisineType::FRENCH;
-        else cuisine_type = Dish::CuisineType::OTHER;
-
-        // Create the appropriate dish object based on DishType
-        if (dish_type == "APPETIZER") {
-            std::stringstream additional_ss(additional_attributes);
-            std::string serving_style_str, spiciness_str, vegetarian_str;
-            std::getline(additional_ss, serving_style_str, ';');
-            std::getline(additional_ss, spiciness_str, ';');
-            std::getline(additional_ss, vegetarian_str, ';');
-
-            Appetizer::ServingStyle serving_style;
-            if (serving_style_str == "PLATED") {
-                serving_style = Appetizer::ServingStyle::PLATED;
-            } else if (serving_style_str == "FAMILY_STYLE") {
-                serving_style = Appetizer::ServingStyle::FAMILY_STYLE;
-            } else if (serving_style_str == "BUFFET") {
-                serving_style = Appetizer::ServingStyle::BUFFET;
-            } else {
-                serving_style = Appetizer::ServingStyle::PLATED;
-            }
-            int spiciness_level = std::stoi(spiciness_str);
-            bool vegetarian = (vegetarian_str == "true");
-
-            Dish* appetizer = new Appetizer(name, ingredients, prep_time, price, cuisine_type, serving_style, spiciness_level, vegetarian);
-            add(appetizer);
-        } else if (dish_type == "MAINCOURSE") {
-            std::stringstream additional_ss(additional_attributes);
-            std::string cooking_method_str, protein_type, side_dishes_str, gluten_free_str;
-
-            std::getline(additional_ss, cooking_method_str, ';');
-            std::getline(additional_ss, protein_type, ';');
-            std::getline(additional_ss, side_dishes_str, ';');
-            std::getline(additional_ss, gluten_free_str, ';');
-
-            MainCourse::CookingMethod cooking_method;
-            if (cooking_method_str == "GRILLED") {
-                cooking_method = MainCourse::CookingMethod::GRILLED;
-            } else if (cooking_method_str == "BAKED") {
-                cooking_method = MainCourse::CookingMethod::BAKED;
-            } else if (cooking_method_str == "BOILED") {
-                cooking_method = MainCourse::CookingMethod::BOILED;
-            } else if (cooking_method_str == "FRIED") {
-                cooking_method = MainCourse::CookingMethod::FRIED;
-            } else if (cooking_method_str == "STEAMED") {
-                cooking_method = MainCourse::CookingMethod::STEAMED;
-            } else if (cooking_method_str == "RAW") {
-                cooking_method = MainCourse::CookingMethod::RAW;
-            } else {
-                cooking_method = MainCourse::CookingMethod::GRILLED;
+    ParseError error;
+    KITCHEN_TRACE_RESTART(phase, "read line");
+    while (file.nextLine(row)) {
+        if (row.empty()) {
+            continue;
+        }
+        KITCHEN_COUNTER_ADD("kitchen.load.rows", 1);
+        load_report_.rows++;
+        line.assign(row.data(), row.size());
+        KITCHEN_TRACE_END(phase);
+        Dish* dish = parseDish(line, error);
+        KITCHEN_TRACE_RESTART(phase, "add");
+        if (dish == nullptr) {
+            KITCHEN_COUNTER_ADD("kitchen.load.rejected_rows", 1);
+            load_report_.rejected++;
+            if (load_report_.errors.size() < ParseReport::MAX_ERRORS) {
+                error.line = file.getLineNumber();
+                load_report_.errors.push_back(error);
             }
-            bool gluten_free = (gluten_free_str == "true");
-
-            std::vector<MainCourse::SideDish> side_dishes;
-            std::stringstream side_dishes_ss(side_dishes_str);
-            std::string side_dish_str;
-            while (std::getline(side_dishes_ss, side_dish_str, '|')) {
-                std::string side_name, category_str;
-                std::stringstream side_ss(side_dish_str);
-                std::getline(side_ss, side_name, ':');
-                std::getline(side_ss, category_str, ':');
-                MainCourse::Category category;
-                if (category_str == "GRAIN") {
-                    category = MainCourse::Category::GRAIN;
-                } else if (category_str == "PASTA") {
-                    category = MainCourse::Category::PASTA;
-                } else if (category_str == "LEGUME") {
-                    category = MainCourse::Category::LEGUME;
-                } else if (category_str == "BREAD") {
-                    category = MainCourse::Category::BREAD;
-                } else if (category_str == "SALAD") {
-                    category = MainCourse::Category::SALAD;
-                } else if (category_str == "SOUP") {
-                    category = MainCourse::Category::SOUP;
-                } else if (category_str == "STARCHES") {
-                    category = MainCourse::Category::STARCHES;
-                } else if (category_str == "VEGETABLE") {
-                    category = MainCourse::Category::VEGETABLE;
-                } else {
-                    category = MainCourse::Category::GRAIN;
-                }
-                side_dishes.push_back({side_name, category});
+            if (policy == STRICT) {
+                load_report_.stopped = true;
+                break;
             }
+        } else if (newOrder(dish)) {
+            source_rows_.emplace(dish, line);
+        } else {
+            delete dish;
+        }
+        KITCHEN_TRACE_RESTART(phase, "read line");
+    }
 
-            Dish* main_course = new MainCourse(name, ingredients, prep_time, price, cuisine_type, cooking_method, protein_type, side_dishes, gluten_free);
-            add(main_course);
-        } else if (dish_type == "DESSERT") {
-            std::stringstream additional_ss(additional_attributes);
-            std::string flavor_profile_str, sweetness_level_str, contains_nuts_str;
-
-            std::getline(additional_ss, flavor_profile_str, ';');
-            std::getline(additional_ss, sweetness_level_str, ';');
-            std::getline(additional_ss, contains_nuts_str, ';');
-
-            Dessert::FlavorProfile flavor_profile;
-            if (flavor_profile_str == "SWEET") {
-                flavor_profile = Dessert::FlavorProfile::SWEET;
-            } else if (flavor_profile_str == "BITTER") {
-                flavor_profile = Dessert::FlavorProfile::BITTER;
-            } else if (flavor_profile_str == "SOUR") {
-                flavor_profile = Dessert::FlavorProfile::SOUR;
-            } else if (flavor_profile_str == "SALTY") {
-                flavor_profile = Dessert::FlavorProfile::SALTY;
-            } else if (flavor_profile_str == "UMAMI") {
-                flavor_profile = Dessert::FlavorProfile::UMAMI;
+    KITCHEN_TRACE_END(phase);
+    KITCHEN_GAUGE_SET("kitchen.dishes", getCurrentSize());
+}
+
+/**
+* Parses one CSV row of the menu file. Numbers are read with std::from_chars,
+so nothing is thrown and the locale is ignored.
+* @param line A row in the format DishType,Name,Ingredients,PrepTime,Price,
+CuisineType,AdditionalAttributes.
+* @return A new Appetizer, MainCourse or Dessert owned by the caller, or
+nullptr if the DishType is not recognized, the Name has characters other
+than letters and whitespace, or a number is malformed.
+*/
+Dish* Kitchen::parseDish(const std::string& line) {
+    ParseError error;
+    return parseDish(line, error);
+}
+
+/**
+* Parses one CSV row as parseDish(line), describing a rejected row.
+* @param error Set to the first bad field if nullptr is returned. Its line is
+left unchanged.
+*/
+Dish* Kitchen::parseDish(const std::string& line, ParseError& error) {
+    KITCHEN_TRACE_BEGIN(phase, "tokenize row");
+    std::stringstream ss(line);
+    std::string dish_type, name, ingredients_str, prep_time_str, price_str, cuisine_type_str, additional_attributes;
+
+    // Extract all parts of the CSV row
+    std::getline(ss, dish_type, ',');
+    std::getline(ss, name, ',');
+    std::getline(ss, ingredients_str, ',');
+    std::getline(ss, prep_time_str, ',');
+    std::getline(ss, price_str, ',');
+    std::getline(ss, cuisine_type_str, ',');
+    std::getline(ss, additional_attributes);
+
+    // Convert numeric fields
+    KITCHEN_TRACE_RESTART(phase, "from_chars");
+    int prep_time;
+    double price;
+    if (!parseNumber(prep_time_str, prep_time)) {
+        return reject(error, 4, "PrepTime", prep_time_str);
+    }
+    if (!parseNumber(price_str, price)) {
+        return reject(error, 5, "Price", price_str);
+    }
+
+    // Parse ingredients
+    KITCHEN_TRACE_RESTART(phase, "tokenize ingredients");
+    std::vector<std::string> ingredients;
+    std::stringstream ingredients_ss(ingredients_str);
+    std::string ingredient;
+    while (std::getline(ingredients_ss, ingredient, ';')) {
+        ingredients.push_back(ingredient);
+    }
+
+    // Determine the CuisineType
+    KITCHEN_TRACE_RESTART(phase, "enum lookup");
+    Dish::CuisineType cuisine_type;
+    if (cuisine_type_str == "ITALIAN") cuisine_type = Dish::CuisineType::ITALIAN;
+    else if (cuisine_type_str == "MEXICAN") cuisine_type = Dish::CuisineType::MEXICAN;
+    else if (cuisine_type_str == "CHINESE") cuisine_type = Dish::CuisineType::CHINESE;
+    else if (cuisine_type_str == "INDIAN") cuisine_type = Dish::CuisineType::INDIAN;
+    else if (cuisine_type_str == "AMERICAN") cuisine_type = Dish::CuisineType::AMERICAN;
+    else if (cuisine_type_str == "FRENCH") cuisine_type = Dish::CuisineType::FRENCH;
+    else cuisine_type = Dish::CuisineType::OTHER;
+
+    // Create the appropriate dish object based on DishType
+    if (dish_type == "APPETIZER") {
+        KITCHEN_TRACE_RESTART(phase, "tokenize attributes");
+        std::stringstream additional_ss(additional_attributes);
+        std::string serving_style_str, spiciness_str, vegetarian_str;
+        std::getline(additional_ss, serving_style_str, ';');
+        std::getline(additional_ss, spiciness_str, ';');
+        std::getline(additional_ss, vegetarian_str, ';');
+
+        Appetizer::ServingStyle serving_style;
+        if (serving_style_str == "PLATED") {
+            serving_style = Appetizer::ServingStyle::PLATED;
+        } else if (serving_style_str == "FAMILY_STYLE") {
+            serving_style = Appetizer::ServingStyle::FAMILY_STYLE;
+        } else if (serving_style_str == "BUFFET") {
+            serving_style = Appetizer::ServingStyle::BUFFET;
+        } else {
+            serving_style = Appetizer::ServingStyle::PLATED;
+        }
+        KITCHEN_TRACE_RESTART(phase, "from_chars");
+        int spiciness_level;
+        if (!parseNumber(spiciness_str, spiciness_level)) {
+            return reject(error, 7, "Spiciness", spiciness_str);
+        }
+        bool vegetarian = (vegetarian_str == "true");
+
+        KITCHEN_TRACE_RESTART(phase, "new Dish");
+        return checkName(new Appetizer(name, ingredients, prep_time, price, cuisine_type, serving_style, spiciness_level, vegetarian), name, error);
+    } else if (dish_type == "MAINCOURSE") {
+        KITCHEN_TRACE_RESTART(phase, "tokenize attributes");
+        std::stringstream additional_ss(additional_attributes);
+        std::string cooking_method_str, protein_type, side_dishes_str, gluten_free_str;
+
+        std::getline(additional_ss, cooking_method_str, ';');
+        std::getline(additional_ss, protein_type, ';');
+        std::getline(additional_ss, side_dishes_str, ';');
+        std::getline(additional_ss, gluten_free_str, ';');
+
+        MainCourse::CookingMethod cooking_method;
+        if (cooking_method_str == "GRILLED") {
+            cooking_method = MainCourse::CookingMethod::GRILLED;
+        } else if (cooking_method_str == "BAKED") {
+            cooking_method = MainCourse::CookingMethod::BAKED;
+        } else if (cooking_method_str == "BOILED") {
+            cooking_method = MainCourse::CookingMethod::BOILED;
+        } else if (cooking_method_str == "FRIED") {
+            cooking_method = MainCourse::CookingMethod::FRIED;
+        } else if (cooking_method_str == "STEAMED") {
+            cooking_method = MainCourse::CookingMethod::STEAMED;
+        } else if (cooking_method_str == "RAW") {
+            cooking_method = MainCourse::CookingMethod::RAW;
+        } else {
+            cooking_method = MainCourse::CookingMethod::GRILLED;
+        }
+        bool gluten_free = (gluten_free_str == "true");
+
+        std::vector<MainCourse::SideDish> side_dishes;
+        std::stringstream side_dishes_ss(side_dishes_str);
+        std::string side_dish_str;
+        while (std::getline(side_dishes_ss, side_dish_str, '|')) {
+            std::string side_name, category_str;
+            std::stringstream side_ss(side_dish_str);
+            std::getline(side_ss, side_name, ':');
+            std::getline(side_ss, category_str, ':');
+            MainCourse::Category category;
+            if (category_str == "GRAIN") {
+                category = MainCourse::Category::GRAIN;
+            } else if (category_str == "PASTA") {
+                category = MainCourse::Category::PASTA;
+            } else if (category_str == "LEGUME") {
+                category = MainCourse::Category::LEGUME;
+            } else if (category_str == "BREAD") {
+                category = MainCourse::Category::BREAD;
+            } else if (category_str == "SALAD") {
+                category = MainCourse::Category::SALAD;
+            } else if (category_str == "SOUP") {
+                category = MainCourse::Category::SOUP;
+            } else if (category_str == "STARCHES") {
+                category = MainCourse::Category::STARCHES;
+            } else if (category_str == "VEGETABLE") {
+                category = MainCourse::Category::VEGETABLE;
             } else {
-                flavor_profile = Dessert::FlavorProfile::SWEET;
+                category = MainCourse::Category::GRAIN;
             }
-            int sweetness_level = std::stoi(sweetness_level_str);
-            bool contains_nuts = (contains_nuts_str == "true");
+            side_dishes.push_back({side_name, category});
+        }
+
+        KITCHEN_TRACE_RESTART(phase, "new Dish");
+        return checkName(new MainCourse(name, ingredients, prep_time, price, cuisine_type, cooking_method, protein_type, side_dishes, gluten_free), name, error);
+    } else if (dish_type == "DESSERT") {
+        KITCHEN_TRACE_RESTART(phase, "tokenize attributes");
+        std::stringstream additional_ss(additional_attributes);
+        std::string flavor_profile_str, sweetness_level_str, contains_nuts_str;
 
-            Dish* dessert = new Dessert(name, ingredients, prep_time, price, cuisine_type, flavor_profile, sweetness_level, contains_nuts);
-            add(dessert);
+        std::getline(additional_ss, flavor_profile_str, ';');
+        std::getline(additional_ss, sweetness_level_str, ';');
+        std::getline(additional_ss, contains_nuts_str, ';');
+
+        Dessert::FlavorProfile flavor_profile;
+        if (flavor_profile_str == "SWEET") {
+            flavor_profile = Dessert::FlavorProfile::SWEET;
+        } else if (flavor_profile_str == "BITTER") {
+            flavor_profile = Dessert::FlavorProfile::BITTER;
+        } else if (flavor_profile_str == "SOUR") {
+            flavor_profile = Dessert::FlavorProfile::SOUR;
+        } else if (flavor_profile_str == "SALTY") {
+            flavor_profile = Dessert::FlavorProfile::SALTY;
+        } else if (flavor_profile_str == "UMAMI") {
+            flavor_profile = Dessert::FlavorProfile::UMAMI;
+        } else {
+            flavor_profile = Dessert::FlavorProfile::SWEET;
+        }
+        KITCHEN_TRACE_RESTART(phase, "from_chars");
+        int sweetness_level;
+        if (!parseNumber(sweetness_level_str, sweetness_level)) {
+            return reject(error, 7, "Sweetness", sweetness_level_str);
         }
+        bool contains_nuts = (contains_nuts_str == "true");
+
+        KITCHEN_TRACE_RESTART(phase, "new Dish");
+        return checkName(new Dessert(name, ingredients, prep_time, price, cuisine_type, flavor_profile, sweetness_level, contains_nuts), name, error);
     }
+    return reject(error, 1, "DishType", dish_type);
+}
 
-    file.close();
+/**
+* @return What the constructor read and rejected; empty if the kitchen was not
+loaded from a file.
+*/
+const Kitchen::ParseReport& Kitchen::getLoadReport() const {
+    return load_report_;
+}
+
+/**
+* @return The dishes in kitchen order. The kitchen still owns them.
+*/
+std::vector<Dish*> Kitchen::toVector() const {
+    return std::vector<Dish*>(items_, items_ + getCurrentSize());
 }
 
 bool Kitchen::newOrder(Dish* new_dish)
 {
     if (add(new_dish))
     {
+        compatibility_.push_back(new_dish->getCompatibility());
+        index_.insert(new_dish);
+        const KitchenIndex::Entry& entry = *index_.find(new_dish);
+        summaries_.push_back({entry.prep_time, entry.price, entry.cuisine, entry.type});
+        ingredient_index_.insert(new_dish);
+        name_index_.insert(new_dish);
+        if (track_quantiles_)
+        {
+            prep_sketch_.add(new_dish->getPrepTime());
+            price_sketch_.add(new_dish->getPrice());
+        }
+        KITCHEN_COUNTER_ADD("kitchen.newOrder.accepted", 1);
+        KITCHEN_GAUGE_SET("kitchen.dishes", getCurrentSize());
         total_prep_time_ += new_dish->getPrepTime();
         //std::cout<< "Dish added: "<<new_dish.getName() << std::endl;
         //if the new dish has 5 or more ingredients AND takes an hour or more to prepare, increment count_elaborate_
-        if (new_dish->getIngredients().size() >= 5 && new_dish->getPrepTime() >= 60)
+        if (new_dish->getIngredientList().size() >= 5 && new_dish->getPrepTime() >= 60)
         {
             //std::cout << "Elaborate dish added: "<<new_dish.getName() << std::endl;
             count_elaborate_++;
         }
+        if (journal_ != nullptr)
+        {
+            journal_->logNewOrder(*new_dish);
+        }
         return true;
     }
+    KITCHEN_COUNTER_ADD("kitchen.newOrder.rejected", 1);
+    if (getCurrentSize() >= DEFAULT_CAPACITY)
+    {
+        KITCHEN_COUNTER_ADD("kitchen.newOrder.rejected_full", 1);
+    }
+    else
+    {
+        KITCHEN_COUNTER_ADD("kitchen.newOrder.rejected_duplicate", 1);
+    }
     return false;
 }
 bool Kitchen::serveDish(Dish* dish_to_remove)
@@ -208,15 +380,50 @@ bool Kitchen::serveDish(Dish* dish_to_remove)
     {
         return false;
     }
-    if (remove(dish_to_remove))
+    int index;
+    {
+        KITCHEN_TIME_SCOPE("kitchen.serveDish.search.ns");
+        index = getIndexOf(dish_to_remove);
+    }
+    // Dishes compared by the linear search: the whole bag on a miss, up to and including the match on a hit.
+    KITCHEN_HISTOGRAM_RECORD("kitchen.serveDish.scanned", index > -1 ? index + 1 : getCurrentSize());
+    if (index > -1)
     {
+        // The same swap with the last dish as ArrayBag::remove(), done here so the position is known: the
+        // last dish's mask and summary move into the hole with it.
+        item_count_--;
+        items_[index] = items_[item_count_];
+        compatibility_[index] = compatibility_.back();
+        compatibility_.pop_back();
+        summaries_[index] = summaries_.back();
+        summaries_.pop_back();
+        KITCHEN_COUNTER_ADD("kitchen.serveDish.served", 1);
+        KITCHEN_GAUGE_SET("kitchen.dishes", getCurrentSize());
         total_prep_time_ -= dish_to_remove->getPrepTime();
-        if (dish_to_remove->getIngredients().size() >= 5 && dish_to_remove->getPrepTime() >= 60)
+        if (dish_to_remove->getIngredientList().size() >= 5 && dish_to_remove->getPrepTime() >= 60)
         {
             count_elaborate_--;
         }
+        index_.erase(dish_to_remove);
+        ingredient_index_.erase(dish_to_remove);
+        name_index_.erase(dish_to_remove);
+        dietary_views_.forget(dish_to_remove);
+        if (track_quantiles_)
+        {
+            prep_sketch_.remove(dish_to_remove->getPrepTime());
+            price_sketch_.remove(dish_to_remove->getPrice());
+        }
+        if (!source_rows_.empty())
+        {
+            source_rows_.erase(dish_to_remove);
+        }
+        if (journal_ != nullptr)
+        {
+            journal_->logServeDish(*dish_to_remove, index);
+        }
         return true;
     }
+    KITCHEN_COUNTER_ADD("kitchen.serveDish.not_found", 1);
     return false;
 }
 int Kitchen::getPrepTimeSum() const
@@ -229,6 +436,7 @@ int Kitchen::getPrepTimeSum() const
 }
 int Kitchen::calculateAvgPrepTime() const
 {
+    KITCHEN_TRACE_SCOPE("Kitchen::calculateAvgPrepTime");
     if (getCurrentSize() == 0)
     {
         return 0;
@@ -253,6 +461,7 @@ int Kitchen::elaborateDishCount() const
 }
 double Kitchen::calculateElaboratePercentage() const
 {
+    KITCHEN_TRACE_SCOPE("Kitchen::calculateElaboratePercentage");
     // //Computes the percentage of vegetarian dishes in the kitchen rounded up to 2 decimal places.
     // double elaborate_dish = count_elaborate_;
     // std::cout << elaborate_dish << std::endl;
@@ -277,27 +486,31 @@ double Kitchen::calculateElaboratePercentage() const
     //return count_elaborate_ / getCurrentSize();
 }
 int Kitchen::tallyCuisineTypes(const std::string& cuisine_type) const{
-    int count = 0;
-    for (int i = 0; i < getCurrentSize(); i++)
+    KITCHEN_TRACE_SCOPE("Kitchen::tallyCuisineTypes");
+    // The cuisine index holds exactly the dishes of each cuisine, so no dish is visited.
+    int cuisine = KitchenIndex::cuisineFromName(cuisine_type);
+    if (cuisine < 0)
     {
-        if (items_[i]->getCuisineType() == cuisine_type)
-        {
-            count++;
-        }
+        return 0;
     }
-    return count;
+    return static_cast<int>(index_.byCuisine(static_cast<Dish::CuisineType>(cuisine)).size());
 }
 int Kitchen::releaseDishesBelowPrepTime(const int& prep_time)
 {
     int count = 0;
-    int num= getCurrentSize();
-    for (int i = 0; i < num; i++)
+    // serveDish() moves the last dish into position i, so i is only advanced past dishes that stay.
+    int i = 0;
+    while (i < getCurrentSize())
     {
         if (items_[i]->getPrepTime() < prep_time)
         {
             count++;
             serveDish(items_[i]);
         }
+        else
+        {
+            i++;
+        }
     }
     return count;
 }
@@ -305,18 +518,26 @@ int Kitchen::releaseDishesBelowPrepTime(const int& prep_time)
 int Kitchen::releaseDishesOfCuisineType(const std::string& cuisine_type)
 {
     int count = 0;
-    for (int i = 0; i < getCurrentSize(); i++)
+    // As in releaseDishesBelowPrepTime(), position i is checked again after a dish is served from it.
+    int i = 0;
+    while (i < getCurrentSize())
     {
         if (items_[i]->getCuisineType() == cuisine_type)
         {
             count++;
             serveDish(items_[i]);
         }
+        else
+        {
+            i++;
+        }
     }
     return count;
 }
 void Kitchen::kitchenReport() const
 {
+    KITCHEN_TIME_SCOPE("kitchen.kitchenReport.ns");
+    KITCHEN_TRACE_SCOPE("Kitchen::kitchenReport");
     std::cout << "ITALIAN: " << tallyCuisineTypes("ITALIAN") << std::endl;
     std::cout << "MEXICAN: " << tallyCuisineTypes("MEXICAN") << std::endl;
     std::cout << "CHINESE: " << tallyCuisineTypes("CHINESE") << std::endl;
@@ -337,9 +558,18 @@ accommodations.
 kitchen to adjust them accordingly.
 */
 void Kitchen::dietaryAdjustment(const Dish::DietaryRequest& request) {
+    KITCHEN_TIME_SCOPE("kitchen.dietaryAdjustment.ns");
+    KITCHEN_TRACE_SCOPE("Kitchen::dietaryAdjustment");
     for (int i = 0; i < getCurrentSize(); ++i) {
+            KITCHEN_TRACE_SCOPE("Dish::dietaryAccommodations");
             items_[i]->dietaryAccommodations(request);
         }
+    // Most dishes may have lost ingredients, so the postings are rebuilt in one pass.
+    ingredient_index_.rebuild(items_, getCurrentSize());
+    refreshCompatibility();
+    if (journal_ != nullptr) {
+        journal_->logDietaryAdjustment(request);
+    }
 }
 
 
@@ -348,16 +578,303 @@ void Kitchen::dietaryAdjustment(const Dish::DietaryRequest& request) {
  * @post Calls the `display()` method of each dish.
 */
 void Kitchen::displayMenu() const {
+    KITCHEN_TIME_SCOPE("kitchen.displayMenu.ns");
+    KITCHEN_TRACE_SCOPE("Kitchen::displayMenu");
     for (int i = 0; i < getCurrentSize(); ++i) {
+        KITCHEN_TRACE_SCOPE("Dish::display");
         items_[i]->display();
     }
 }
 
+namespace {
+    bool isElaborate(const Dish* dish) {
+        return dish->getIngredientList().size() >= 5 && dish->getPrepTime() >= 60;
+    }
+
+    /**
+     * Copies every attribute outside the operator== identity from `source` to `target`.
+     * @pre Both dishes have the same dynamic type.
+     */
+    void copyAttributes(Dish* target, const Dish& source) {
+        target->setIngredients(source.getIngredientList());
+        if (Appetizer* appetizer = dynamic_cast<Appetizer*>(target)) {
+            const Appetizer& from = static_cast<const Appetizer&>(source);
+            appetizer->setServingStyle(from.getServingStyle());
+            appetizer->setSpicinessLevel(from.getSpicinessLevel());
+            appetizer->setVegetarian(from.isVegetarian());
+        } else if (MainCourse* main_course = dynamic_cast<MainCourse*>(target)) {
+            const MainCourse& from = static_cast<const MainCourse&>(source);
+            main_course->setCookingMethod(from.getCookingMethod());
+            main_course->setProteinType(from.getProteinType());
+            main_course->setSideDishes(from.getSideDishList());
+            main_course->setGlutenFree(from.isGlutenFree());
+        } else if (Dessert* dessert = dynamic_cast<Dessert*>(target)) {
+            const Dessert& from = static_cast<const Dessert&>(source);
+            dessert->setFlavorProfile(from.getFlavorProfile());
+            dessert->setSweetnessLevel(from.getSweetnessLevel());
+            dessert->setContainsNuts(from.containsNuts());
+        }
+    }
+}
+
+/**
+ * Copies every attribute outside the operator== identity from `source` to
+ * the dish at `index`, keeping the counts, indexes and compatibility masks
+ * current, and journals the update.
+ * @pre `source` has the same dynamic type as the dish.
+ */
+void Kitchen::updateDish(const int& index, const Dish& source) {
+    Dish* dish = items_[index];
+    count_elaborate_ -= isElaborate(dish);
+    copyAttributes(dish, source);
+    count_elaborate_ += isElaborate(dish);
+    ingredient_index_.update(dish);
+    dietary_views_.forget(dish);
+    compatibility_[index] = dish->getCompatibility();
+    if (journal_ != nullptr) {
+        journal_->logUpdateDish(*dish, index);
+    }
+}
+
+/**
+ * Re-reads the CSV file and applies only what changed since the dishes were
+ * loaded. Rows identical to a loaded dish's row are left alone, so pointers
+ * to those dishes stay valid. A changed row whose dish matches a vanished
+ * dish by `Dish::operator==` and subclass updates that dish in place; other
+ * new rows are added and other vanished dishes are served and deallocated.
+ * @param filename The CSV file, with the same header line the constructor
+ * skips.
+ * @return Counts of each kind of change.
+ * @post Dishes that were not loaded from a file (added through newOrder())
+ * are not touched.
+ */
+Kitchen::ReloadStats Kitchen::reload(const std::string& filename) {
+    KITCHEN_TIME_SCOPE("kitchen.reload.ns");
+    KITCHEN_TRACE_SCOPE("Kitchen::reload");
+    ReloadStats stats;
+    MenuReader file(filename, MenuReader::DEFAULT_BUFFER_SIZE, true);
+    if (!file.isOpen()) {
+        return stats;
+    }
+
+    // Each loaded row can be claimed by one identical row of the new file. The views point into
+    // source_rows_, which is not modified until every row has been matched.
+    std::unordered_map<std::string_view, std::vector<Dish*>> loaded;
+    loaded.reserve(source_rows_.size());
+    for (const auto& entry : source_rows_) {
+        loaded[entry.second].push_back(entry.first);
+    }
+    std::vector<std::string> changed_rows;
+    std::string_view line;
+    while (file.nextLine(line)) {
+        // Blank lines are skipped, as the constructor skips them.
+        if (line.empty()) {
+            continue;
+        }
+        auto found = loaded.find(line);
+        if (found != loaded.end() && !found->second.empty()) {
+            found->second.pop_back();
+            stats.unchanged++;
+        } else {
+            changed_rows.emplace_back(line);
+        }
+    }
+    std::vector<Dish*> vanished;
+    for (const auto& entry : loaded) {
+        vanished.insert(vanished.end(), entry.second.begin(), entry.second.end());
+    }
+
+    // Only changed rows are parsed. A row that keeps a vanished dish's identity updates that dish.
+    std::vector<std::pair<Dish*, std::string>> additions;
+    for (std::string& row : changed_rows) {
+        Dish* fresh = parseDish(row);
+        if (fresh == nullptr) {
+            stats.rejected++;
+            continue;
+        }
+        auto match = std::find_if(vanished.begin(), vanished.end(), [&](const Dish* dish) {
+            return *dish == *fresh && typeid(*dish) == typeid(*fresh);
+        });
+        if (match == vanished.end()) {
+            additions.emplace_back(fresh, std::move(row));
+            continue;
+        }
+        Dish* dish = *match;
+        *match = vanished.back();
+        vanished.pop_back();
+        updateDish(getIndexOf(dish), *fresh);
+        source_rows_[dish] = std::move(row);
+        delete fresh;
+        stats.updated++;
+    }
+
+    // Removals first, so that additions can use the space they free.
+    for (Dish* dish : vanished) {
+        serveDish(dish);
+        delete dish;
+        stats.removed++;
+    }
+    for (auto& addition : additions) {
+        if (newOrder(addition.first)) {
+            source_rows_.emplace(addition.first, std::move(addition.second));
+            stats.added++;
+        } else {
+            delete addition.first;
+            stats.rejected++;
+        }
+    }
+    KITCHEN_COUNTER_ADD("kitchen.reload.changed_rows", changed_rows.size());
+    return stats;
+}
+
+/**
+ * Attaches a write-ahead journal. From then on every accepted newOrder(),
+ * every serveDish() (including releases) and every dietaryAdjustment() is
+ * logged to it.
+ * @param journal The journal, or nullptr to stop logging. The kitchen does
+ * not own it.
+ */
+void Kitchen::attachJournal(OrderJournal* journal) {
+    journal_ = journal;
+}
+
+/**
+ * @return The attached journal, or nullptr.
+ */
+OrderJournal* Kitchen::getJournal() const {
+    return journal_;
+}
+
+/**
+ * @return The cuisine, dish type, prep time and price indexes, kept current
+ * by newOrder() and serveDish().
+ */
+const KitchenIndex& Kitchen::getIndex() const {
+    return index_;
+}
+
+/**
+ * @return The ingredient posting lists, kept current by newOrder(),
+ * serveDish() and dietaryAdjustment().
+ */
+const IngredientIndex& Kitchen::getIngredientIndex() const {
+    return ingredient_index_;
+}
+
+/**
+ * @return The name trie for exact, prefix and fuzzy lookups, kept current by
+ * newOrder() and serveDish().
+ */
+const NameIndex& Kitchen::getNameIndex() const {
+    return name_index_;
+}
+
+/**
+ * Starts or stops keeping streaming quantile sketches of prep time and
+ * price. While enabled, newOrder() and serveDish() update them, so an
+ * approximate percentile costs no pass over the dishes; for exact ones see
+ * KitchenStats.
+ * @param enabled True to build the sketches from the current dishes and
+ * keep them current, false to drop them.
+ */
+void Kitchen::trackQuantiles(const bool& enabled) {
+    track_quantiles_ = enabled;
+    prep_sketch_.clear();
+    price_sketch_.clear();
+    if (enabled) {
+        for (int i = 0; i < getCurrentSize(); i++) {
+            prep_sketch_.add(items_[i]->getPrepTime());
+            price_sketch_.add(items_[i]->getPrice());
+        }
+    }
+}
+
+/**
+ * @return `dish` as it would be served under `request`, leaving the dish
+ * itself unchanged. A view holds only what the request changes; views are
+ * built on first use, shared by every caller with the same request, and
+ * invalid once the dish changes or is served; see DietaryViews.
+ */
+DietaryViews::View Kitchen::dietaryView(const Dish* dish, const Dish::DietaryRequest& request) const {
+    return dietary_views_.view(dish, request);
+}
+
+/**
+ * @return The number of dishes that already meet every part of `request`,
+ * per Dish::getCompatibility(), without adjusting any.
+ */
+int Kitchen::countCompatible(const Dish::DietaryRequest& request) const {
+    KITCHEN_TIME_SCOPE("kitchen.countCompatible.ns");
+    uint8_t wanted = Dish::maskOf(request);
+    const uint8_t* masks = compatibility_.data();
+    size_t size = compatibility_.size();
+    // Branch-free over contiguous masks. The fixed-length inner loop sums into a byte, which cannot overflow in
+    // 128 steps, so the compiler vectorizes it at -O2 as 16 or 32 masks per instruction.
+    const size_t block = 128;
+    int count = 0;
+    size_t i = 0;
+    for (; i + block <= size; i += block) {
+        uint8_t matched = 0;
+        for (size_t j = 0; j < block; j++) {
+            matched += (masks[i + j] & wanted) == wanted;
+        }
+        count += matched;
+    }
+    for (; i < size; i++) {
+        count += (masks[i] & wanted) == wanted;
+    }
+    return count;
+}
+
+/**
+ * @return The dishes that already meet every part of `request`, in kitchen
+ * order.
+ */
+std::vector<Dish*> Kitchen::filterCompatible(const Dish::DietaryRequest& request) const {
+    KITCHEN_TIME_SCOPE("kitchen.filterCompatible.ns");
+    uint8_t wanted = Dish::maskOf(request);
+    std::vector<Dish*> out;
+    for (size_t i = 0; i < compatibility_.size(); i++) {
+        if ((compatibility_[i] & wanted) == wanted) {
+            out.push_back(items_[i]);
+        }
+    }
+    return out;
+}
+
+/**
+ * Re-reads every dish's compatibility mask. Call it after changing dishes
+ * through their own setters; the kitchen's own operations keep the masks
+ * current.
+ */
+void Kitchen::refreshCompatibility() {
+    compatibility_.resize(getCurrentSize());
+    for (int i = 0; i < getCurrentSize(); i++) {
+        compatibility_[i] = items_[i]->getCompatibility();
+    }
+}
+
+/**
+ * @return The prep time sketch, or nullptr if quantiles are not tracked.
+ */
+const QuantileSketch* Kitchen::getPrepTimeSketch() const {
+    return track_quantiles_ ? &prep_sketch_ : nullptr;
+}
+
+/**
+ * @return The price sketch, or nullptr if quantiles are not tracked.
+ */
+const QuantileSketch* Kitchen::getPriceSketch() const {
+    return track_quantiles_ ? &price_sketch_ : nullptr;
+}
+
 /**
  * Destructor.
  * @post Deallocates all dynamically allocated dishes to prevent memory
 leaks. */
 Kitchen::~Kitchen() {
+    // Views held outside the kitchen must see that their dishes are gone before they are.
+    dietary_views_.clear();
     for (int i = 0; i < getCurrentSize(); ++i) {
         delete items_[i];  // Deallocate memory
     }
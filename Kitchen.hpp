@@ -13,24 +13,120 @@
 #define KITCHEN_HPP
 
 #include "ArrayBag.hpp"
+#include "DietaryViews.hpp"
 #include "Dish.hpp"
+#include "IngredientIndex.hpp"
+#include "KitchenIndex.hpp"
+#include "NameIndex.hpp"
+#include "OrderJournal.hpp"
+#include "QuantileSketch.hpp"
 // for round
 #include <cmath>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Kitchen : public ArrayBag<Dish*> {
     public:
+        // The most dishes a kitchen holds, public so that tools can check at compile time that it is what they
+        // were built for.
+        using ArrayBag<Dish*>::DEFAULT_CAPACITY;
+
+        /**
+        * @struct ReloadStats
+        * @brief What reload() changed.
+        */
+        struct ReloadStats {
+            int added = 0;       ///< Rows with no matching dish, added through newOrder().
+            int removed = 0;     ///< Dishes whose row disappeared, served and deallocated.
+            int updated = 0;     ///< Dishes whose identity matched a changed row, updated in place.
+            int unchanged = 0;   ///< Rows identical to the row the dish was loaded from.
+            int rejected = 0;    ///< New rows that could not be parsed or did not fit.
+        };
+
+        /**
+        * @enum ParsePolicy
+        * @brief What loading a file does with a row that cannot be parsed.
+        */
+        enum ParsePolicy {
+            SKIP,     ///< Record the row in the load report and go on.
+            STRICT    ///< Record the row and stop; the dishes before it stay loaded.
+        };
+
+        /**
+        * @struct ParseError
+        * @brief Where and why a row could not be parsed.
+        */
+        struct ParseError {
+            uint64_t line = 0;   ///< 1-based line of the file, counting the header; 0 if not read from a file.
+            int column = 0;      ///< 1-based CSV column of the bad field.
+            std::string field;   ///< The field's name, e.g. "Name", "PrepTime" or "Spiciness".
+            std::string value;   ///< The field's text.
+        };
+
+        /**
+        * @struct ParseReport
+        * @brief What loading a file read and rejected.
+        */
+        struct ParseReport {
+            static const size_t MAX_ERRORS = 100;
+            uint64_t rows = 0;                ///< Data rows read, not counting blank lines.
+            uint64_t rejected = 0;            ///< Rows that could not be parsed.
+            bool stopped = false;             ///< True if a STRICT load stopped at a rejected row.
+            std::vector<ParseError> errors;   ///< The first MAX_ERRORS rejected rows.
+        };
+
         Kitchen();
         /**
         * Parameterized constructor.
         * @param filename The name of the input CSV file containing dish
         information.
-        * @pre The CSV file must be properly formatted.
+        * @param policy Whether a row that cannot be parsed is skipped or ends
+        the load. Either way it is recorded in getLoadReport().
         * @post Initializes the kitchen by reading dishes from the CSV file and
         storing them as `Dish*`.
         */
-        Kitchen(const std::string& filename);
+        Kitchen(const std::string& filename, const ParsePolicy& policy = SKIP);
+        /**
+        * Parses one CSV row of the menu file. Numbers are read with
+        std::from_chars, so nothing is thrown and the locale is ignored.
+        * @param line A row in the format DishType,Name,Ingredients,PrepTime,
+        Price,CuisineType,AdditionalAttributes.
+        * @return A new Appetizer, MainCourse or Dessert owned by the caller,
+        or nullptr if the DishType is not recognized, the Name has characters
+        other than letters and whitespace, or a number is malformed.
+        */
+        static Dish* parseDish(const std::string& line);
+        /**
+        * Parses one CSV row as parseDish(line), describing a rejected row.
+        * @param error Set to the first bad field if nullptr is returned. Its
+        line is left unchanged.
+        */
+        static Dish* parseDish(const std::string& line, ParseError& error);
+        /**
+        * @return What the constructor read and rejected; empty if the kitchen
+        was not loaded from a file.
+        */
+        const ParseReport& getLoadReport() const;
+        /**
+        * @return The dishes in kitchen order. The kitchen still owns them.
+        */
+        std::vector<Dish*> toVector() const;
+        /**
+        * Re-reads the CSV file and applies only what changed since the
+        dishes were loaded. Rows identical to a loaded dish's row are left
+        alone, so pointers to those dishes stay valid. A changed row whose
+        dish matches a vanished dish by `Dish::operator==` and subclass
+        updates that dish in place; other new rows are added and other
+        vanished dishes are served and deallocated.
+        * @param filename The CSV file, with the same header line the
+        constructor skips.
+        * @return Counts of each kind of change.
+        * @post Dishes that were not loaded from a file (added through
+        newOrder()) are not touched.
+        */
+        ReloadStats reload(const std::string& filename);
         bool newOrder(Dish* new_dish);
         bool serveDish(Dish* dish_to_remove);
         int getPrepTimeSum() const;
@@ -56,15 +152,128 @@ class Kitchen : public ArrayBag<Dish*> {
         */
         void displayMenu() const;
         /**
+        * Attaches a write-ahead journal. From then on every accepted
+        newOrder(), every serveDish() (including releases) and every
+        dietaryAdjustment() is logged to it.
+        * @param journal The journal, or nullptr to stop logging. The kitchen
+        does not own it.
+        */
+        void attachJournal(OrderJournal* journal);
+        /**
+        * @return The attached journal, or nullptr.
+        */
+        OrderJournal* getJournal() const;
+        /**
+        * @return The cuisine, dish type, prep time and price indexes,
+        kept current by newOrder() and serveDish().
+        */
+        const KitchenIndex& getIndex() const;
+        /**
+        * @return The ingredient posting lists, kept current by newOrder(),
+        serveDish() and dietaryAdjustment().
+        */
+        const IngredientIndex& getIngredientIndex() const;
+        /**
+        * @return The name trie for exact, prefix and fuzzy lookups, kept
+        current by newOrder() and serveDish().
+        */
+        const NameIndex& getNameIndex() const;
+        /**
+        * Starts or stops keeping streaming quantile sketches of prep time
+        and price. While enabled, newOrder() and serveDish() update them,
+        so an approximate percentile costs no pass over the dishes; for
+        exact ones see KitchenStats.
+        * @param enabled True to build the sketches from the current dishes
+        and keep them current, false to drop them.
+        */
+        void trackQuantiles(const bool& enabled);
+        /**
+        * @return `dish` as it would be served under `request`, leaving the
+        dish itself unchanged. A view holds only what the request changes;
+        views are built on first use, shared by every caller with the same
+        request, and invalid once the dish changes or is served; see
+        DietaryViews.
+        */
+        DietaryViews::View dietaryView(const Dish* dish, const Dish::DietaryRequest& request) const;
+        /**
+        * @return The number of dishes that already meet every part of
+        `request`, per Dish::getCompatibility(), without adjusting any.
+        */
+        int countCompatible(const Dish::DietaryRequest& request) const;
+        /**
+        * @return The dishes that already meet every part of `request`, in
+        kitchen order.
+        */
+        std::vector<Dish*> filterCompatible(const Dish::DietaryRequest& request) const;
+        /**
+        * Re-reads every dish's compatibility mask. Call it after changing
+        dishes through their own setters; the kitchen's own operations keep
+        the masks current.
+        */
+        void refreshCompatibility();
+        /**
+        * @return The prep time sketch, or nullptr if quantiles are not
+        tracked.
+        */
+        const QuantileSketch* getPrepTimeSketch() const;
+        /**
+        * @return The price sketch, or nullptr if quantiles are not tracked.
+        */
+        const QuantileSketch* getPriceSketch() const;
+        /**
         * Destructor.
         * @post Deallocates all dynamically allocated dishes to prevent memory
         leaks. */
         ~Kitchen();
 
     private:
+        // Replay looks dishes up by their recorded position and applies updates through updateDish().
+        friend class OrderJournal;
+        // Full-scan queries, statistics and group-by iterate items_ directly.
+        friend class KitchenQuery;
+        friend class KitchenStats;
+        friend class KitchenGroupBy;
+        // Cluster totals scan each shard's items_ on its own thread.
+        friend class KitchenCluster;
+
+        /**
+        * Copies every attribute outside the operator== identity from
+        `source` to the dish at `index`, keeping the counts, indexes and
+        compatibility masks current, and journals the update.
+        * @pre `source` has the same dynamic type as the dish.
+        */
+        void updateDish(const int& index, const Dish& source);
+
         int total_prep_time_;
         int count_elaborate_;
-    
+        OrderJournal* journal_;
+        // The CSV row each file-loaded dish came from, so reload() can skip rows that did not change.
+        std::unordered_map<Dish*, std::string> source_rows_;
+        ParseReport load_report_;
+        KitchenIndex index_;
+        IngredientIndex ingredient_index_;
+        NameIndex name_index_;
+        // Views are a cache, so building one does not change the kitchen.
+        mutable DietaryViews dietary_views_;
+        // Dish::getCompatibility() of items_[i] at position i, so filters scan bytes instead of dishes.
+        std::vector<uint8_t> compatibility_;
+        /**
+        * @struct Summary
+        * @brief The fields of items_[i] that KitchenGroupBy aggregates, kept
+        at position i like compatibility_ so a scan reads them without
+        touching the dish or the indexes.
+        */
+        struct Summary {
+            int prep_time;
+            double price;
+            Dish::CuisineType cuisine;
+            KitchenIndex::DishType type;
+        };
+        std::vector<Summary> summaries_;
+        bool track_quantiles_;
+        QuantileSketch prep_sketch_;
+        QuantileSketch price_sketch_;
+
 };
 
 #endif // KITCHEN_HPP
\ No newline at end of file
@@ -0,0 +1,291 @@
+/**
+ * @file KitchenCluster.cpp
+ * @brief This file contains the implementation of the KitchenCluster class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenCluster.hpp"
+#include "DishCodec.hpp"
+#include "KitchenQuery.hpp"
+#include "MenuReader.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <thread>
+#include <typeinfo>
+
+void KitchenCluster::Totals::merge(const Totals& other) {
+    dishes += other.dishes;
+    prep_time_sum += other.prep_time_sum;
+    elaborate += other.elaborate;
+    for (int c = 0; c <= Dish::OTHER; c++) {
+        cuisines[c] += other.cuisines[c];
+    }
+}
+
+/**
+ * @param shards The number of Kitchen shards, at least 1.
+ * @param partition How dishes are assigned to shards.
+ * @param threads The most threads to run shards on at once; 0 picks the hardware concurrency.
+ */
+KitchenCluster::KitchenCluster(const int& shards, const Partition& partition, const unsigned& threads)
+    : partition_(partition), threads_(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads) {
+    for (int s = 0; s < std::max(shards, 1); s++) {
+        shards_.emplace_back(new Kitchen());
+    }
+}
+
+int KitchenCluster::getShardCount() const {
+    return static_cast<int>(shards_.size());
+}
+
+/**
+ * @return The most dishes the cluster can hold: SHARD_CAPACITY per shard.
+ */
+int KitchenCluster::getCapacity() const {
+    return SHARD_CAPACITY * getShardCount();
+}
+
+Kitchen& KitchenCluster::getShard(const int& shard) {
+    return *shards_[shard];
+}
+
+const Kitchen& KitchenCluster::getShard(const int& shard) const {
+    return *shards_[shard];
+}
+
+/**
+ * @param location The location the dish is ordered for; only BY_LOCATION uses it.
+ * @return The shard `dish` belongs to.
+ */
+int KitchenCluster::shardOf(const Dish& dish, const int& location) const {
+    size_t key;
+    switch (partition_) {
+        case BY_CUISINE:
+            key = static_cast<size_t>(DishCodec::cuisineOf(dish));
+            break;
+        case BY_LOCATION:
+            key = static_cast<size_t>(location < 0 ? -static_cast<int64_t>(location) : location);
+            break;
+        default:
+            key = std::hash<std::string>()(dish.getName());
+            break;
+    }
+    return static_cast<int>(key % shards_.size());
+}
+
+/**
+ * Adds `dish` to its shard, which then owns it.
+ * @param location The location the dish is ordered for; only BY_LOCATION uses it.
+ * @return False if the shard already holds an equal dish or has no space; the caller keeps it then.
+ */
+bool KitchenCluster::newOrder(Dish* dish, const int& location) {
+    Kitchen& shard = *shards_[shardOf(*dish, location)];
+    return !holdsEqual(shard, *dish) && shard.newOrder(dish);
+}
+
+/**
+ * Reads a menu CSV, as the Kitchen constructor does, into the shards.
+ * @param location The location every dish of the file is ordered for.
+ * @return How many dishes the shards accepted, and how many rows were rejected or dropped.
+ */
+KitchenCluster::LoadReport KitchenCluster::loadFile(const std::string& filename, const int& location) {
+    MenuReader reader(filename, MenuReader::DEFAULT_BUFFER_SIZE, true);
+    LoadReport report;
+    while (Dish* dish = reader.nextDish()) {
+        Kitchen& shard = *shards_[shardOf(*dish, location)];
+        if (holdsEqual(shard, *dish)) {
+            report.duplicates++;
+        } else if (shard.newOrder(dish)) {
+            report.accepted++;
+            continue;
+        } else {
+            report.over_capacity++;
+        }
+        delete dish;
+    }
+    report.rejected = reader.getSkippedRows();
+    return report;
+}
+
+int KitchenCluster::getCurrentSize() const {
+    int size = 0;
+    for (const std::unique_ptr<Kitchen>& shard : shards_) {
+        size += shard->getCurrentSize();
+    }
+    return size;
+}
+
+/**
+ * Scans every shard in parallel and adds up the results.
+ * @return The totals over every dish of the cluster.
+ */
+KitchenCluster::Totals KitchenCluster::summarize() const {
+    KITCHEN_TIME_SCOPE("cluster.summarize.ns");
+    std::vector<Totals> partials(shards_.size());
+    forEachShard([&](int shard) { partials[shard] = totalsOf(*shards_[shard]); });
+    // Merged in shard order, so the result does not depend on which thread finished first.
+    Totals totals;
+    for (const Totals& partial : partials) {
+        totals.merge(partial);
+    }
+    return totals;
+}
+
+/**
+ * @param cuisine_type A cuisine name, e.g. "ITALIAN".
+ * @return The number of dishes of that cuisine on every shard.
+ */
+int KitchenCluster::tallyCuisineTypes(const std::string& cuisine_type) const {
+    // Each shard answers from its cuisine index without visiting a dish, so there is nothing to parallelize.
+    int count = 0;
+    for (const std::unique_ptr<Kitchen>& shard : shards_) {
+        count += shard->tallyCuisineTypes(cuisine_type);
+    }
+    return count;
+}
+
+/**
+ * @return The average prep time of every dish, rounded as Kitchen::calculateAvgPrepTime().
+ */
+int KitchenCluster::calculateAvgPrepTime() const {
+    Totals totals = summarize();
+    if (totals.dishes == 0) {
+        return 0;
+    }
+    return static_cast<int>(std::round(static_cast<double>(totals.prep_time_sum) / totals.dishes));
+}
+
+/**
+ * @return The percentage of elaborate dishes among every dish, rounded as
+ * Kitchen::calculateElaboratePercentage().
+ */
+double KitchenCluster::calculateElaboratePercentage() const {
+    Totals totals = summarize();
+    if (totals.dishes == 0) {
+        return 0;
+    }
+    return std::round(static_cast<double>(totals.elaborate) / static_cast<double>(totals.dishes) * 10000) / 100;
+}
+
+/**
+ * Releases, on every shard in parallel, the dishes Kitchen::releaseDishesBelowPrepTime() would, and
+ * deallocates them.
+ * @return The total number released.
+ */
+int KitchenCluster::releaseDishesBelowPrepTime(const int& prep_time) {
+    if (prep_time == INT_MIN) {
+        return 0;
+    }
+    std::vector<int> released(shards_.size());
+    forEachShard([&](int shard) {
+        released[shard] = release(*shards_[shard], KitchenQuery(*shards_[shard]).prepTime(INT_MIN, prep_time - 1));
+    });
+    int total = 0;
+    for (int count : released) {
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * Releases, on every shard in parallel, the dishes Kitchen::releaseDishesOfCuisineType() would, and
+ * deallocates them. Under BY_CUISINE only the shard holding the cuisine has any to release.
+ * @return The total number released.
+ */
+int KitchenCluster::releaseDishesOfCuisineType(const std::string& cuisine_type) {
+    int cuisine = KitchenIndex::cuisineFromName(cuisine_type);
+    if (cuisine < 0) {
+        return 0;
+    }
+    std::vector<int> released(shards_.size());
+    forEachShard([&](int shard) {
+        KitchenQuery query(*shards_[shard]);
+        released[shard] = release(*shards_[shard], query.cuisine(static_cast<Dish::CuisineType>(cuisine)));
+    });
+    int total = 0;
+    for (int count : released) {
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * Calls `work(shard)` once for every shard, spread over up to threads_ threads, and returns once every call
+ * has.
+ */
+void KitchenCluster::forEachShard(const std::function<void(int)>& work) const {
+    int shard_count = static_cast<int>(shards_.size());
+    int parts = std::min(static_cast<int>(threads_), shard_count);
+    parts = std::max(1, std::min(parts, getCurrentSize() / MIN_DISHES_PER_THREAD));
+    // Shards can differ a lot in size, so threads take the next unclaimed shard rather than a fixed share.
+    std::atomic<int> next(0);
+    auto drain = [&]() {
+        for (int shard = next++; shard < shard_count; shard = next++) {
+            work(shard);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int p = 1; p < parts; p++) {
+        workers.emplace_back(drain);
+    }
+    drain();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    KITCHEN_COUNTER_ADD("cluster.parallel_parts", parts);
+}
+
+/**
+ * Kitchen's release functions leave the dishes they serve to the caller, who cannot find them afterwards, so
+ * the dishes `query` matches are collected first and then served and deallocated, as OrderServer does.
+ * @return The number released.
+ */
+int KitchenCluster::release(Kitchen& shard, const KitchenQuery& query) {
+    std::vector<Dish*> dishes;
+    for (Dish* dish : query.run()) {
+        dishes.push_back(dish);
+    }
+    int released = 0;
+    for (Dish* dish : dishes) {
+        if (shard.serveDish(dish)) {
+            delete dish;
+            released++;
+        }
+    }
+    return released;
+}
+
+/**
+ * Kitchen::newOrder() only refuses the same pointer twice, so equal dishes are found by name through the
+ * shard's NameIndex and compared with Dish::operator== and their subclass, as reload() matches them.
+ * @return True if `shard` holds a dish equal to `dish`.
+ */
+bool KitchenCluster::holdsEqual(const Kitchen& shard, const Dish& dish) {
+    for (const Dish* held : shard.getNameIndex().exact(dish.getName())) {
+        if (*held == dish && typeid(*held) == typeid(dish)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @return The totals of one shard, from a scan of its dishes.
+ */
+KitchenCluster::Totals KitchenCluster::totalsOf(const Kitchen& kitchen) {
+    Totals totals;
+    for (int i = 0; i < kitchen.getCurrentSize(); i++) {
+        const Dish* dish = kitchen.items_[i];
+        int prep_time = dish->getPrepTime();
+        totals.prep_time_sum += prep_time;
+        totals.elaborate += dish->getIngredientList().size() >= 5 && prep_time >= 60;
+        totals.cuisines[DishCodec::cuisineOf(*dish)]++;
+    }
+    totals.dishes = kitchen.getCurrentSize();
+    return totals;
+}
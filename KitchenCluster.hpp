@@ -0,0 +1,185 @@
+/**
+ * @file KitchenCluster.hpp
+ * @brief This file contains the declaration of the KitchenCluster class, which spreads the dishes of many
+ * locations across several Kitchen shards and answers chain-wide questions over all of them.
+ *
+ * Every dish goes to one shard, chosen by its cuisine, by the location it is ordered for, or by a hash of its
+ * name. A dish equal to one its shard already holds, by Dish::operator== and subclass, is refused. Cuisine and
+ * name partitioning send equal dishes to the same shard, so that check is also a cluster-wide one; location
+ * partitioning keeps the same dish once per location instead.
+ *
+ * Chain-wide statistics are computed shard by shard, in parallel, into partial sums and counts that are then
+ * added together, so the average prep time and elaborate percentage are exactly those of one kitchen holding
+ * every dish, never an average of per-shard averages. The release operations likewise run on every shard at
+ * once, and deallocate the dishes they release. Shards share no state, so each thread works on its own Kitchen
+ * without locking; threads are only started when there are enough dishes to be worth one.
+ *
+ * Each shard is a Kitchen, so it holds at most SHARD_CAPACITY (Kitchen::DEFAULT_CAPACITY) dishes and the cluster
+ * at most getCapacity(). With the project's ArrayBag that is 100 dishes per shard, too few to ever reach
+ * MIN_DISHES_PER_THREAD, so every operation runs on the calling thread. Dishes past a full shard are rejected,
+ * and loadFile() reports how many.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_CLUSTER_HPP
+#define KITCHEN_CLUSTER_HPP
+
+#include "Kitchen.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class KitchenQuery;
+
+class KitchenCluster {
+    public:
+        static const int SHARD_CAPACITY = Kitchen::DEFAULT_CAPACITY;
+        // Below this many dishes per thread, starting the thread costs more than the scan it would take over.
+        static const int MIN_DISHES_PER_THREAD = 16384;
+
+        /**
+         * @enum Partition
+         * @brief How a dish's shard is chosen.
+         */
+        enum Partition {
+            BY_CUISINE,     ///< The cuisine's position in Dish::CuisineType, modulo the shard count.
+            BY_LOCATION,    ///< The location passed to newOrder(), modulo the shard count.
+            BY_HASH         ///< A hash of the dish's name, modulo the shard count.
+        };
+
+        /**
+         * @struct Totals
+         * @brief Sums and counts over some dishes, which merge exactly by addition.
+         */
+        struct Totals {
+            int64_t dishes = 0;
+            int64_t prep_time_sum = 0;
+            int64_t elaborate = 0;
+            int64_t cuisines[Dish::OTHER + 1] = {};   ///< Dishes per Dish::CuisineType.
+
+            void merge(const Totals& other);
+        };
+
+        /**
+         * @struct LoadReport
+         * @brief What loadFile() read, accepted and dropped.
+         */
+        struct LoadReport {
+            int accepted = 0;
+            uint64_t rejected = 0;          ///< Rows that could not be parsed into a dish.
+            int duplicates = 0;             ///< Dishes equal to one their shard already held.
+            int over_capacity = 0;          ///< Dishes dropped because their shard was full.
+        };
+
+        /**
+         * @param shards The number of Kitchen shards, at least 1.
+         * @param partition How dishes are assigned to shards.
+         * @param threads The most threads to run shards on at once; 0 picks the hardware concurrency.
+         */
+        KitchenCluster(const int& shards, const Partition& partition, const unsigned& threads = 0);
+
+        KitchenCluster(const KitchenCluster&) = delete;
+        KitchenCluster& operator=(const KitchenCluster&) = delete;
+
+        int getShardCount() const;
+
+        /**
+         * @return The most dishes the cluster can hold: SHARD_CAPACITY per shard.
+         */
+        int getCapacity() const;
+
+        Kitchen& getShard(const int& shard);
+        const Kitchen& getShard(const int& shard) const;
+
+        /**
+         * @param location The location the dish is ordered for; only BY_LOCATION uses it.
+         * @return The shard `dish` belongs to.
+         */
+        int shardOf(const Dish& dish, const int& location = 0) const;
+
+        /**
+         * Adds `dish` to its shard, which then owns it.
+         * @param location The location the dish is ordered for; only BY_LOCATION uses it.
+         * @return False if the shard already holds an equal dish or has no space; the caller keeps it then.
+         */
+        bool newOrder(Dish* dish, const int& location = 0);
+
+        /**
+         * Reads a menu CSV, as the Kitchen constructor does, into the shards.
+         * @param location The location every dish of the file is ordered for.
+         * @return How many dishes the shards accepted, and how many rows were rejected or dropped.
+         */
+        LoadReport loadFile(const std::string& filename, const int& location = 0);
+
+        int getCurrentSize() const;
+
+        /**
+         * Scans every shard in parallel and adds up the results.
+         * @return The totals over every dish of the cluster.
+         */
+        Totals summarize() const;
+
+        /**
+         * @param cuisine_type A cuisine name, e.g. "ITALIAN".
+         * @return The number of dishes of that cuisine on every shard.
+         */
+        int tallyCuisineTypes(const std::string& cuisine_type) const;
+
+        /**
+         * @return The average prep time of every dish, rounded as Kitchen::calculateAvgPrepTime().
+         */
+        int calculateAvgPrepTime() const;
+
+        /**
+         * @return The percentage of elaborate dishes among every dish, rounded as
+         * Kitchen::calculateElaboratePercentage().
+         */
+        double calculateElaboratePercentage() const;
+
+        /**
+         * Releases, on every shard in parallel, the dishes Kitchen::releaseDishesBelowPrepTime() would, and
+         * deallocates them.
+         * @return The total number released.
+         */
+        int releaseDishesBelowPrepTime(const int& prep_time);
+
+        /**
+         * Releases, on every shard in parallel, the dishes Kitchen::releaseDishesOfCuisineType() would, and
+         * deallocates them. Under BY_CUISINE only the shard holding the cuisine has any to release.
+         * @return The total number released.
+         */
+        int releaseDishesOfCuisineType(const std::string& cuisine_type);
+
+    private:
+        /**
+         * Calls `work(shard)` once for every shard, spread over up to threads_ threads, and returns once every
+         * call has.
+         */
+        void forEachShard(const std::function<void(int)>& work) const;
+
+        /**
+         * Serves every dish `query` matches on `shard` and deallocates it.
+         * @return The number released.
+         */
+        static int release(Kitchen& shard, const KitchenQuery& query);
+
+        /**
+         * @return True if `shard` holds a dish equal to `dish`, by Dish::operator== and subclass.
+         */
+        static bool holdsEqual(const Kitchen& shard, const Dish& dish);
+
+        /**
+         * @return The totals of one shard, from a scan of its dishes.
+         */
+        static Totals totalsOf(const Kitchen& kitchen);
+
+        Partition partition_;
+        unsigned threads_;
+        std::vector<std::unique_ptr<Kitchen>> shards_;
+};
+
+#endif // KITCHEN_CLUSTER_HPP
@@ -0,0 +1,296 @@
+/**
+ * @file KitchenGroupBy.cpp
+ * @brief This file contains the implementation of the KitchenGroupBy class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenGroupBy.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+
+namespace {
+    const char* const DIMENSION_NAMES[] = {"CUISINE", "DISH_TYPE", "SERVING_STYLE", "COOKING_METHOD", "FLAVOR_PROFILE"};
+    const char* const CUISINE_NAMES[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"};
+    const char* const DISH_TYPE_NAMES[] = {"APPETIZER", "MAINCOURSE", "DESSERT"};
+    const char* const SERVING_STYLE_NAMES[] = {"PLATED", "FAMILY_STYLE", "BUFFET"};
+    const char* const COOKING_METHOD_NAMES[] = {"GRILLED", "BAKED", "BOILED", "FRIED", "STEAMED", "RAW"};
+    const char* const FLAVOR_PROFILE_NAMES[] = {"SWEET", "BITTER", "SOUR", "SALTY", "UMAMI"};
+    // The value counts of each dimension, not counting NOT_APPLICABLE.
+    const int VALUE_COUNTS[] = {KitchenIndex::CUISINE_COUNT, KitchenIndex::DISH_TYPE_COUNT, 3, 6, 5};
+    // Below this many dishes per thread, starting a thread costs more than it saves.
+    const int MIN_DISHES_PER_THREAD = 16384;
+
+    bool isSubclassDimension(const KitchenGroupBy::Dimension& dimension) {
+        return dimension >= KitchenGroupBy::SERVING_STYLE;
+    }
+
+    /**
+     * @return The value of `dimension` for `dish`, in [0, cardinality); NOT_APPLICABLE is the last value.
+     */
+    int slotOf(const KitchenGroupBy::Dimension& dimension, const Dish* dish, const Dish::CuisineType& cuisine,
+               const KitchenIndex::DishType& type) {
+        switch (dimension) {
+            case KitchenGroupBy::CUISINE:
+                return cuisine;
+            case KitchenGroupBy::DISH_TYPE:
+                return type;
+            case KitchenGroupBy::SERVING_STYLE:
+                return type == KitchenIndex::APPETIZER
+                       ? static_cast<const Appetizer*>(dish)->getServingStyle() : VALUE_COUNTS[dimension];
+            case KitchenGroupBy::COOKING_METHOD:
+                return type == KitchenIndex::MAINCOURSE
+                       ? static_cast<const MainCourse*>(dish)->getCookingMethod() : VALUE_COUNTS[dimension];
+            default:
+                return type == KitchenIndex::DESSERT
+                       ? static_cast<const Dessert*>(dish)->getFlavorProfile() : VALUE_COUNTS[dimension];
+        }
+    }
+}
+
+void KitchenGroupBy::Aggregate::add(const int& prep_time, const double& price) {
+    if (count == 0) {
+        prep_time_min = prep_time_max = prep_time;
+        price_min = price_max = price;
+    } else {
+        prep_time_min = std::min(prep_time_min, prep_time);
+        prep_time_max = std::max(prep_time_max, prep_time);
+        price_min = std::min(price_min, price);
+        price_max = std::max(price_max, price);
+    }
+    count++;
+    prep_time_sum += prep_time;
+    price_sum += price;
+}
+
+void KitchenGroupBy::Aggregate::merge(const Aggregate& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    count += other.count;
+    prep_time_sum += other.prep_time_sum;
+    prep_time_min = std::min(prep_time_min, other.prep_time_min);
+    prep_time_max = std::max(prep_time_max, other.prep_time_max);
+    price_sum += other.price_sum;
+    price_min = std::min(price_min, other.price_min);
+    price_max = std::max(price_max, other.price_max);
+}
+
+double KitchenGroupBy::Aggregate::averagePrepTime() const {
+    return count == 0 ? 0 : static_cast<double>(prep_time_sum) / count;
+}
+
+double KitchenGroupBy::Aggregate::averagePrice() const {
+    return count == 0 ? 0 : price_sum / count;
+}
+
+const std::vector<KitchenGroupBy::Dimension>& KitchenGroupBy::Result::getDimensions() const {
+    return dimensions_;
+}
+
+/**
+ * @param key One value per dimension, in the order the dimensions were added.
+ * @return The group with those values.
+ */
+const KitchenGroupBy::Aggregate& KitchenGroupBy::Result::at(const std::vector<int>& key) const {
+    size_t index = 0;
+    for (size_t d = 0; d < dimensions_.size(); d++) {
+        int slot = key[d] == NOT_APPLICABLE ? VALUE_COUNTS[dimensions_[d]] : key[d];
+        index += slot * strides_[d];
+    }
+    return cells_[index];
+}
+
+size_t KitchenGroupBy::Result::cellCount() const {
+    return cells_.size();
+}
+
+const KitchenGroupBy::Aggregate& KitchenGroupBy::Result::cell(const size_t& index) const {
+    return cells_[index];
+}
+
+/**
+ * @return The dimension values of cell `index`, in the order the dimensions were added.
+ */
+std::vector<int> KitchenGroupBy::Result::keyOf(const size_t& index) const {
+    std::vector<int> key(dimensions_.size());
+    for (size_t d = 0; d < dimensions_.size(); d++) {
+        int slot = static_cast<int>(index / strides_[d] % cardinality(dimensions_[d]));
+        key[d] = isSubclassDimension(dimensions_[d]) && slot == VALUE_COUNTS[dimensions_[d]] ? NOT_APPLICABLE : slot;
+    }
+    return key;
+}
+
+/**
+ * @return The statistics of every dish, whatever its group.
+ */
+KitchenGroupBy::Aggregate KitchenGroupBy::Result::total() const {
+    Aggregate total;
+    for (const Aggregate& cell : cells_) {
+        total.merge(cell);
+    }
+    return total;
+}
+
+/**
+ * Prints one line per non-empty group, with its dimension values and statistics.
+ */
+void KitchenGroupBy::Result::print(std::ostream& out) const {
+    for (Dimension dimension : dimensions_) {
+        out << std::left << std::setw(16) << dimensionName(dimension);
+    }
+    out << std::right << std::setw(8) << "COUNT" << std::setw(10) << "AVG PREP" << std::setw(6) << "MIN"
+        << std::setw(6) << "MAX" << std::setw(11) << "AVG PRICE" << std::setw(9) << "MIN" << std::setw(9) << "MAX"
+        << std::endl;
+    for (size_t i = 0; i < cells_.size(); i++) {
+        const Aggregate& group = cells_[i];
+        if (group.count == 0) {
+            continue;
+        }
+        std::vector<int> key = keyOf(i);
+        for (size_t d = 0; d < dimensions_.size(); d++) {
+            out << std::left << std::setw(16) << valueName(dimensions_[d], key[d]);
+        }
+        out << std::right << std::setw(8) << group.count << std::fixed << std::setprecision(1) << std::setw(10)
+            << group.averagePrepTime() << std::setw(6) << group.prep_time_min << std::setw(6) << group.prep_time_max
+            << std::setprecision(2) << std::setw(11) << group.averagePrice() << std::setw(9) << group.price_min
+            << std::setw(9) << group.price_max << std::defaultfloat << std::endl;
+    }
+}
+
+KitchenGroupBy::KitchenGroupBy(const Kitchen& kitchen) : kitchen_(kitchen) {}
+
+/**
+ * Adds a grouping dimension. Adding one twice has no further effect.
+ */
+KitchenGroupBy& KitchenGroupBy::by(const Dimension& dimension) {
+    if (std::find(dimensions_.begin(), dimensions_.end(), dimension) == dimensions_.end()) {
+        dimensions_.push_back(dimension);
+    }
+    return *this;
+}
+
+/**
+ * @return The groups, computed in one pass on the calling thread.
+ */
+KitchenGroupBy::Result KitchenGroupBy::run() const {
+    return run(1);
+}
+
+/**
+ * @param threads The number of threads to split the kitchen across; 0 picks the hardware concurrency. Ranges
+ * are kept large enough that a thread is only started when it has real work.
+ * @return The same groups as run().
+ */
+KitchenGroupBy::Result KitchenGroupBy::run(const unsigned& threads) const {
+    KITCHEN_TIME_SCOPE("groupBy.run.ns");
+    Result result = layout();
+    int size = kitchen_.getCurrentSize();
+    int parts = threads == 0 ? static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))
+                             : static_cast<int>(threads);
+    parts = std::max(1, std::min(parts, size / MIN_DISHES_PER_THREAD));
+    if (parts == 1) {
+        aggregate(result, result.cells_, 0, size);
+        return result;
+    }
+    // Each part aggregates into its own cells, so the threads share nothing but read-only kitchen state; the
+    // calling thread takes the first part itself.
+    std::vector<std::vector<Aggregate>> partials(parts - 1, std::vector<Aggregate>(result.cells_.size()));
+    std::vector<std::thread> workers;
+    for (int p = 1; p < parts; p++) {
+        workers.emplace_back([this, &result, &partials, p, parts, size]() {
+            aggregate(result, partials[p - 1], static_cast<int>(static_cast<int64_t>(size) * p / parts),
+                      static_cast<int>(static_cast<int64_t>(size) * (p + 1) / parts));
+        });
+    }
+    aggregate(result, result.cells_, 0, size / parts);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::vector<Aggregate>& partial : partials) {
+        for (size_t i = 0; i < partial.size(); i++) {
+            result.cells_[i].merge(partial[i]);
+        }
+    }
+    KITCHEN_COUNTER_ADD("groupBy.parallel_parts", parts);
+    return result;
+}
+
+/**
+ * @return The number of values `dimension` has, counting NOT_APPLICABLE as one.
+ */
+int KitchenGroupBy::cardinality(const Dimension& dimension) {
+    return VALUE_COUNTS[dimension] + (isSubclassDimension(dimension) ? 1 : 0);
+}
+
+/**
+ * @return The name of dimension `dimension`, e.g. "COOKING_METHOD".
+ */
+const char* KitchenGroupBy::dimensionName(const Dimension& dimension) {
+    return DIMENSION_NAMES[dimension];
+}
+
+/**
+ * @return The name of `value` of `dimension`, e.g. "GRILLED", or "-" for NOT_APPLICABLE.
+ */
+const char* KitchenGroupBy::valueName(const Dimension& dimension, const int& value) {
+    if (value < 0 || value >= VALUE_COUNTS[dimension]) {
+        return "-";
+    }
+    switch (dimension) {
+        case CUISINE:
+            return CUISINE_NAMES[value];
+        case DISH_TYPE:
+            return DISH_TYPE_NAMES[value];
+        case SERVING_STYLE:
+            return SERVING_STYLE_NAMES[value];
+        case COOKING_METHOD:
+            return COOKING_METHOD_NAMES[value];
+        default:
+            return FLAVOR_PROFILE_NAMES[value];
+    }
+}
+
+/**
+ * @return An empty result with the cells laid out for the chosen dimensions.
+ */
+KitchenGroupBy::Result KitchenGroupBy::layout() const {
+    Result result;
+    result.dimensions_ = dimensions_;
+    result.strides_.resize(dimensions_.size());
+    size_t cells = 1;
+    for (size_t d = dimensions_.size(); d-- > 0;) {
+        result.strides_[d] = cells;
+        cells *= cardinality(dimensions_[d]);
+    }
+    result.cells_.resize(cells);
+    return result;
+}
+
+/**
+ * Adds dishes [first, last) of the kitchen into `cells`, laid out as in `result`.
+ */
+void KitchenGroupBy::aggregate(const Result& result, std::vector<Aggregate>& cells, const int& first,
+                               const int& last) const {
+    for (int i = first; i < last; i++) {
+        const Dish* dish = kitchen_.items_[i];
+        // The kitchen's summary column holds the cuisine as an enum and the dish's subclass at the dish's
+        // position, which saves a string conversion and a dynamic_cast per dish.
+        const Kitchen::Summary& summary = kitchen_.summaries_[i];
+        size_t cell = 0;
+        for (size_t d = 0; d < result.dimensions_.size(); d++) {
+            cell += slotOf(result.dimensions_[d], dish, summary.cuisine, summary.type) * result.strides_[d];
+        }
+        cells[cell].add(summary.prep_time, summary.price);
+    }
+}
@@ -0,0 +1,151 @@
+/**
+ * @file KitchenGroupBy.hpp
+ * @brief This file contains the declaration of the KitchenGroupBy class, a one-pass aggregation of a Kitchen's
+ * dishes over any combination of its enum attributes.
+ *
+ * Dimensions are added with chained calls, and run() returns count, sum, average, minimum and maximum of prep
+ * time and price for every combination of their values:
+ *
+ *     KitchenGroupBy(kitchen).by(KitchenGroupBy::CUISINE).by(KitchenGroupBy::COOKING_METHOD).run().print(std::cout);
+ *
+ * Every dimension has a small fixed number of values, so the groups are cells of one dense array, and a dish's
+ * cell is the mixed-radix number formed by its values: no hashing or map lookups per dish. Subclass dimensions
+ * (serving style, cooking method, flavor profile) have one extra value, NOT_APPLICABLE, for dishes of the
+ * other types.
+ *
+ * For large kitchens run(threads) splits the dishes into contiguous ranges, aggregates each range into its own
+ * array on its own thread, and adds the arrays together at the end.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_GROUP_BY_HPP
+#define KITCHEN_GROUP_BY_HPP
+
+#include "Kitchen.hpp"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class KitchenGroupBy {
+    public:
+        /**
+         * @enum Dimension
+         * @brief An attribute dishes can be grouped by.
+         */
+        enum Dimension { CUISINE, DISH_TYPE, SERVING_STYLE, COOKING_METHOD, FLAVOR_PROFILE, DIMENSION_COUNT };
+
+        /**
+         * @struct Aggregate
+         * @brief The statistics of one group. Minimums and maximums are meaningless while count is 0.
+         */
+        struct Aggregate {
+            uint64_t count = 0;
+            int64_t prep_time_sum = 0;
+            int prep_time_min = 0;
+            int prep_time_max = 0;
+            double price_sum = 0;
+            double price_min = 0;
+            double price_max = 0;
+
+            void add(const int& prep_time, const double& price);
+            void merge(const Aggregate& other);
+            double averagePrepTime() const;
+            double averagePrice() const;
+        };
+
+        /**
+         * The groups produced by run(): one Aggregate per combination of dimension values, empty or not.
+         */
+        class Result {
+            public:
+                const std::vector<Dimension>& getDimensions() const;
+
+                /**
+                 * @param key One value per dimension, in the order the dimensions were added.
+                 * @return The group with those values.
+                 */
+                const Aggregate& at(const std::vector<int>& key) const;
+
+                size_t cellCount() const;
+                const Aggregate& cell(const size_t& index) const;
+
+                /**
+                 * @return The dimension values of cell `index`, in the order the dimensions were added.
+                 */
+                std::vector<int> keyOf(const size_t& index) const;
+
+                /**
+                 * @return The statistics of every dish, whatever its group.
+                 */
+                Aggregate total() const;
+
+                /**
+                 * Prints one line per non-empty group, with its dimension values and statistics.
+                 */
+                void print(std::ostream& out) const;
+
+            private:
+                friend class KitchenGroupBy;
+                std::vector<Dimension> dimensions_;
+                // The key of cell i is i written in mixed radix, the first dimension most significant.
+                std::vector<size_t> strides_;
+                std::vector<Aggregate> cells_;
+        };
+
+        /**
+         * The value of a subclass dimension for a dish of another type.
+         */
+        static const int NOT_APPLICABLE = -1;
+
+        explicit KitchenGroupBy(const Kitchen& kitchen);
+
+        /**
+         * Adds a grouping dimension. Adding one twice has no further effect.
+         */
+        KitchenGroupBy& by(const Dimension& dimension);
+
+        /**
+         * @return The groups, computed in one pass on the calling thread.
+         */
+        Result run() const;
+
+        /**
+         * @param threads The number of threads to split the kitchen across; 0 picks the hardware concurrency.
+         * Ranges are kept large enough that a thread is only started when it has real work.
+         * @return The same groups as run().
+         */
+        Result run(const unsigned& threads) const;
+
+        /**
+         * @return The number of values `dimension` has, counting NOT_APPLICABLE as one.
+         */
+        static int cardinality(const Dimension& dimension);
+
+        /**
+         * @return The name of dimension `dimension`, e.g. "COOKING_METHOD".
+         */
+        static const char* dimensionName(const Dimension& dimension);
+
+        /**
+         * @return The name of `value` of `dimension`, e.g. "GRILLED", or "-" for NOT_APPLICABLE.
+         */
+        static const char* valueName(const Dimension& dimension, const int& value);
+
+    private:
+        /**
+         * @return An empty result with the cells laid out for the chosen dimensions.
+         */
+        Result layout() const;
+
+        /**
+         * Adds dishes [first, last) of the kitchen into `cells`, laid out as in `result`.
+         */
+        void aggregate(const Result& result, std::vector<Aggregate>& cells, const int& first, const int& last) const;
+
+        const Kitchen& kitchen_;
+        std::vector<Dimension> dimensions_;
+};
+
+#endif // KITCHEN_GROUP_BY_HPP
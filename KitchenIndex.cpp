@@ -0,0 +1,174 @@
+/**
+ * @file KitchenIndex.cpp
+ * @brief This file contains the implementation of the KitchenIndex class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenIndex.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include <cmath>
+
+namespace {
+    const char* const CUISINE_NAMES[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"};
+}
+
+/**
+ * Adds `dish` to every index.
+ * @pre The dish is not already indexed.
+ */
+void KitchenIndex::insert(Dish* dish) {
+    Entry entry;
+    int cuisine = cuisineFromName(dish->getCuisineType());
+    entry.cuisine = cuisine < 0 ? Dish::OTHER : static_cast<Dish::CuisineType>(cuisine);
+    entry.type = typeOf(dish);
+    entry.prep_time = dish->getPrepTime();
+    entry.price = dish->getPrice();
+
+    std::vector<Dish*>& cuisine_list = by_cuisine_[entry.cuisine];
+    entry.cuisine_position = cuisine_list.size();
+    cuisine_list.push_back(dish);
+    std::vector<Dish*>& type_list = by_type_[entry.type];
+    entry.type_position = type_list.size();
+    type_list.push_back(dish);
+    std::vector<Dish*>& prep_list = by_prep_[entry.prep_time];
+    entry.prep_position = prep_list.size();
+    prep_list.push_back(dish);
+    // NaN is unordered against every price, so as a key it would break the map's ordering for every other
+    // dish. No price range contains it, so leaving it out of the map loses no answer.
+    entry.price_position = 0;
+    if (!std::isnan(entry.price)) {
+        std::vector<Dish*>& price_list = by_price_[entry.price];
+        entry.price_position = price_list.size();
+        price_list.push_back(dish);
+    }
+
+    entries_.emplace(dish, entry);
+}
+
+/**
+ * Removes `dish` from every index. Does nothing if it is not indexed.
+ */
+void KitchenIndex::erase(Dish* dish) {
+    auto found = entries_.find(dish);
+    if (found == entries_.end()) {
+        return;
+    }
+    const Entry entry = found->second;
+    entries_.erase(found);
+
+    if (Dish* moved = swapRemove(by_cuisine_[entry.cuisine], entry.cuisine_position)) {
+        entries_[moved].cuisine_position = entry.cuisine_position;
+    }
+    if (Dish* moved = swapRemove(by_type_[entry.type], entry.type_position)) {
+        entries_[moved].type_position = entry.type_position;
+    }
+    auto prep_list = by_prep_.find(entry.prep_time);
+    if (Dish* moved = swapRemove(prep_list->second, entry.prep_position)) {
+        entries_[moved].prep_position = entry.prep_position;
+    }
+    if (prep_list->second.empty()) {
+        by_prep_.erase(prep_list);
+    }
+    if (!std::isnan(entry.price)) {
+        auto price_list = by_price_.find(entry.price);
+        if (Dish* moved = swapRemove(price_list->second, entry.price_position)) {
+            entries_[moved].price_position = entry.price_position;
+        }
+        if (price_list->second.empty()) {
+            by_price_.erase(price_list);
+        }
+    }
+}
+
+/**
+ * @return The index entry of `dish`, or nullptr if it is not indexed.
+ */
+const KitchenIndex::Entry* KitchenIndex::find(const Dish* dish) const {
+    auto found = entries_.find(dish);
+    return found == entries_.end() ? nullptr : &found->second;
+}
+
+size_t KitchenIndex::size() const {
+    return entries_.size();
+}
+
+const std::vector<Dish*>& KitchenIndex::byCuisine(const Dish::CuisineType& cuisine) const {
+    return by_cuisine_[cuisine];
+}
+
+const std::vector<Dish*>& KitchenIndex::byType(const DishType& type) const {
+    return by_type_[type];
+}
+
+const KitchenIndex::PrepMap& KitchenIndex::byPrepTime() const {
+    return by_prep_;
+}
+
+const KitchenIndex::PriceMap& KitchenIndex::byPrice() const {
+    return by_price_;
+}
+
+/**
+ * @return The number of dishes with min <= prep time <= max, found without visiting any dish.
+ */
+size_t KitchenIndex::countPrepTime(const int& min, const int& max) const {
+    size_t count = 0;
+    for (auto it = by_prep_.lower_bound(min); it != by_prep_.end() && it->first <= max; ++it) {
+        count += it->second.size();
+    }
+    return count;
+}
+
+/**
+ * @return The number of dishes with min <= price <= max, found without visiting any dish.
+ */
+size_t KitchenIndex::countPrice(const double& min, const double& max) const {
+    size_t count = 0;
+    for (auto it = by_price_.lower_bound(min); it != by_price_.end() && it->first <= max; ++it) {
+        count += it->second.size();
+    }
+    return count;
+}
+
+/**
+ * @return The DishType of `dish`, found with dynamic_cast.
+ */
+KitchenIndex::DishType KitchenIndex::typeOf(const Dish* dish) {
+    if (dynamic_cast<const Appetizer*>(dish) != nullptr) {
+        return APPETIZER;
+    }
+    if (dynamic_cast<const MainCourse*>(dish) != nullptr) {
+        return MAINCOURSE;
+    }
+    return DESSERT;
+}
+
+/**
+ * @return The CuisineType called `name`, or -1 if there is none.
+ */
+int KitchenIndex::cuisineFromName(const std::string& name) {
+    for (int i = 0; i < CUISINE_COUNT; i++) {
+        if (name == CUISINE_NAMES[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Removes the element at `position` from `list` by moving the last element into it.
+ * @return The moved dish, or nullptr if the removed element was last.
+ */
+Dish* KitchenIndex::swapRemove(std::vector<Dish*>& list, const size_t& position) {
+    Dish* moved = nullptr;
+    if (position + 1 < list.size()) {
+        moved = list.back();
+        list[position] = moved;
+    }
+    list.pop_back();
+    return moved;
+}
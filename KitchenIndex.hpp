@@ -0,0 +1,110 @@
+/**
+ * @file KitchenIndex.hpp
+ * @brief This file contains the declaration of the KitchenIndex class, the secondary indexes a Kitchen keeps
+ * over its dishes for KitchenQuery.
+ *
+ * Dishes are indexed by cuisine, dish type, prep time and price: the attributes that no Kitchen operation
+ * changes once a dish is in the kitchen (dietaryAdjustment() and reload() only rewrite ingredients and subclass
+ * attributes). A dish whose price is NaN is left out of the price index, which no price range would match and
+ * whose ordering NaN would break; it is in every other index. Every list supports O(1) removal by swapping the
+ * last element into the removed slot, using the positions kept in each dish's Entry.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_INDEX_HPP
+#define KITCHEN_INDEX_HPP
+
+#include "Dish.hpp"
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class KitchenIndex {
+    public:
+        static const int CUISINE_COUNT = Dish::OTHER + 1;
+
+        /**
+         * @enum DishType
+         * @brief The subclass of an indexed dish.
+         */
+        enum DishType : uint8_t { APPETIZER, MAINCOURSE, DESSERT, DISH_TYPE_COUNT };
+
+        /**
+         * @struct Entry
+         * @brief What the index knows about one dish.
+         */
+        struct Entry {
+            Dish::CuisineType cuisine;
+            DishType type;
+            int prep_time;
+            double price;
+            size_t cuisine_position;
+            size_t type_position;
+            size_t prep_position;
+            size_t price_position;
+        };
+
+        typedef std::map<int, std::vector<Dish*>> PrepMap;
+        typedef std::map<double, std::vector<Dish*>> PriceMap;
+
+        /**
+         * Adds `dish` to every index.
+         * @pre The dish is not already indexed.
+         */
+        void insert(Dish* dish);
+
+        /**
+         * Removes `dish` from every index. Does nothing if it is not indexed.
+         */
+        void erase(Dish* dish);
+
+        /**
+         * @return The index entry of `dish`, or nullptr if it is not indexed.
+         */
+        const Entry* find(const Dish* dish) const;
+
+        size_t size() const;
+
+        const std::vector<Dish*>& byCuisine(const Dish::CuisineType& cuisine) const;
+        const std::vector<Dish*>& byType(const DishType& type) const;
+        const PrepMap& byPrepTime() const;
+        const PriceMap& byPrice() const;
+
+        /**
+         * @return The number of dishes with min <= prep time <= max, found without visiting any dish.
+         */
+        size_t countPrepTime(const int& min, const int& max) const;
+
+        /**
+         * @return The number of dishes with min <= price <= max, found without visiting any dish.
+         */
+        size_t countPrice(const double& min, const double& max) const;
+
+        /**
+         * @return The DishType of `dish`, found with dynamic_cast.
+         */
+        static DishType typeOf(const Dish* dish);
+
+        /**
+         * @return The CuisineType called `name`, or -1 if there is none.
+         */
+        static int cuisineFromName(const std::string& name);
+
+    private:
+        /**
+         * Removes the element at `position` from `list` by moving the last element into it.
+         * @return The moved dish, or nullptr if the removed element was last.
+         */
+        static Dish* swapRemove(std::vector<Dish*>& list, const size_t& position);
+
+        std::unordered_map<const Dish*, Entry> entries_;
+        std::vector<Dish*> by_cuisine_[CUISINE_COUNT];
+        std::vector<Dish*> by_type_[DISH_TYPE_COUNT];
+        PrepMap by_prep_;
+        PriceMap by_price_;
+};
+
+#endif // KITCHEN_INDEX_HPP
@@ -0,0 +1,319 @@
+/**
+ * @file KitchenQuery.cpp
+ * @brief This file contains the implementation of the KitchenQuery class: source selection, predicate
+ * evaluation and the lazy result iterator.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenQuery.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include "Metrics.hpp"
+
+namespace {
+    const char* const SOURCE_NAMES[] = {"FULL_SCAN", "CUISINE_INDEX", "TYPE_INDEX", "PREP_INDEX", "PRICE_INDEX",
+                                       "INGREDIENT_INDEX"};
+}
+
+/**
+ * Moves forward to the next matching dish, refilling the current span from the index map when it runs out.
+ * Leaves current_ null at the end.
+ */
+void KitchenQuery::Iterator::settle() {
+    while (true) {
+        for (; current_ != span_end_; ++current_) {
+            if (query_->matches(*current_)) {
+                return;
+            }
+        }
+        if (prep_next_ != prep_end_) {
+            current_ = prep_next_->second.data();
+            span_end_ = current_ + prep_next_->second.size();
+            ++prep_next_;
+        } else if (price_next_ != price_end_) {
+            current_ = price_next_->second.data();
+            span_end_ = current_ + price_next_->second.size();
+            ++price_next_;
+        } else {
+            current_ = span_end_ = nullptr;
+            return;
+        }
+    }
+}
+
+KitchenQuery::KitchenQuery(const Kitchen& kitchen) : kitchen_(kitchen), index_(kitchen.getIndex()),
+    ingredient_index_(kitchen.getIngredientIndex()) {}
+
+KitchenQuery& KitchenQuery::cuisine(const Dish::CuisineType& cuisine) {
+    has_cuisine_ = true;
+    cuisine_ = cuisine;
+    return *this;
+}
+
+KitchenQuery& KitchenQuery::dishType(const KitchenIndex::DishType& type) {
+    has_type_ = true;
+    type_ = type;
+    return *this;
+}
+
+/**
+ * Keeps dishes with min <= prep time <= max; none if min > max.
+ */
+KitchenQuery& KitchenQuery::prepTime(const int& min, const int& max) {
+    has_prep_ = true;
+    prep_min_ = min;
+    prep_max_ = max;
+    return *this;
+}
+
+/**
+ * Keeps dishes with min <= price <= max; none if min > max or either bound is NaN.
+ */
+KitchenQuery& KitchenQuery::price(const double& min, const double& max) {
+    has_price_ = true;
+    price_min_ = min;
+    price_max_ = max;
+    return *this;
+}
+
+KitchenQuery& KitchenQuery::vegetarian(const bool& vegetarian) {
+    vegetarian_ = vegetarian;
+    return *this;
+}
+
+KitchenQuery& KitchenQuery::glutenFree(const bool& gluten_free) {
+    gluten_free_ = gluten_free;
+    return *this;
+}
+
+KitchenQuery& KitchenQuery::containsNuts(const bool& contains_nuts) {
+    contains_nuts_ = contains_nuts;
+    return *this;
+}
+
+KitchenQuery& KitchenQuery::spiciness(const int& min, const int& max) {
+    has_spiciness_ = true;
+    spiciness_min_ = min;
+    spiciness_max_ = max;
+    return *this;
+}
+
+KitchenQuery& KitchenQuery::sweetness(const int& min, const int& max) {
+    has_sweetness_ = true;
+    sweetness_min_ = min;
+    sweetness_max_ = max;
+    return *this;
+}
+
+/**
+ * Keeps dishes that list `ingredient`. Repeated calls require every ingredient given.
+ */
+KitchenQuery& KitchenQuery::ingredient(const std::string& ingredient) {
+    ingredients_.push_back(ingredient);
+    return *this;
+}
+
+/**
+ * @return The source run() and count() will read candidates from.
+ */
+KitchenQuery::Source KitchenQuery::plan() const {
+    Source best = FULL_SCAN;
+    size_t best_count = candidateCount(FULL_SCAN);
+    const Source options[] = {CUISINE_INDEX, TYPE_INDEX, PREP_INDEX, PRICE_INDEX, INGREDIENT_INDEX};
+    const bool usable[] = {has_cuisine_, has_type_, has_prep_, has_price_, !ingredients_.empty()};
+    for (int i = 0; i < 5; i++) {
+        if (usable[i]) {
+            size_t count = candidateCount(options[i]);
+            if (count < best_count) {
+                best = options[i];
+                best_count = count;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @return A short description of plan() for logging, e.g. "PREP_INDEX (12 candidates)".
+ */
+std::string KitchenQuery::explain() const {
+    Source source = plan();
+    return std::string(SOURCE_NAMES[source]) + " (" + std::to_string(candidateCount(source)) + " candidates)";
+}
+
+/**
+ * @return True if `dish` satisfies every predicate.
+ * @pre `dish` is in the kitchen.
+ */
+bool KitchenQuery::matches(const Dish* dish) const {
+    const KitchenIndex::Entry* entry = index_.find(dish);
+    if (entry == nullptr) {
+        return false;
+    }
+    if ((has_cuisine_ && entry->cuisine != cuisine_) || (has_type_ && entry->type != type_)
+        || (has_prep_ && (entry->prep_time < prep_min_ || entry->prep_time > prep_max_))
+        || (has_price_ && !(entry->price >= price_min_ && entry->price <= price_max_))) {
+        return false;
+    }
+    // The index recorded the subclass, so the casts below are checked once rather than per predicate.
+    if (vegetarian_ >= 0 || has_spiciness_) {
+        if (entry->type != KitchenIndex::APPETIZER) {
+            return false;
+        }
+        const Appetizer* appetizer = static_cast<const Appetizer*>(dish);
+        if ((vegetarian_ >= 0 && appetizer->isVegetarian() != (vegetarian_ == 1))
+            || (has_spiciness_ && (appetizer->getSpicinessLevel() < spiciness_min_
+                                   || appetizer->getSpicinessLevel() > spiciness_max_))) {
+            return false;
+        }
+    }
+    if (gluten_free_ >= 0) {
+        if (entry->type != KitchenIndex::MAINCOURSE
+            || static_cast<const MainCourse*>(dish)->isGlutenFree() != (gluten_free_ == 1)) {
+            return false;
+        }
+    }
+    if (contains_nuts_ >= 0 || has_sweetness_) {
+        if (entry->type != KitchenIndex::DESSERT) {
+            return false;
+        }
+        const Dessert* dessert = static_cast<const Dessert*>(dish);
+        if ((contains_nuts_ >= 0 && dessert->containsNuts() != (contains_nuts_ == 1))
+            || (has_sweetness_ && (dessert->getSweetnessLevel() < sweetness_min_
+                                   || dessert->getSweetnessLevel() > sweetness_max_))) {
+            return false;
+        }
+    }
+    // A binary search of each posting list, instead of copying the dish's ingredients.
+    for (const std::string& ingredient : ingredients_) {
+        if (!ingredient_index_.contains(ingredient, dish)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @return The matching dishes, produced lazily in index order. The range holds its own copy of the predicates, so
+ * it may outlive this query, as in `for (Dish* d : KitchenQuery(k).price(2, 3).run())`. It is invalidated by any
+ * change to the kitchen.
+ */
+KitchenQuery::Range KitchenQuery::run() const {
+    KITCHEN_COUNTER_ADD("query.run", 1);
+    return Range(*this);
+}
+
+/**
+ * @return An iterator at the first matching dish, reading this query's predicates.
+ */
+KitchenQuery::Iterator KitchenQuery::first() const {
+    Iterator it;
+    it.query_ = this;
+    it.prep_next_ = it.prep_end_ = index_.byPrepTime().end();
+    it.price_next_ = it.price_end_ = index_.byPrice().end();
+    switch (plan()) {
+        case FULL_SCAN:
+            it.current_ = kitchen_.items_;
+            it.span_end_ = kitchen_.items_ + kitchen_.getCurrentSize();
+            break;
+        case CUISINE_INDEX:
+            it.current_ = index_.byCuisine(cuisine_).data();
+            it.span_end_ = it.current_ + index_.byCuisine(cuisine_).size();
+            break;
+        case TYPE_INDEX:
+            it.current_ = index_.byType(type_).data();
+            it.span_end_ = it.current_ + index_.byType(type_).size();
+            break;
+        case PREP_INDEX:
+            // A reversed range matches nothing, and its upper bound would lie before its lower bound.
+            if (prep_min_ <= prep_max_) {
+                it.prep_next_ = index_.byPrepTime().lower_bound(prep_min_);
+                it.prep_end_ = index_.byPrepTime().upper_bound(prep_max_);
+            }
+            break;
+        case PRICE_INDEX:
+            // As above; the comparison is also false for a NaN bound, which matches nothing either.
+            if (price_min_ <= price_max_) {
+                it.price_next_ = index_.byPrice().lower_bound(price_min_);
+                it.price_end_ = index_.byPrice().upper_bound(price_max_);
+            }
+            break;
+        case INGREDIENT_INDEX:
+            it.current_ = rarestIngredient().data();
+            it.span_end_ = it.current_ + rarestIngredient().size();
+            break;
+    }
+    it.settle();
+    return it;
+}
+
+/**
+ * @return The number of matching dishes. No dish is copied, and none is visited if the chosen index answers
+ * the whole query.
+ */
+size_t KitchenQuery::count() const {
+    KITCHEN_COUNTER_ADD("query.count", 1);
+    Source source = plan();
+    if (coveredBy(source)) {
+        KITCHEN_COUNTER_ADD("query.count.index_only", 1);
+        return candidateCount(source);
+    }
+    // Iterated in place rather than through run(), which would copy the predicates.
+    size_t matched = 0;
+    for (Iterator it = first(); it != Iterator(); ++it) {
+        matched++;
+    }
+    return matched;
+}
+
+/**
+ * @return The number of candidates `source` would produce.
+ */
+size_t KitchenQuery::candidateCount(const Source& source) const {
+    switch (source) {
+        case CUISINE_INDEX:
+            return index_.byCuisine(cuisine_).size();
+        case TYPE_INDEX:
+            return index_.byType(type_).size();
+        case PREP_INDEX:
+            return index_.countPrepTime(prep_min_, prep_max_);
+        case PRICE_INDEX:
+            return index_.countPrice(price_min_, price_max_);
+        case INGREDIENT_INDEX:
+            return rarestIngredient().size();
+        default:
+            return kitchen_.getCurrentSize();
+    }
+}
+
+/**
+ * @return True if every predicate is answered by `source` alone.
+ */
+bool KitchenQuery::coveredBy(const Source& source) const {
+    int constrained = has_cuisine_ + has_type_ + has_prep_ + has_price_ + (vegetarian_ >= 0) + (gluten_free_ >= 0)
+                      + (contains_nuts_ >= 0) + has_spiciness_ + has_sweetness_ + !ingredients_.empty();
+    if (constrained == 0) {
+        return source == FULL_SCAN;
+    }
+    return constrained == 1 && ((source == CUISINE_INDEX && has_cuisine_) || (source == TYPE_INDEX && has_type_)
+                                || (source == PREP_INDEX && has_prep_) || (source == PRICE_INDEX && has_price_)
+                                || (source == INGREDIENT_INDEX && ingredients_.size() == 1));
+}
+
+/**
+ * @return The shortest posting list among the required ingredients.
+ * @pre At least one ingredient is required.
+ */
+const std::vector<Dish*>& KitchenQuery::rarestIngredient() const {
+    const std::vector<Dish*>* rarest = &ingredient_index_.postings(ingredients_[0]);
+    for (size_t i = 1; i < ingredients_.size(); i++) {
+        const std::vector<Dish*>& list = ingredient_index_.postings(ingredients_[i]);
+        if (list.size() < rarest->size()) {
+            rarest = &list;
+        }
+    }
+    return *rarest;
+}
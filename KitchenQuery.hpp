@@ -0,0 +1,203 @@
+/**
+ * @file KitchenQuery.hpp
+ * @brief This file contains the declaration of the KitchenQuery class, a composable filter over the dishes of a
+ * Kitchen that answers from the kitchen's indexes where it can.
+ *
+ * Predicates are added with chained calls and combined with AND:
+ *
+ *     KitchenQuery(kitchen).cuisine(Dish::ITALIAN).prepTime(0, 30).vegetarian(true).count();
+ *
+ * The query starts from the most selective source the constraints allow (a cuisine, dish type, prep-time, price
+ * or ingredient index, or a scan of the whole kitchen, whichever holds the fewest dishes) and tests the remaining
+ * predicates on each candidate. run() returns a lazy range that does this one dish at a time; count() walks the
+ * same candidates without collecting them, and when the chosen index answers every constraint on its own it
+ * returns the index's size without visiting any dish.
+ *
+ * Flag and level predicates only match the dish type that carries them: vegetarian and spiciness apply to
+ * appetizers, gluten-free to main courses, and contains-nuts and sweetness to desserts.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_QUERY_HPP
+#define KITCHEN_QUERY_HPP
+
+#include "Kitchen.hpp"
+#include "KitchenIndex.hpp"
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+
+class KitchenQuery {
+    public:
+        /**
+         * @enum Source
+         * @brief Where a query takes its candidate dishes from.
+         */
+        enum Source { FULL_SCAN, CUISINE_INDEX, TYPE_INDEX, PREP_INDEX, PRICE_INDEX, INGREDIENT_INDEX };
+
+        /**
+         * A forward iterator over the dishes that match the query.
+         */
+        class Iterator {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef Dish* value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef Dish* const* pointer;
+                typedef Dish* const& reference;
+
+                Dish* operator*() const {
+                    return *current_;
+                }
+
+                Iterator& operator++() {
+                    ++current_;
+                    settle();
+                    return *this;
+                }
+
+                bool operator==(const Iterator& other) const {
+                    return current_ == other.current_;
+                }
+
+                bool operator!=(const Iterator& other) const {
+                    return current_ != other.current_;
+                }
+
+            private:
+                friend class KitchenQuery;
+                Iterator() = default;
+
+                /**
+                 * Moves forward to the next matching dish, refilling the current span from the index map when
+                 * it runs out. Leaves current_ null at the end.
+                 */
+                void settle();
+
+                const KitchenQuery* query_ = nullptr;
+                Dish* const* current_ = nullptr;
+                Dish* const* span_end_ = nullptr;
+                KitchenIndex::PrepMap::const_iterator prep_next_, prep_end_;
+                KitchenIndex::PriceMap::const_iterator price_next_, price_end_;
+        };
+
+        class Range;
+
+        explicit KitchenQuery(const Kitchen& kitchen);
+
+        KitchenQuery& cuisine(const Dish::CuisineType& cuisine);
+        KitchenQuery& dishType(const KitchenIndex::DishType& type);
+        /**
+         * Keeps dishes with min <= prep time <= max; none if min > max.
+         */
+        KitchenQuery& prepTime(const int& min, const int& max);
+        /**
+         * Keeps dishes with min <= price <= max; none if min > max or either bound is NaN.
+         */
+        KitchenQuery& price(const double& min, const double& max);
+        KitchenQuery& vegetarian(const bool& vegetarian);
+        KitchenQuery& glutenFree(const bool& gluten_free);
+        KitchenQuery& containsNuts(const bool& contains_nuts);
+        KitchenQuery& spiciness(const int& min, const int& max);
+        KitchenQuery& sweetness(const int& min, const int& max);
+        /**
+         * Keeps dishes that list `ingredient`. Repeated calls require every ingredient given.
+         */
+        KitchenQuery& ingredient(const std::string& ingredient);
+
+        /**
+         * @return The source run() and count() will read candidates from.
+         */
+        Source plan() const;
+
+        /**
+         * @return A short description of plan() for logging, e.g. "PREP_INDEX (12 candidates)".
+         */
+        std::string explain() const;
+
+        /**
+         * @return True if `dish` satisfies every predicate.
+         * @pre `dish` is in the kitchen.
+         */
+        bool matches(const Dish* dish) const;
+
+        /**
+         * @return The matching dishes, produced lazily in index order. The range holds its own copy of the
+         * predicates, so it may outlive this query, as in `for (Dish* d : KitchenQuery(k).price(2, 3).run())`.
+         * It is invalidated by any change to the kitchen.
+         */
+        Range run() const;
+
+        /**
+         * @return The number of matching dishes. No dish is copied, and none is visited if the chosen index
+         * answers the whole query.
+         */
+        size_t count() const;
+
+    private:
+        /**
+         * @return An iterator at the first matching dish, reading this query's predicates.
+         */
+        Iterator first() const;
+
+        /**
+         * @return The number of candidates `source` would produce.
+         */
+        size_t candidateCount(const Source& source) const;
+
+        /**
+         * @return True if every predicate is answered by `source` alone.
+         */
+        bool coveredBy(const Source& source) const;
+
+        /**
+         * @return The shortest posting list among the required ingredients.
+         * @pre At least one ingredient is required.
+         */
+        const std::vector<Dish*>& rarestIngredient() const;
+
+        const Kitchen& kitchen_;
+        const KitchenIndex& index_;
+        const IngredientIndex& ingredient_index_;
+
+        bool has_cuisine_ = false;
+        Dish::CuisineType cuisine_ = Dish::OTHER;
+        bool has_type_ = false;
+        KitchenIndex::DishType type_ = KitchenIndex::APPETIZER;
+        bool has_prep_ = false;
+        int prep_min_ = 0, prep_max_ = 0;
+        bool has_price_ = false;
+        double price_min_ = 0, price_max_ = 0;
+        int vegetarian_ = -1, gluten_free_ = -1, contains_nuts_ = -1;     // -1 when not constrained.
+        bool has_spiciness_ = false;
+        int spiciness_min_ = 0, spiciness_max_ = 0;
+        bool has_sweetness_ = false;
+        int sweetness_min_ = 0, sweetness_max_ = 0;
+        std::vector<std::string> ingredients_;
+};
+
+/**
+ * The lazy result of run(), usable in a range-based for loop. Its iterators read the range's own copy of the query,
+ * so they are valid as long as the range is.
+ */
+class KitchenQuery::Range {
+    public:
+        Iterator begin() const {
+            return query_.first();
+        }
+
+        Iterator end() const {
+            return Iterator();
+        }
+
+    private:
+        friend class KitchenQuery;
+        explicit Range(const KitchenQuery& query) : query_(query) {}
+
+        KitchenQuery query_;
+};
+
+#endif // KITCHEN_QUERY_HPP
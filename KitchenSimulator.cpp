@@ -0,0 +1,226 @@
+/**
+ * @file KitchenSimulator.cpp
+ * @brief This file contains the implementation of the KitchenSimulator class, a discrete-event model of a kitchen.
+ *
+ * Each run generates Poisson order arrivals from a seeded random stream, routes every order to the station
+ * for its dish type, and serves it first-come first-served by the station's cooks. Scenarios share no
+ * mutable state, so runAll() hands them out to worker threads from an atomic counter.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenSimulator.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <random>
+#include <thread>
+#include <tuple>
+
+namespace {
+    // Minutes spent on top of the prep time to send out an appetizer, by serving style.
+    const double PLATED_OVERHEAD = 2.0;
+    const double FAMILY_STYLE_OVERHEAD = 1.0;
+    // Minutes to portion a BUFFET appetizer from a tray that is already prepared.
+    const double BUFFET_PORTION_TIME = 0.5;
+
+    /**
+     * @param sorted Latencies in ascending order.
+     * @param fraction The percentile as a fraction in [0, 1].
+     * @return The nearest-rank percentile of `sorted`, or 0 if it is empty.
+     */
+    double percentile(const std::vector<double>& sorted, const double& fraction) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+        return sorted[rank == 0 ? 0 : rank - 1];
+    }
+}
+
+KitchenSimulator::KitchenSimulator() {}
+
+/**
+ * Registers a menu that scenarios can draw orders from.
+ * @param label A name for the menu.
+ * @param dishes The dishes on the menu. Only their station, prep time and serving style are kept,
+ * so the dishes may be deallocated after this call.
+ * @return The index to store in Scenario::menu.
+ */
+int KitchenSimulator::addMenu(const std::string& label, const std::vector<Dish*>& dishes) {
+    Menu menu;
+    menu.label = label;
+    for (const Dish* dish : dishes) {
+        MenuItem item;
+        item.service_time = dish->getPrepTime();
+        item.buffet = false;
+        if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(dish)) {
+            item.station = APPETIZER_STATION;
+            switch (appetizer->getServingStyle()) {
+                case Appetizer::PLATED: item.service_time += PLATED_OVERHEAD; break;
+                case Appetizer::FAMILY_STYLE: item.service_time += FAMILY_STYLE_OVERHEAD; break;
+                case Appetizer::BUFFET: item.buffet = true; break;
+            }
+        } else if (dynamic_cast<const MainCourse*>(dish)) {
+            item.station = MAIN_COURSE_STATION;
+        } else {
+            item.station = DESSERT_STATION;
+        }
+        menu.items.push_back(item);
+    }
+    menus_.push_back(menu);
+    return static_cast<int>(menus_.size()) - 1;
+}
+
+/**
+ * @return The label given to menu `menu` in addMenu().
+ */
+std::string KitchenSimulator::getMenuLabel(const int& menu) const {
+    return menus_[menu].label;
+}
+
+/**
+ * Runs a single scenario to completion.
+ * @param scenario The scenario to simulate.
+ * @pre scenario.menu refers to a non-empty menu.
+ * @return The measurements for the run.
+ */
+KitchenSimulator::Result KitchenSimulator::run(const Scenario& scenario) const {
+    const std::vector<MenuItem>& items = menus_[scenario.menu].items;
+
+    struct Order {
+        double arrival;
+        int item;
+    };
+    // (finish time, station, arrival time), earliest finish on top
+    typedef std::tuple<double, int, double> Completion;
+    std::priority_queue<Completion, std::vector<Completion>, std::greater<Completion>> completions;
+
+    std::mt19937 rng(scenario.seed);
+    std::exponential_distribution<double> interarrival(scenario.arrival_rate > 0 ? scenario.arrival_rate : 1.0);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(items.size()) - 1);
+
+    std::deque<Order> queues[STATION_COUNT];
+    int cooks[STATION_COUNT];
+    int busy[STATION_COUNT] = {0, 0, 0};
+    double busy_time[STATION_COUNT] = {0, 0, 0};
+    for (int s = 0; s < STATION_COUNT; s++) {
+        cooks[s] = std::max(scenario.cooks[s], 1);
+    }
+    int tray_size = std::max(scenario.buffet_tray_size, 1);
+    std::vector<int> tray_left(items.size(), 0);
+
+    std::vector<double> latencies;
+    latencies.reserve(scenario.order_count);
+    int generated = 0;
+    int waiting = 0;
+    int max_waiting = 0;
+    double queue_area = 0;
+    double now = 0;
+    double next_arrival = interarrival(rng);
+
+    // Hands queued orders at `station` to idle cooks, starting their service at `now`.
+    auto dispatch = [&](int station) {
+        while (busy[station] < cooks[station] && !queues[station].empty()) {
+            Order order = queues[station].front();
+            queues[station].pop_front();
+            waiting--;
+
+            const MenuItem& item = items[order.item];
+            double service = item.service_time;
+            if (item.buffet) {
+                if (tray_left[order.item] == 0) {
+                    tray_left[order.item] = tray_size;
+                    service += BUFFET_PORTION_TIME;
+                } else {
+                    service = BUFFET_PORTION_TIME;
+                }
+                tray_left[order.item]--;
+            }
+            busy[station]++;
+            busy_time[station] += service;
+            completions.push(Completion(now + service, station, order.arrival));
+        }
+    };
+
+    while (generated < scenario.order_count || !completions.empty()) {
+        bool arrival = generated < scenario.order_count
+            && (completions.empty() || next_arrival <= std::get<0>(completions.top()));
+        double event_time = arrival ? next_arrival : std::get<0>(completions.top());
+        queue_area += waiting * (event_time - now);
+        now = event_time;
+
+        if (arrival) {
+            Order order = {now, pick(rng)};
+            int station = items[order.item].station;
+            queues[station].push_back(order);
+            waiting++;
+            max_waiting = std::max(max_waiting, waiting);
+            generated++;
+            next_arrival = now + interarrival(rng);
+            dispatch(station);
+        } else {
+            Completion done = completions.top();
+            completions.pop();
+            int station = std::get<1>(done);
+            latencies.push_back(now - std::get<2>(done));
+            busy[station]--;
+            dispatch(station);
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    Result result;
+    result.label = scenario.label;
+    result.orders_completed = static_cast<int>(latencies.size());
+    result.makespan = now;
+    result.throughput_per_hour = now > 0 ? latencies.size() * 60.0 / now : 0;
+    result.avg_queue_depth = now > 0 ? queue_area / now : 0;
+    result.max_queue_depth = max_waiting;
+    result.latency_p50 = percentile(latencies, 0.50);
+    result.latency_p90 = percentile(latencies, 0.90);
+    result.latency_p99 = percentile(latencies, 0.99);
+    result.latency_max = latencies.empty() ? 0 : latencies.back();
+    for (int s = 0; s < STATION_COUNT; s++) {
+        result.utilization[s] = now > 0 ? busy_time[s] / (cooks[s] * now) : 0;
+    }
+    return result;
+}
+
+/**
+ * Runs every scenario, distributing them across worker threads.
+ * @param scenarios The scenarios to simulate.
+ * @param threads The number of worker threads; 0 uses one per hardware core.
+ * @return One result per scenario, in the same order as `scenarios`.
+ */
+std::vector<KitchenSimulator::Result> KitchenSimulator::runAll(const std::vector<Scenario>& scenarios, unsigned threads) const {
+    std::vector<Result> results(scenarios.size());
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threads = std::min<unsigned>(threads, std::max<size_t>(scenarios.size(), 1));
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < scenarios.size(); i = next++) {
+            results[i] = run(scenarios[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file KitchenSimulator.hpp
+ * @brief This file contains the declaration of the KitchenSimulator class, a discrete-event model of a kitchen.
+ *
+ * The KitchenSimulator replays a stream of orders drawn from one or more menus of Dish objects through
+ * three stations (appetizer, main course, dessert), each staffed by a number of cooks. Service times come
+ * from each dish's preparation time and, for appetizers, its serving style. Independent scenarios can be
+ * run in parallel across cores to sweep staffing levels, arrival rates and menus in one invocation.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_SIMULATOR_HPP
+#define KITCHEN_SIMULATOR_HPP
+
+#include "Dish.hpp"
+#include <string>
+#include <vector>
+
+class KitchenSimulator {
+    public:
+        /**
+         * @enum Station
+         * @brief The station that prepares a dish, determined by the dish's subclass.
+         */
+        enum Station { APPETIZER_STATION, MAIN_COURSE_STATION, DESSERT_STATION, STATION_COUNT };
+
+        /**
+         * @struct Scenario
+         * @brief One independent configuration to simulate.
+         */
+        struct Scenario {
+            std::string label;              ///< Free-form name printed with the result.
+            int menu;                       ///< Index of the menu returned by addMenu().
+            int cooks[STATION_COUNT];       ///< Number of cooks per station (at least 1).
+            double arrival_rate;            ///< Mean orders per minute (Poisson arrivals).
+            int order_count;                ///< Number of orders in the stream.
+            int buffet_tray_size;           ///< Portions produced by one prep of a BUFFET appetizer.
+            unsigned seed;                  ///< Seed for the order stream, so runs are reproducible.
+        };
+
+        /**
+         * @struct Result
+         * @brief Measurements collected from one scenario run. Times are in minutes.
+         */
+        struct Result {
+            std::string label;
+            int orders_completed;
+            double makespan;                        ///< Time the last order finished.
+            double throughput_per_hour;             ///< Completed orders per hour of makespan.
+            double avg_queue_depth;                 ///< Time-weighted mean of waiting orders, all stations.
+            int max_queue_depth;                    ///< Largest number of waiting orders seen, all stations.
+            double latency_p50;
+            double latency_p90;
+            double latency_p99;
+            double latency_max;
+            double utilization[STATION_COUNT];      ///< Fraction of cook-time spent busy per station.
+        };
+
+        KitchenSimulator();
+
+        /**
+         * Registers a menu that scenarios can draw orders from.
+         * @param label A name for the menu.
+         * @param dishes The dishes on the menu. Only their station, prep time and serving style are kept,
+         * so the dishes may be deallocated after this call.
+         * @return The index to store in Scenario::menu.
+         */
+        int addMenu(const std::string& label, const std::vector<Dish*>& dishes);
+
+        /**
+         * @return The label given to menu `menu` in addMenu().
+         */
+        std::string getMenuLabel(const int& menu) const;
+
+        /**
+         * Runs a single scenario to completion.
+         * @param scenario The scenario to simulate.
+         * @pre scenario.menu refers to a non-empty menu.
+         * @return The measurements for the run.
+         */
+        Result run(const Scenario& scenario) const;
+
+        /**
+         * Runs every scenario, distributing them across worker threads.
+         * @param scenarios The scenarios to simulate.
+         * @param threads The number of worker threads; 0 uses one per hardware core.
+         * @return One result per scenario, in the same order as `scenarios`.
+         */
+        std::vector<Result> runAll(const std::vector<Scenario>& scenarios, unsigned threads = 0) const;
+
+    private:
+        /**
+         * @struct MenuItem
+         * @brief The part of a Dish that the model needs, copied so runs never touch the Dish objects.
+         */
+        struct MenuItem {
+            Station station;
+            double service_time;    ///< Prep time plus the serving-style overhead, in minutes.
+            bool buffet;            ///< Served from a shared tray that is refilled every buffet_tray_size orders.
+        };
+
+        struct Menu {
+            std::string label;
+            std::vector<MenuItem> items;
+        };
+
+        std::vector<Menu> menus_;
+};
+
+#endif // KITCHEN_SIMULATOR_HPP
@@ -0,0 +1,144 @@
+/**
+ * @file KitchenStats.cpp
+ * @brief This file contains the implementation of the KitchenStats class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenStats.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace {
+    double valueOf(const Dish* dish, const KitchenStats::Column& column) {
+        return column == KitchenStats::PREP_TIME ? dish->getPrepTime() : dish->getPrice();
+    }
+
+    /**
+     * @return The zero-based position of the element with rank round(fraction * count), clamped to [1, count].
+     * @pre count > 0.
+     */
+    size_t rankOf(const double& fraction, const size_t& count) {
+        size_t rank = static_cast<size_t>(std::max(0.0, fraction * count + 0.5));
+        return std::min(count, std::max<size_t>(1, rank)) - 1;
+    }
+
+    /**
+     * @return The percentile of the values in [first, last), reordering them.
+     */
+    double select(std::vector<double>::iterator first, std::vector<double>::iterator last, const double& fraction) {
+        if (first == last) {
+            return 0;
+        }
+        auto nth = first + rankOf(fraction, last - first);
+        std::nth_element(first, nth, last);
+        return *nth;
+    }
+}
+
+KitchenStats::KitchenStats(const Kitchen& kitchen) : kitchen_(kitchen) {}
+
+/**
+ * @param largest True for the k highest values, false for the k lowest.
+ * @return Up to k dishes, best first. Ties keep the kitchen's order.
+ */
+std::vector<Dish*> KitchenStats::topK(const Column& column, const size_t& k, const bool& largest) const {
+    KITCHEN_TIME_SCOPE("stats.topK.ns");
+    if (k == 0) {
+        return {};
+    }
+    typedef std::pair<double, int> Candidate;   // value, position in the kitchen
+    // better(a, b) orders a before b in the result; used as the heap's "less", the top is the worst kept.
+    auto better = [&largest](const Candidate& a, const Candidate& b) {
+        if (a.first != b.first) {
+            return largest ? a.first > b.first : a.first < b.first;
+        }
+        return a.second < b.second;
+    };
+    std::vector<Candidate> heap;
+    heap.reserve(std::min<size_t>(k, kitchen_.getCurrentSize()));
+    for (int i = 0; i < kitchen_.getCurrentSize(); i++) {
+        Candidate candidate(valueOf(kitchen_.items_[i], column), i);
+        if (heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end(), better);
+        } else if (better(candidate, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), better);
+    std::vector<Dish*> result;
+    result.reserve(heap.size());
+    for (const Candidate& candidate : heap) {
+        result.push_back(kitchen_.items_[candidate.second]);
+    }
+    return result;
+}
+
+/**
+ * @param fraction A percentile as a fraction in [0, 1].
+ * @return The exact value with that rank, or 0 if the kitchen is empty.
+ */
+double KitchenStats::percentile(const Column& column, const double& fraction) const {
+    return percentiles(column, {fraction})[0];
+}
+
+/**
+ * @return The exact value for each fraction in `fractions`, in the same order, from one copy of the column;
+ * each selection only searches the part of the buffer the previous ones left unsorted.
+ */
+std::vector<double> KitchenStats::percentiles(const Column& column, const std::vector<double>& fractions) const {
+    KITCHEN_TIME_SCOPE("stats.percentiles.ns");
+    std::vector<double> result(fractions.size(), 0);
+    size_t count = kitchen_.getCurrentSize();
+    if (count == 0) {
+        return result;
+    }
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; i++) {
+        values[i] = valueOf(kitchen_.items_[i], column);
+    }
+    // Selecting in rank order means everything before the last selected position is already no larger, so
+    // the next selection can start there.
+    std::vector<size_t> order(fractions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return fractions[a] < fractions[b]; });
+    auto from = values.begin();
+    for (size_t i : order) {
+        auto nth = values.begin() + rankOf(fractions[i], count);
+        std::nth_element(from, nth, values.end());
+        from = nth;
+        result[i] = *nth;
+    }
+    return result;
+}
+
+/**
+ * @return The exact percentile for every cuisine, indexed by Dish::CuisineType; 0 for a cuisine with no dishes.
+ */
+std::array<double, KitchenIndex::CUISINE_COUNT> KitchenStats::percentileByCuisine(const Column& column,
+                                                                                 const double& fraction) const {
+    KITCHEN_TIME_SCOPE("stats.percentileByCuisine.ns");
+    const KitchenIndex& index = kitchen_.getIndex();
+    // One buffer for every cuisine, filled from the cuisine lists so each dish is read once, then selected in
+    // per-cuisine segments.
+    std::vector<double> values;
+    values.reserve(index.size());
+    size_t bounds[KitchenIndex::CUISINE_COUNT + 1] = {0};
+    for (int c = 0; c < KitchenIndex::CUISINE_COUNT; c++) {
+        for (const Dish* dish : index.byCuisine(static_cast<Dish::CuisineType>(c))) {
+            values.push_back(valueOf(dish, column));
+        }
+        bounds[c + 1] = values.size();
+    }
+    std::array<double, KitchenIndex::CUISINE_COUNT> result;
+    for (int c = 0; c < KitchenIndex::CUISINE_COUNT; c++) {
+        result[c] = select(values.begin() + bounds[c], values.begin() + bounds[c + 1], fraction);
+    }
+    return result;
+}
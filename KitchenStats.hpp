@@ -0,0 +1,66 @@
+/**
+ * @file KitchenStats.hpp
+ * @brief This file contains the declaration of the KitchenStats class, order statistics over the prep times and
+ * prices of a Kitchen's dishes.
+ *
+ * topK() keeps a heap of the k best dishes seen so far, so it costs O(n log k) instead of sorting the kitchen.
+ * Percentiles are exact: the column is copied into a scratch buffer and std::nth_element places the element of
+ * the wanted rank, in O(n). percentileByCuisine() visits each dish once, through the kitchen's cuisine index,
+ * and answers all cuisines together.
+ *
+ * Ranks are rounded as in MetricsRegistry::Histogram::percentile(): the fraction f of n values selects the
+ * round(f * n)-th smallest, clamped to [1, n], so a median of an even count is the lower middle value. For an
+ * approximate answer that costs nothing per query, see Kitchen::trackQuantiles().
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_STATS_HPP
+#define KITCHEN_STATS_HPP
+
+#include "Kitchen.hpp"
+#include "KitchenIndex.hpp"
+#include <array>
+#include <vector>
+
+class KitchenStats {
+    public:
+        /**
+         * @enum Column
+         * @brief The dish attribute a statistic is taken over.
+         */
+        enum Column { PREP_TIME, PRICE };
+
+        explicit KitchenStats(const Kitchen& kitchen);
+
+        /**
+         * @param largest True for the k highest values, false for the k lowest.
+         * @return Up to k dishes, best first. Ties keep the kitchen's order.
+         */
+        std::vector<Dish*> topK(const Column& column, const size_t& k, const bool& largest = true) const;
+
+        /**
+         * @param fraction A percentile as a fraction in [0, 1].
+         * @return The exact value with that rank, or 0 if the kitchen is empty.
+         */
+        double percentile(const Column& column, const double& fraction) const;
+
+        /**
+         * @return The exact value for each fraction in `fractions`, in the same order, from one copy of the
+         * column; each selection only searches the part of the buffer the previous ones left unsorted.
+         */
+        std::vector<double> percentiles(const Column& column, const std::vector<double>& fractions) const;
+
+        /**
+         * @return The exact percentile for every cuisine, indexed by Dish::CuisineType; 0 for a cuisine with no
+         * dishes.
+         */
+        std::array<double, KitchenIndex::CUISINE_COUNT> percentileByCuisine(const Column& column,
+                                                                            const double& fraction) const;
+
+    private:
+        const Kitchen& kitchen_;
+};
+
+#endif // KITCHEN_STATS_HPP
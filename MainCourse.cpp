@@ -20,7 +20,9 @@
  * Initializes all private members with default values.
  */
 MainCourse::MainCourse()
-    : Dish(), cooking_method_(GRILLED), protein_type_("UNKNOWN"), side_dishes_(), gluten_free_(false) {}
+    : Dish(), cooking_method_(GRILLED), protein_type_("UNKNOWN"), side_dishes_(), gluten_free_(false) {
+    updateCompatibility();
+}
 
 /**
  * Parameterized constructor.
@@ -35,7 +37,9 @@ MainCourse::MainCourse()
  * @param gluten_free Flag indicating if the main course is gluten-free.
  */
 MainCourse::MainCourse(const std::string& name, const std::vector<std::string>& ingredients, const int &prep_time, const double &price, const CuisineType &cuisine_type, const CookingMethod &cooking_method, const std::string& protein_type, const std::vector<SideDish>& side_dishes, const bool &gluten_free)
-    : Dish(name, ingredients, prep_time, price, cuisine_type), cooking_method_(cooking_method), protein_type_(protein_type), side_dishes_(side_dishes), gluten_free_(gluten_free) {}
+    : Dish(name, ingredients, prep_time, price, cuisine_type), cooking_method_(cooking_method), protein_type_(protein_type), side_dishes_(side_dishes), gluten_free_(gluten_free) {
+    updateCompatibility();
+}
 
 /**
  * Sets the cooking method of the main course.
@@ -44,6 +48,7 @@ MainCourse::MainCourse(const std::string& name, const std::vector<std::string>&
  */
 void MainCourse::setCookingMethod(const CookingMethod &cooking_method) {
     cooking_method_ = cooking_method;
+    touch();
 }
 
 /**
@@ -60,6 +65,7 @@ MainCourse::CookingMethod MainCourse::getCookingMethod() const {
  */
 void MainCourse::setProteinType(const std::string& protein_type) {
     protein_type_ = protein_type;
+    touch();
 }
 
 /**
@@ -76,12 +82,30 @@ std::string MainCourse::getProteinType() const {
  */
 void MainCourse::addSideDish(const SideDish& side_dish) {
     side_dishes_.push_back(side_dish);
+    touch();
+}
+
+/**
+ * Replaces the side dishes of the main course.
+ * @param side_dishes The new side dishes.
+ * @post Sets the private member `side_dishes_` to the value of the parameter.
+ */
+void MainCourse::setSideDishes(const SideDishList& side_dishes) {
+    side_dishes_ = side_dishes;
+    touch();
 }
 
 /**
  * @return A vector of SideDish structs representing the side dishes served with the main course.
  */
 std::vector<MainCourse::SideDish> MainCourse::getSideDishes() const {
+    return side_dishes_.toVector();
+}
+
+/**
+ * @return The side dishes, read in place without the copy getSideDishes() makes.
+ */
+const MainCourse::SideDishList& MainCourse::getSideDishList() const {
     return side_dishes_;
 }
 
@@ -92,6 +116,7 @@ std::vector<MainCourse::SideDish> MainCourse::getSideDishes() const {
  */
 void MainCourse::setGlutenFree(const bool &gluten_free) {
     gluten_free_ = gluten_free;
+    touch();
 }
 
 /**
@@ -202,56 +227,95 @@ involves gluten.
 `PASTA`, `BREAD`, `STARCHES`.
  */
 void MainCourse::dietaryAccommodations(const DietaryRequest& request) {
-    std::vector<std::string> ingredients = getIngredients();
+    // The rules are in dietaryDelta(), so that DietaryViews can present the adjusted main course without changing
+    // it.
+    MainCourse::applyDietaryDelta(MainCourse::dietaryDelta(request));
+}
+
+/**
+ * @return What dietaryAccommodations(request) would change, leaving the main course unchanged.
+ */
+Dish::DietaryDelta MainCourse::dietaryDelta(const DietaryRequest& request) const {
+    DietaryDelta delta;
+    const IngredientList& ingredients = getIngredientList();
 
     // Handle vegetarian request
     if (request.vegetarian) {
-        protein_type_ = "Tofu";
-
-        std::vector<std::string> non_veg_ingredients = {"Meat", "Chicken", "Fish", "Beef", "Pork", "Lamb", "Shrimp", "Bacon"};
-        int replacement_count = 0;
-        for (auto& ingredient : ingredients) {
-            if (std::find(non_veg_ingredients.begin(), non_veg_ingredients.end(), ingredient) != non_veg_ingredients.end()) {
-                if (replacement_count == 0) {
-                    ingredient = "Beans";  // First replacement
-                } else if (replacement_count == 1) {
-                    ingredient = "Mushrooms";  // Second replacement
-                } else {
-                    ingredient = "";  // Remove additional non-veg ingredients
-                }
-                replacement_count++;
-            }
-        }
-        ingredients.erase(std::remove(ingredients.begin(), ingredients.end(), ""), ingredients.end());
+        delta.marks |= DietaryDelta::MARK_TOFU;
+        replaceMeatAndFish(ingredients, delta);
     }
 
     // Handle vegan request
     if (request.vegan) {
-        protein_type_ = "Tofu";
-
-        std::vector<std::string> dairy_eggs = {"Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"};
-        for (auto &ingredient: ingredients) {
-            if (std::find(dairy_eggs.begin(), dairy_eggs.end(), ingredient) != dairy_eggs.end()) {
-                ingredient = "";  // Remove dairy/eggs
-            }
-        }
-        ingredients.erase(std::remove(ingredients.begin(), ingredients.end(), ""), ingredients.end());
+        delta.marks |= DietaryDelta::MARK_TOFU;
+        static const std::vector<std::string> dairy_eggs = {"Milk", "Eggs", "Cheese", "Butter", "Cream", "Yogurt"};
+        dropIngredients(ingredients, dairy_eggs, delta);
+        dropEmptyIngredients(ingredients, delta);
     }
 
     // Handle gluten-free request
     if (request.gluten_free) {
-        gluten_free_ = true;
+        delta.marks |= DietaryDelta::MARK_GLUTEN_FREE;
 
         // Remove gluten-containing side dishes
-        std::vector<Category> gluten_categories = {Category::GRAIN, Category::PASTA, Category::BREAD, Category::STARCHES};
-        side_dishes_.erase(std::remove_if(side_dishes_.begin(), side_dishes_.end(),
-                                          [&](const SideDish &dish) {
-                                              return std::find(gluten_categories.begin(), gluten_categories.end(),
-                                                               dish.category) != gluten_categories.end();
-                                          }),
-                           side_dishes_.end());
+        static const std::vector<Category> gluten_categories = {Category::GRAIN, Category::PASTA, Category::BREAD, Category::STARCHES};
+        for (size_t i = 0; i < side_dishes_.size(); i++) {
+            if (std::find(gluten_categories.begin(), gluten_categories.end(), side_dishes_[i].category) != gluten_categories.end()) {
+                delta.dropped_sides.push_back(static_cast<uint32_t>(i));
+            }
+        }
     }
+    return delta;
+}
 
+/**
+ * Applies a delta from dietaryDelta(), as dietaryAccommodations() would.
+ */
+void MainCourse::applyDietaryDelta(const DietaryDelta& delta) {
+    if (delta.marks & DietaryDelta::MARK_TOFU) {
+        protein_type_ = "Tofu";
+    }
+    if (delta.marks & DietaryDelta::MARK_GLUTEN_FREE) {
+        gluten_free_ = true;
+    }
+    if (!delta.dropped_sides.empty()) {
+        SideDishList kept;
+        auto dropped = delta.dropped_sides.begin();
+        for (size_t i = 0; i < side_dishes_.size(); i++) {
+            if (dropped != delta.dropped_sides.end() && *dropped == i) {
+                ++dropped;
+            } else {
+                kept.push_back(side_dishes_[i]);
+            }
+        }
+        side_dishes_ = std::move(kept);
+    }
     // Set the updated ingredients
-    setIngredients(ingredients);
-}
\ No newline at end of file
+    setIngredients(delta.applyTo(getIngredientList()));
+}
+
+/**
+ * @return A newly allocated copy of this main course. The caller owns it.
+ */
+MainCourse* MainCourse::clone() const {
+    return new MainCourse(*this);
+}
+
+/**
+ * @return The Dish mask, narrowed by the protein (meat or fish clears VEGETARIAN and VEGAN), the
+ * gluten-free flag and the side dishes (GLUTEN_FREE needs the flag and no
+ * GRAIN, PASTA, BREAD or STARCHES side).
+ */
+uint8_t MainCourse::computeCompatibility() const {
+    uint8_t mask = Dish::computeCompatibility();
+    if (isMeatOrFish(protein_type_)) {
+        mask &= ~(VEGETARIAN | VEGAN);
+    }
+    bool gluten_side = std::any_of(side_dishes_.begin(), side_dishes_.end(), [](const SideDish& side) {
+        return side.category == GRAIN || side.category == PASTA || side.category == BREAD || side.category == STARCHES;
+    });
+    if (!gluten_free_ || gluten_side) {
+        mask &= ~GLUTEN_FREE;
+    }
+    return mask;
+}
@@ -44,6 +44,12 @@ public:
         Category category; ///< The category of the side dish.
     };
 
+    /**
+     * A main course's side dishes, kept inside the main course unless there
+     * are more than three.
+     */
+    typedef SmallVector<SideDish, 3> SideDishList;
+
     /**
      * Default constructor.
      * Initializes all private members with default values.
@@ -95,11 +101,23 @@ public:
      */
     void addSideDish(const SideDish& side_dish);
 
+    /**
+     * Replaces the side dishes of the main course.
+     * @param side_dishes The new side dishes.
+     * @post Sets the private member `side_dishes_` to the value of the parameter.
+     */
+    void setSideDishes(const SideDishList& side_dishes);
+
     /**
      * @return A vector of SideDish structs representing the side dishes served with the main course.
      */
     std::vector<SideDish> getSideDishes() const;
 
+    /**
+     * @return The side dishes, read in place without the copy getSideDishes() makes.
+     */
+    const SideDishList& getSideDishList() const;
+
     /**
      * Sets the gluten-free flag of the main course.
      * @param gluten_free A boolean indicating if the main course is gluten-free.
@@ -164,10 +182,33 @@ public:
     */
     void dietaryAccommodations(const DietaryRequest& request) override;
 
+    /**
+     * @return What dietaryAccommodations(request) would change, leaving the main course unchanged.
+     */
+    DietaryDelta dietaryDelta(const DietaryRequest& request) const override;
+
+    /**
+     * Applies a delta from dietaryDelta(), as dietaryAccommodations() would.
+     */
+    void applyDietaryDelta(const DietaryDelta& delta) override;
+
+    /**
+     * @return A newly allocated copy of this main course. The caller owns it.
+     */
+    MainCourse* clone() const override;
+
+protected:
+    /**
+     * @return The Dish mask, narrowed by the protein (meat or fish clears VEGETARIAN and VEGAN), the
+     * gluten-free flag and the side dishes (GLUTEN_FREE needs the flag and no
+     * GRAIN, PASTA, BREAD or STARCHES side).
+     */
+    uint8_t computeCompatibility() const override;
+
 private:
     CookingMethod cooking_method_; ///< The cooking method used for the main course.
     std::string protein_type_; ///< The type of protein used in the main course.
-    std::vector<SideDish> side_dishes_; ///< The side dishes served with the main course.
+    SideDishList side_dishes_; ///< The side dishes served with the main course.
     bool gluten_free_; ///< Flag indicating if the main course is gluten-free.
 };
 
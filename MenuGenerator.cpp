@@ -0,0 +1,295 @@
+/**
+ * @file MenuGenerator.cpp
+ * @brief This file contains the implementation of the MenuGenerator class, which writes synthetic menu CSVs.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "MenuGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+    const char* const ADJECTIVES[] = {"Smoky", "Crispy", "Golden", "Spicy", "Tender", "Rustic", "Creamy", "Zesty",
+                                      "Roasted", "Braised", "Charred", "Sweet", "Herbed", "Glazed", "Classic", "Wild"};
+    const char* const APPETIZER_NOUNS[] = {"Bruschetta", "Dumplings", "Wings", "Skewers", "Fritters", "Dip",
+                                           "Rolls", "Croquettes", "Sliders", "Tartlets"};
+    const char* const MAIN_NOUNS[] = {"Risotto", "Curry", "Stew", "Roast", "Tacos", "Noodles", "Casserole",
+                                      "Steak", "Salmon", "Lasagna"};
+    const char* const DESSERT_NOUNS[] = {"Tart", "Pudding", "Cake", "Sorbet", "Mousse", "Crumble", "Pie",
+                                         "Parfait", "Cobbler", "Custard"};
+    const char* const SAVORY_INGREDIENTS[] = {"Tomatoes", "Basil", "Garlic", "Bread", "Chicken", "Beef", "Pork",
+                                              "Shrimp", "Fish", "Cheese", "Eggs", "Flour", "Rice", "Beans", "Onion",
+                                              "Pasta", "Cream", "Butter", "Spinach", "Mushrooms", "Peppers", "Lime",
+                                              "Ginger", "Soy Sauce", "Potatoes", "Carrots", "Lamb", "Bacon"};
+    const char* const SWEET_INGREDIENTS[] = {"Sugar", "Flour", "Eggs", "Butter", "Milk", "Cream", "Chocolate",
+                                             "Vanilla", "Almonds", "Walnuts", "Pecans", "Hazelnuts", "Strawberries",
+                                             "Lemon", "Honey", "Cinnamon", "Yogurt", "Mango", "Coconut", "Crust"};
+    const char* const PROTEINS[] = {"Chicken", "Beef", "Pork", "Fish", "Shrimp", "Tofu", "Lamb", "Beans"};
+    const char* const SIDE_DISHES[] = {"Rice", "Garlic Bread", "Salad", "Soup", "Mashed Potatoes", "Noodles",
+                                       "Lentils", "Roasted Vegetables", "Couscous", "Fries"};
+    const char* const CATEGORIES[] = {"GRAIN", "PASTA", "LEGUME", "BREAD", "SALAD", "SOUP", "STARCHES", "VEGETABLE"};
+    const char* const SERVING_STYLES[] = {"PLATED", "FAMILY_STYLE", "BUFFET"};
+    const char* const COOKING_METHODS[] = {"GRILLED", "BAKED", "BOILED", "FRIED", "STEAMED", "RAW"};
+    const char* const FLAVOR_PROFILES[] = {"SWEET", "BITTER", "SOUR", "SALTY", "UMAMI"};
+    // Neither a valid integer nor a valid double, as found in hand-edited or badly exported files.
+    const char* const DIRTY_NUMBERS[] = {"", "N/A", "12abc", "7.5.1", "ten", "1e999", "nan", "inf", "infinity"};
+
+    template <class T, size_t N>
+    size_t countOf(T (&)[N]) { return N; }
+
+    /**
+     * SplitMix64, a small generator whose whole state is one word, so a fresh one can be seeded per row.
+     */
+    struct RowRandom {
+        uint64_t state;
+
+        explicit RowRandom(uint64_t seed) : state(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+        /** @return A uniform double in [0, 1). */
+        double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+        /** @return A uniform integer in [0, n). */
+        uint64_t below(uint64_t n) { return n == 0 ? 0 : next() % n; }
+        /** @return A uniform integer in [lo, hi]. */
+        int between(int lo, int hi) { return hi <= lo ? lo : lo + static_cast<int>(below(hi - lo + 1)); }
+        /** @return A normally distributed double (Box-Muller). */
+        double normal(double mean, double stddev) {
+            double u1 = std::max(uniform(), 1e-300);
+            double u2 = uniform();
+            return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+        }
+    };
+
+    /**
+     * Replaces one numeric field of `line` with an entry of DIRTY_NUMBERS: the prep time, the price or, if
+     * `has_level`, the spiciness or sweetness level in the attributes.
+     * @pre `line` is a complete row without its newline.
+     */
+    void dirtyNumber(std::string& line, RowRandom& rng, const bool& has_level) {
+        size_t commas[6];
+        size_t position = 0;
+        for (size_t& comma : commas) {
+            comma = line.find(',', position);
+            position = comma + 1;
+        }
+        size_t begin, end;
+        switch (rng.below(has_level ? 3 : 2)) {
+            case 0:
+                begin = commas[2] + 1;
+                end = commas[3];
+                break;
+            case 1:
+                begin = commas[3] + 1;
+                end = commas[4];
+                break;
+            default:
+                begin = line.find(';', commas[5]) + 1;
+                end = line.find(';', begin);
+                break;
+        }
+        line.replace(begin, end - begin, DIRTY_NUMBERS[rng.below(countOf(DIRTY_NUMBERS))]);
+    }
+
+    std::vector<double> cumulative(const std::vector<MenuGenerator::Weighted>& weights) {
+        std::vector<double> cdf;
+        double total = 0;
+        for (const MenuGenerator::Weighted& w : weights) {
+            total += std::max(w.weight, 0.0);
+            cdf.push_back(total);
+        }
+        return cdf;
+    }
+
+    size_t pick(RowRandom& rng, const std::vector<double>& cdf) {
+        double x = rng.uniform() * cdf.back();
+        size_t index = std::upper_bound(cdf.begin(), cdf.end(), x) - cdf.begin();
+        return std::min(index, cdf.size() - 1);
+    }
+
+    /**
+     * Appends `count` distinct entries of `pool` to `row`, separated by ';'.
+     */
+    template <size_t N>
+    void appendIngredients(std::string& row, RowRandom& rng, const char* const (&pool)[N], int count) {
+        count = std::min<int>(count, N);
+        uint64_t used = 0;
+        for (int k = 0; k < count; k++) {
+            size_t choice = rng.below(N);
+            while (used & (1ULL << choice)) {
+                choice = (choice + 1) % N;
+            }
+            used |= 1ULL << choice;
+            if (k > 0) {
+                row += ';';
+            }
+            row += pool[choice];
+        }
+    }
+}
+
+MenuGenerator::Options::Options()
+    : seed(235), rows(1000),
+      cuisines({{"ITALIAN", 1}, {"MEXICAN", 1}, {"CHINESE", 1}, {"INDIAN", 1}, {"AMERICAN", 1}, {"FRENCH", 1},
+                {"THAI", 1}}),
+      dish_types({{"APPETIZER", 1}, {"MAINCOURSE", 1}, {"DESSERT", 1}}),
+      min_ingredients(3), max_ingredients(6), min_side_dishes(1), max_side_dishes(3),
+      prep_mean(30), prep_stddev(15), duplicate_rate(0), dirty_rate(0) {}
+
+/**
+ * Parameterized constructor.
+ * @param options The distributions to draw rows from.
+ */
+MenuGenerator::MenuGenerator(const Options& options)
+    : options_(options), cuisine_cdf_(cumulative(options.cuisines)), dish_type_cdf_(cumulative(options.dish_types)) {
+    if (options_.cuisines.empty() || cuisine_cdf_.back() <= 0) {
+        options_.cuisines = Options().cuisines;
+        cuisine_cdf_ = cumulative(options_.cuisines);
+    }
+    if (options_.dish_types.empty() || dish_type_cdf_.back() <= 0) {
+        options_.dish_types = Options().dish_types;
+        dish_type_cdf_ = cumulative(options_.dish_types);
+    }
+}
+
+/**
+ * Writes the header line followed by `options.rows` rows.
+ * @param out The stream to write to.
+ */
+void MenuGenerator::generate(std::ostream& out) const {
+    out << "DishType,Name,Ingredients,PrepTime,Price,CuisineType,AdditionalAttributes\n";
+    for (long row = 0; row < options_.rows; row++) {
+        writeRow(out, row);
+    }
+    out.flush();
+}
+
+/**
+ * Writes the single data row with number `row` (starting at 0), including its newline.
+ * @param out The stream to write to.
+ * @param row The row number.
+ */
+void MenuGenerator::writeRow(std::ostream& out, const long& row) const {
+    RowRandom rng(options_.seed * 0x100000001B3ULL ^ static_cast<uint64_t>(row));
+    rng.next();
+    if (row > 0 && rng.uniform() < options_.duplicate_rate) {
+        // Regenerating an earlier row keeps duplicates exact without remembering anything.
+        writeRow(out, static_cast<long>(rng.below(row)));
+        return;
+    }
+
+    const std::string& type = options_.dish_types[pick(rng, dish_type_cdf_)].value;
+    bool appetizer = type == "APPETIZER";
+    bool dessert = type == "DESSERT";
+
+    std::string line;
+    line.reserve(192);
+    line += type;
+    line += ',';
+
+    // Name: two words plus a letters-only encoding of the row number, which keeps names unique.
+    line += ADJECTIVES[rng.below(countOf(ADJECTIVES))];
+    line += ' ';
+    if (appetizer) {
+        line += APPETIZER_NOUNS[rng.below(countOf(APPETIZER_NOUNS))];
+    } else if (dessert) {
+        line += DESSERT_NOUNS[rng.below(countOf(DESSERT_NOUNS))];
+    } else {
+        line += MAIN_NOUNS[rng.below(countOf(MAIN_NOUNS))];
+    }
+    line += ' ';
+    long id = row;
+    char first = 'A';
+    do {
+        line += static_cast<char>(first + id % 26);
+        first = 'a';
+        id /= 26;
+    } while (id > 0);
+    line += ',';
+
+    int ingredient_count = rng.between(options_.min_ingredients, options_.max_ingredients);
+    if (dessert) {
+        appendIngredients(line, rng, SWEET_INGREDIENTS, ingredient_count);
+    } else {
+        appendIngredients(line, rng, SAVORY_INGREDIENTS, ingredient_count);
+    }
+
+    int prep_time = static_cast<int>(std::lround(rng.normal(options_.prep_mean, options_.prep_stddev)));
+    prep_time = std::min(std::max(prep_time, 1), 240);
+    double base_price = appetizer ? 4 : dessert ? 3 : 10;
+    double price_range = appetizer ? 9 : dessert ? 6 : 20;
+    char numbers[64];
+    std::snprintf(numbers, sizeof(numbers), ",%d,%.2f,", prep_time,
+                  std::floor(base_price + rng.uniform() * price_range) + 0.49 + 0.5 * rng.below(2));
+    line += numbers;
+
+    line += options_.cuisines[pick(rng, cuisine_cdf_)].value;
+    line += ',';
+
+    if (appetizer) {
+        line += SERVING_STYLES[rng.below(countOf(SERVING_STYLES))];
+        line += ';';
+        line += std::to_string(rng.between(0, 9));
+        line += rng.below(2) ? ";true" : ";false";
+    } else if (dessert) {
+        line += FLAVOR_PROFILES[rng.below(countOf(FLAVOR_PROFILES))];
+        line += ';';
+        line += std::to_string(rng.between(0, 10));
+        line += rng.below(4) == 0 ? ";true" : ";false";
+    } else {
+        line += COOKING_METHODS[rng.below(countOf(COOKING_METHODS))];
+        line += ';';
+        line += PROTEINS[rng.below(countOf(PROTEINS))];
+        line += ';';
+        int sides = rng.between(options_.min_side_dishes, options_.max_side_dishes);
+        for (int s = 0; s < sides; s++) {
+            if (s > 0) {
+                line += '|';
+            }
+            line += SIDE_DISHES[rng.below(countOf(SIDE_DISHES))];
+            line += ':';
+            line += CATEGORIES[rng.below(countOf(CATEGORIES))];
+        }
+        line += rng.below(2) ? ";true" : ";false";
+    }
+    if (options_.dirty_rate > 0) {
+        // A generator of its own keeps the clean rows identical to those of a run without dirty rows.
+        RowRandom dirt(rng.state ^ 0xD1B54A32D192ED03ULL);
+        if (dirt.uniform() < options_.dirty_rate) {
+            dirtyNumber(line, dirt, appetizer || dessert);
+        }
+    }
+    line += '\n';
+    out.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+/**
+ * Parses a weight list of the form `NAME=W,NAME=W,...`; a name without `=W` has weight 1.
+ * @param spec The weight list.
+ * @return The parsed values, or an empty vector if `spec` has no entries.
+ */
+std::vector<MenuGenerator::Weighted> MenuGenerator::parseWeights(const std::string& spec) {
+    std::vector<Weighted> weights;
+    std::stringstream spec_ss(spec);
+    std::string entry;
+    while (std::getline(spec_ss, entry, ',')) {
+        if (entry.empty()) {
+            continue;
+        }
+        size_t equals = entry.find('=');
+        Weighted w;
+        w.value = entry.substr(0, equals);
+        w.weight = equals == std::string::npos ? 1.0 : std::atof(entry.substr(equals + 1).c_str());
+        weights.push_back(w);
+    }
+    return weights;
+}
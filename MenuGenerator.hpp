@@ -0,0 +1,94 @@
+/**
+ * @file MenuGenerator.hpp
+ * @brief This file contains the declaration of the MenuGenerator class, which writes synthetic menu CSVs.
+ *
+ * The generated rows follow the exact schema read by the Kitchen constructor:
+ *
+ *     DishType,Name,Ingredient;Ingredient;...,PrepTime,Price,CuisineType,Attributes
+ *
+ * where Attributes is `ServingStyle;Spiciness;Vegetarian` for APPETIZER,
+ * `CookingMethod;Protein;Side:CATEGORY|Side:CATEGORY;GlutenFree` for MAINCOURSE and
+ * `FlavorProfile;Sweetness;ContainsNuts` for DESSERT. The first line is a header, which the Kitchen
+ * constructor skips.
+ *
+ * Every row is a pure function of the seed and the row number, so output is reproducible and duplicates
+ * can be produced by regenerating an earlier row instead of remembering it. Rows are streamed as they are
+ * produced, so memory use does not depend on the number of rows.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef MENU_GENERATOR_HPP
+#define MENU_GENERATOR_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class MenuGenerator {
+    public:
+        /**
+         * @struct Weighted
+         * @brief A value and its relative weight in a categorical distribution.
+         */
+        struct Weighted {
+            std::string value;
+            double weight;
+        };
+
+        /**
+         * @struct Options
+         * @brief Distributions used to generate rows. The defaults resemble Dishes.csv.
+         */
+        struct Options {
+            uint64_t seed;
+            long rows;                          ///< Number of data rows, not counting the header.
+            std::vector<Weighted> cuisines;     ///< Cuisine names; names outside Dish::CuisineType load as OTHER.
+            std::vector<Weighted> dish_types;   ///< Any of APPETIZER, MAINCOURSE, DESSERT.
+            int min_ingredients;
+            int max_ingredients;
+            int min_side_dishes;
+            int max_side_dishes;
+            double prep_mean;                   ///< Prep time is normal(prep_mean, prep_stddev), clamped to [1, 240].
+            double prep_stddev;
+            double duplicate_rate;              ///< Probability that a row repeats an earlier row exactly.
+            double dirty_rate;                  ///< Probability that a row has one malformed number.
+
+            Options();
+        };
+
+        /**
+         * Parameterized constructor.
+         * @param options The distributions to draw rows from.
+         */
+        MenuGenerator(const Options& options);
+
+        /**
+         * Writes the header line followed by `options.rows` rows.
+         * @param out The stream to write to.
+         */
+        void generate(std::ostream& out) const;
+
+        /**
+         * Writes the single data row with number `row` (starting at 0), including its newline.
+         * @param out The stream to write to.
+         * @param row The row number.
+         */
+        void writeRow(std::ostream& out, const long& row) const;
+
+        /**
+         * Parses a weight list of the form `NAME=W,NAME=W,...`; a name without `=W` has weight 1.
+         * @param spec The weight list.
+         * @return The parsed values, or an empty vector if `spec` has no entries.
+         */
+        static std::vector<Weighted> parseWeights(const std::string& spec);
+
+    private:
+        Options options_;
+        std::vector<double> cuisine_cdf_;
+        std::vector<double> dish_type_cdf_;
+};
+
+#endif // MENU_GENERATOR_HPP
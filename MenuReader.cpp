@@ -0,0 +1,228 @@
+/**
+ * @file MenuReader.cpp
+ * @brief This file contains the implementation of the MenuReader class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "MenuReader.hpp"
+#include "Kitchen.hpp"
+#include "Metrics.hpp"
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Opens `filename` and skips its header line.
+ * @param buffer_size The bytes read from the file at a time.
+ * @param prefetch Whether to read ahead on a background thread. Files no larger than one buffer are read directly
+ * either way.
+ */
+MenuReader::MenuReader(const std::string& filename, const size_t& buffer_size, const bool& prefetch)
+    : fd_(::open(filename.c_str(), O_RDONLY)), chunk_(nullptr), chunk_size_(0),
+      buffer_(buffer_size > 0 ? buffer_size : 1), begin_(0), end_(0), at_end_(false), failed_(false),
+      line_number_(0), skipped_rows_(0), bytes_read_(0) {
+    if (fd_ < 0) {
+        at_end_ = true;
+        failed_ = true;
+        return;
+    }
+    // A file that fits in one read has nothing to overlap with, so it is not worth a thread.
+    struct stat info;
+    if (prefetch && ::fstat(fd_, &info) == 0 && static_cast<uint64_t>(info.st_size) > buffer_.size()) {
+        prefetcher_.reset(new ChunkPrefetcher(fd_, buffer_.size()));
+    }
+    std::string_view header;
+    nextLine(header);
+}
+
+MenuReader::~MenuReader() {
+    // The prefetcher's thread reads fd_, so it stops first.
+    prefetcher_.reset();
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+/**
+ * @return True if the file could be opened.
+ */
+bool MenuReader::isOpen() const {
+    return fd_ >= 0;
+}
+
+/**
+ * Reads the next line, without its line ending.
+ * @return False at the end of the file or on a read error.
+ */
+bool MenuReader::nextLine(std::string_view& line) {
+    size_t searched = begin_;
+    while (true) {
+        const char* start = buffer_.data() + begin_;
+        const void* newline = std::memchr(buffer_.data() + searched, '\n', end_ - searched);
+        if (newline != nullptr) {
+            size_t length = static_cast<const char*>(newline) - start;
+            begin_ += length + 1;
+            line = std::string_view(start, length > 0 && start[length - 1] == '\r' ? length - 1 : length);
+            line_number_++;
+            return true;
+        }
+        // Every unread byte has been searched, so after the next read only the new bytes are.
+        size_t unread = end_ - begin_;
+        if (!fill()) {
+            if (unread == 0) {
+                return false;
+            }
+            // The last line of a file need not end with a newline.
+            start = buffer_.data() + begin_;
+            begin_ = end_;
+            line = std::string_view(start, start[unread - 1] == '\r' ? unread - 1 : unread);
+            line_number_++;
+            return true;
+        }
+        searched = begin_ + unread;
+    }
+}
+
+/**
+ * Reads the next row with all seven fields. Lines with fewer are skipped and counted.
+ * @return False at the end of the file or on a read error.
+ */
+bool MenuReader::next(Row& row) {
+    std::string_view line;
+    while (nextLine(line)) {
+        if (split(line, row)) {
+            row.line_number = line_number_;
+            return true;
+        }
+        skipped_rows_++;
+        KITCHEN_COUNTER_ADD("menuReader.skipped_rows", 1);
+    }
+    return false;
+}
+
+/**
+ * Reads the next row Kitchen::parseDish() accepts. Rows it rejects are skipped and counted.
+ * @return A new dish owned by the caller, or nullptr at the end of the file or on a read error.
+ */
+Dish* MenuReader::nextDish() {
+    Row row;
+    while (next(row)) {
+        Dish* dish = Kitchen::parseDish(std::string(row.line));
+        if (dish != nullptr) {
+            return dish;
+        }
+        skipped_rows_++;
+        KITCHEN_COUNTER_ADD("menuReader.skipped_rows", 1);
+    }
+    return nullptr;
+}
+
+/**
+ * Splits `line` into the fields of `row`.
+ * @return False if the line has fewer than seven fields.
+ */
+bool MenuReader::split(const std::string_view& line, Row& row) {
+    std::string_view* fields[] = {&row.type, &row.name, &row.ingredients, &row.prep_time, &row.price, &row.cuisine};
+    size_t start = 0;
+    for (std::string_view* field : fields) {
+        size_t comma = line.find(',', start);
+        if (comma == std::string_view::npos) {
+            return false;
+        }
+        *field = line.substr(start, comma - start);
+        start = comma + 1;
+    }
+    row.attributes = line.substr(start);
+    row.line = line;
+    return true;
+}
+
+/**
+ * @return The number of the last line read, counting the header.
+ */
+uint64_t MenuReader::getLineNumber() const {
+    return line_number_;
+}
+
+/**
+ * @return The number of rows next() or nextDish() skipped as malformed.
+ */
+uint64_t MenuReader::getSkippedRows() const {
+    return skipped_rows_;
+}
+
+uint64_t MenuReader::getBytesRead() const {
+    return bytes_read_;
+}
+
+/**
+ * @return True if reading stopped because of an error rather than the end of the file.
+ */
+bool MenuReader::failed() const {
+    return failed_;
+}
+
+/**
+ * @return The current size of the buffer, which only exceeds the requested size if a row did.
+ */
+size_t MenuReader::getBufferSize() const {
+    return buffer_.size();
+}
+
+/**
+ * @return True if a background thread is reading ahead.
+ */
+bool MenuReader::isPrefetching() const {
+    return prefetcher_ != nullptr;
+}
+
+/**
+ * Moves the unread bytes to the front of the buffer, growing it if they fill it, and reads more.
+ * @return False if nothing more could be read.
+ */
+bool MenuReader::fill() {
+    if (at_end_) {
+        return false;
+    }
+    size_t unread = end_ - begin_;
+    std::memmove(buffer_.data(), buffer_.data() + begin_, unread);
+    begin_ = 0;
+    end_ = unread;
+    if (end_ == buffer_.size()) {
+        KITCHEN_COUNTER_ADD("menuReader.buffer_grown", 1);
+        buffer_.resize(buffer_.size() * 2);
+    }
+    if (prefetcher_ != nullptr) {
+        if (chunk_size_ == 0 && !prefetcher_->next(chunk_, chunk_size_)) {
+            at_end_ = true;
+            failed_ = prefetcher_->failed();
+            return false;
+        }
+        size_t copied = std::min(chunk_size_, buffer_.size() - end_);
+        std::memcpy(buffer_.data() + end_, chunk_, copied);
+        chunk_ += copied;
+        chunk_size_ -= copied;
+        end_ += copied;
+        bytes_read_ += copied;
+        return true;
+    }
+    while (true) {
+        ssize_t got = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+        if (got > 0) {
+            end_ += got;
+            bytes_read_ += got;
+            return true;
+        }
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        at_end_ = true;
+        failed_ = got < 0;
+        return false;
+    }
+}
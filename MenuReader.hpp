@@ -0,0 +1,143 @@
+/**
+ * @file MenuReader.hpp
+ * @brief This file contains the declaration of the MenuReader class, which streams the rows of a menu CSV one
+ * at a time through a fixed-size read buffer.
+ *
+ * The Kitchen constructor materializes every dish of a file. A MenuReader instead hands out one row at a time
+ * as views into its buffer, split into the seven menu fields but not parsed further, so a job that only counts,
+ * filters or re-exports rows allocates nothing per row and holds at most one buffer's worth of the file,
+ * however large the file is. Rows that are needed as dishes can still be turned into one with nextDish().
+ *
+ * The buffer only grows if a single row is longer than it, and then by doubling, to less than twice that row.
+ * With prefetching on, a ChunkPrefetcher reads the next buffer's worth of the file on a background thread while
+ * the current one is parsed, at the cost of two more buffers.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef MENU_READER_HPP
+#define MENU_READER_HPP
+
+#include "ChunkPrefetcher.hpp"
+#include "Dish.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MenuReader {
+    public:
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 16;
+
+        /**
+         * @struct Row
+         * @brief The fields of one menu row, as views into the reader's buffer. They are valid until the next
+         * call that reads from the reader.
+         */
+        struct Row {
+            std::string_view type;
+            std::string_view name;
+            std::string_view ingredients;   ///< Semicolon-separated.
+            std::string_view prep_time;
+            std::string_view price;
+            std::string_view cuisine;
+            std::string_view attributes;    ///< The rest of the row, which depends on the type.
+            std::string_view line;          ///< The whole row, without its line ending.
+            uint64_t line_number;           ///< 1-based, counting the header.
+        };
+
+        /**
+         * Opens `filename` and skips its header line.
+         * @param buffer_size The bytes read from the file at a time.
+         * @param prefetch Whether to read ahead on a background thread. Files no larger than one buffer are
+         * read directly either way.
+         */
+        explicit MenuReader(const std::string& filename, const size_t& buffer_size = DEFAULT_BUFFER_SIZE,
+                            const bool& prefetch = false);
+
+        ~MenuReader();
+
+        MenuReader(const MenuReader&) = delete;
+        MenuReader& operator=(const MenuReader&) = delete;
+
+        /**
+         * @return True if the file could be opened.
+         */
+        bool isOpen() const;
+
+        /**
+         * Reads the next line, without its line ending.
+         * @return False at the end of the file or on a read error.
+         */
+        bool nextLine(std::string_view& line);
+
+        /**
+         * Reads the next row with all seven fields. Lines with fewer are skipped and counted.
+         * @return False at the end of the file or on a read error.
+         */
+        bool next(Row& row);
+
+        /**
+         * Reads the next row Kitchen::parseDish() accepts. Rows it rejects are skipped and counted.
+         * @return A new dish owned by the caller, or nullptr at the end of the file or on a read error.
+         */
+        Dish* nextDish();
+
+        /**
+         * Splits `line` into the fields of `row`.
+         * @return False if the line has fewer than seven fields.
+         */
+        static bool split(const std::string_view& line, Row& row);
+
+        /**
+         * @return The number of the last line read, counting the header.
+         */
+        uint64_t getLineNumber() const;
+
+        /**
+         * @return The number of rows next() or nextDish() skipped as malformed.
+         */
+        uint64_t getSkippedRows() const;
+
+        uint64_t getBytesRead() const;
+
+        /**
+         * @return True if reading stopped because of an error rather than the end of the file.
+         */
+        bool failed() const;
+
+        /**
+         * @return The current size of the buffer, which only exceeds the requested size if a row did.
+         */
+        size_t getBufferSize() const;
+
+        /**
+         * @return True if a background thread is reading ahead.
+         */
+        bool isPrefetching() const;
+
+    private:
+        /**
+         * Moves the unread bytes to the front of the buffer, growing it if they fill it, and reads more.
+         * @return False if nothing more could be read.
+         */
+        bool fill();
+
+        int fd_;
+        std::unique_ptr<ChunkPrefetcher> prefetcher_;
+        const char* chunk_;     // The unconsumed part of the prefetcher's current chunk.
+        size_t chunk_size_;
+        std::vector<char> buffer_;
+        size_t begin_;          // The first unread byte.
+        size_t end_;            // One past the last byte read from the file.
+        bool at_end_;
+        bool failed_;
+        uint64_t line_number_;
+        uint64_t skipped_rows_;
+        uint64_t bytes_read_;
+};
+
+#endif // MENU_READER_HPP
@@ -0,0 +1,247 @@
+/**
+ * @file MenuWatcher.cpp
+ * @brief This file contains the implementation of the MenuWatcher class: the inotify loop, publication and
+ * epoch-based reclamation of replaced kitchens.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "MenuWatcher.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+    // How often the watcher thread wakes to check for stop() and retry reclamation when nothing happens.
+    const int IDLE_POLL_MS = 100;
+
+    /**
+     * Reads every pending inotify event.
+     * @return True if one of them names `file_name`.
+     */
+    bool drainEvents(const int& fd, const std::string& file_name) {
+        alignas(struct inotify_event) char buffer[4096];
+        bool matched = false;
+        ssize_t n;
+        while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + n;) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+                if (event->len > 0 && file_name == event->name) {
+                    matched = true;
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        return matched;
+    }
+}
+
+MenuWatcher::Pin::Pin(const MenuWatcher* watcher, const int& slot)
+    : watcher_(watcher), slot_(slot), kitchen_(nullptr), version_(0) {}
+
+MenuWatcher::Pin::Pin(Pin&& other) noexcept
+    : watcher_(other.watcher_), slot_(other.slot_), kitchen_(other.kitchen_), version_(other.version_) {
+    other.watcher_ = nullptr;
+}
+
+MenuWatcher::Pin::~Pin() {
+    if (watcher_ != nullptr) {
+        watcher_->slots_[slot_].epoch.store(0, std::memory_order_release);
+    }
+}
+
+/**
+ * @param path The menu CSV to serve and watch.
+ * @param debounce_ms How long the file must stay quiet after a change before it is reloaded.
+ */
+MenuWatcher::MenuWatcher(const std::string& path, const int& debounce_ms)
+    : path_(path), debounce_ms_(debounce_ms), inotify_fd_(-1), running_(false), current_(nullptr), epoch_(1) {
+    size_t slash = path.find_last_of('/');
+    directory_ = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    file_name_ = slash == std::string::npos ? path : path.substr(slash + 1);
+    for (ReaderSlot& slot : slots_) {
+        slot.epoch.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Destructor.
+ * @post Stops the watcher thread and deletes every kitchen.
+ * @pre No Pin is still alive.
+ */
+MenuWatcher::~MenuWatcher() {
+    stop();
+    for (const auto& entry : retired_) {
+        delete entry.first->kitchen;
+        delete entry.first;
+    }
+    Published* current = current_.load();
+    if (current != nullptr) {
+        delete current->kitchen;
+        delete current;
+    }
+}
+
+/**
+ * Loads the menu and starts watching it.
+ * @return False if the file cannot be read or inotify is unavailable.
+ */
+bool MenuWatcher::start() {
+    if (running_.load() || !reloadNow()) {
+        return running_.load();
+    }
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        return false;
+    }
+    if (::inotify_add_watch(inotify_fd_, directory_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+    running_.store(true);
+    thread_ = std::thread(&MenuWatcher::watchLoop, this);
+    return true;
+}
+
+/**
+ * Stops watching. The last published kitchen stays available to pin().
+ */
+void MenuWatcher::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    thread_.join();
+    ::close(inotify_fd_);
+    inotify_fd_ = -1;
+}
+
+/**
+ * Pins the current kitchen without locking.
+ * @pre start() succeeded.
+ */
+MenuWatcher::Pin MenuWatcher::pin() const {
+    // Start at a per-thread slot so that concurrent readers rarely compete for the same one.
+    static thread_local int home = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id())
+                                                    % MAX_READERS);
+    for (int i = home;; i = (i + 1) % MAX_READERS) {
+        uint64_t expected = 0;
+        uint64_t epoch = epoch_.load();
+        if (slots_[i].epoch.compare_exchange_strong(expected, epoch)) {
+            // Sequentially consistent: the slot is visible to publish() before the pointer is read, so either
+            // this reader sees the new version or publish() sees this reader's older epoch.
+            Pin pinned(this, i);
+            Published* current = current_.load();
+            pinned.kitchen_ = current->kitchen;
+            pinned.version_ = current->version;
+            return pinned;
+        }
+        if (i == (home + MAX_READERS - 1) % MAX_READERS) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * Builds a new kitchen from the file and publishes it. The watcher thread calls this on every change;
+ * it may also be called directly.
+ * @return False if the file could not be opened, in which case the current kitchen stays published.
+ */
+bool MenuWatcher::reloadNow() {
+    KITCHEN_TRACE_SCOPE("MenuWatcher::reload");
+    if (!std::ifstream(path_)) {
+        KITCHEN_COUNTER_ADD("menuwatcher.reload_failures", 1);
+        return false;
+    }
+    publish(new Kitchen(path_));
+    reclaim();
+    return true;
+}
+
+/**
+ * @return The version of the most recently published kitchen.
+ */
+uint64_t MenuWatcher::version() const {
+    Published* current = current_.load();
+    return current == nullptr ? 0 : current->version;
+}
+
+/**
+ * @return The number of replaced kitchens not yet deleted.
+ */
+size_t MenuWatcher::retiredCount() const {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    return retired_.size();
+}
+
+/**
+ * Runs on the watcher thread: waits for changes to the file, lets them settle for debounce_ms_ and reloads.
+ */
+void MenuWatcher::watchLoop() {
+    struct pollfd poll_fd = {inotify_fd_, POLLIN, 0};
+    bool dirty = false;
+    while (running_.load()) {
+        int ready = ::poll(&poll_fd, 1, dirty ? debounce_ms_ : IDLE_POLL_MS);
+        if (ready > 0) {
+            dirty = drainEvents(inotify_fd_, file_name_) || dirty;
+        } else if (ready == 0 && dirty) {
+            // Quiet for a full debounce interval since the last event: the writer is done.
+            dirty = false;
+            reloadNow();
+        } else if (ready == 0) {
+            reclaim();
+        }
+    }
+}
+
+/**
+ * Deletes every retired kitchen that no pinned reader can still hold.
+ */
+void MenuWatcher::reclaim() {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    if (retired_.empty()) {
+        return;
+    }
+    uint64_t oldest = UINT64_MAX;
+    for (const ReaderSlot& slot : slots_) {
+        uint64_t epoch = slot.epoch.load();
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    size_t kept = 0;
+    for (const auto& entry : retired_) {
+        // A reader in epoch e may hold anything replaced in a later epoch, but nothing replaced at or before e.
+        if (entry.second <= oldest) {
+            KITCHEN_TRACE_SCOPE("MenuWatcher::retire");
+            delete entry.first->kitchen;
+            delete entry.first;
+        } else {
+            retired_[kept++] = entry;
+        }
+    }
+    retired_.resize(kept);
+}
+
+/**
+ * Makes `kitchen` the current version and retires the previous one.
+ */
+void MenuWatcher::publish(Kitchen* kitchen) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    Published* current = current_.load();
+    Published* next = new Published{kitchen, current == nullptr ? 1 : current->version + 1};
+    Published* previous = current_.exchange(next);
+    // Readers that pin from now on record an epoch above the retirement epoch and read `next`.
+    uint64_t retired_in = epoch_.fetch_add(1) + 1;
+    if (previous != nullptr) {
+        retired_.emplace_back(previous, retired_in);
+    }
+    KITCHEN_COUNTER_ADD("menuwatcher.reloads", 1);
+}
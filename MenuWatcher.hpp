@@ -0,0 +1,153 @@
+/**
+ * @file MenuWatcher.hpp
+ * @brief This file contains the declaration of the MenuWatcher class, which serves a live Kitchen built from a
+ * menu CSV and swaps in a freshly built one whenever the file changes.
+ *
+ * A background thread watches the file's directory with inotify (so editors that save by renaming a temporary
+ * file are seen too), waits for writes to settle, builds a new Kitchen off the hot path and publishes it with a
+ * single atomic pointer exchange. Readers pin the current version with pin(), which never takes a lock: it
+ * claims a reader slot with one compare-and-swap, records the global epoch in it and loads the pointer.
+ *
+ * Replaced kitchens are retired with the epoch in which they were replaced and deleted by the watcher thread
+ * once every pinned reader entered a later epoch, so a reader never sees its kitchen freed underneath it and
+ * never pays for the deletion.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef MENU_WATCHER_HPP
+#define MENU_WATCHER_HPP
+
+#include "Kitchen.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class MenuWatcher {
+    public:
+        static const int MAX_READERS = 64;
+
+        /**
+         * A reader's hold on one published Kitchen. The kitchen stays alive until the pin is destroyed.
+         */
+        class Pin {
+            public:
+                Pin(Pin&& other) noexcept;
+                Pin(const Pin&) = delete;
+                Pin& operator=(const Pin&) = delete;
+                Pin& operator=(Pin&&) = delete;
+                ~Pin();
+
+                const Kitchen* operator->() const {
+                    return kitchen_;
+                }
+
+                const Kitchen& operator*() const {
+                    return *kitchen_;
+                }
+
+                /**
+                 * @return The version of the pinned kitchen; the first load is version 1.
+                 */
+                uint64_t version() const {
+                    return version_;
+                }
+
+            private:
+                friend class MenuWatcher;
+                Pin(const MenuWatcher* watcher, const int& slot);
+
+                const MenuWatcher* watcher_;
+                int slot_;
+                const Kitchen* kitchen_;
+                uint64_t version_;
+        };
+
+        /**
+         * @param path The menu CSV to serve and watch.
+         * @param debounce_ms How long the file must stay quiet after a change before it is reloaded.
+         */
+        explicit MenuWatcher(const std::string& path, const int& debounce_ms = 50);
+
+        /**
+         * Destructor.
+         * @post Stops the watcher thread and deletes every kitchen.
+         * @pre No Pin is still alive.
+         */
+        ~MenuWatcher();
+
+        MenuWatcher(const MenuWatcher&) = delete;
+        MenuWatcher& operator=(const MenuWatcher&) = delete;
+
+        /**
+         * Loads the menu and starts watching it.
+         * @return False if the file cannot be read or inotify is unavailable.
+         */
+        bool start();
+
+        /**
+         * Stops watching. The last published kitchen stays available to pin().
+         */
+        void stop();
+
+        /**
+         * Pins the current kitchen without locking.
+         * @pre start() succeeded.
+         */
+        Pin pin() const;
+
+        /**
+         * Builds a new kitchen from the file and publishes it. The watcher thread calls this on every change;
+         * it may also be called directly.
+         * @return False if the file could not be opened, in which case the current kitchen stays published.
+         */
+        bool reloadNow();
+
+        /**
+         * @return The version of the most recently published kitchen.
+         */
+        uint64_t version() const;
+
+        /**
+         * @return The number of replaced kitchens not yet deleted.
+         */
+        size_t retiredCount() const;
+
+    private:
+        struct alignas(64) ReaderSlot {
+            // 0 when free, otherwise the epoch the reader pinned in.
+            std::atomic<uint64_t> epoch;
+        };
+
+        struct Published {
+            Kitchen* kitchen;
+            uint64_t version;
+        };
+
+        void watchLoop();
+        void reclaim();
+        void publish(Kitchen* kitchen);
+
+        std::string path_;
+        std::string directory_;
+        std::string file_name_;
+        int debounce_ms_;
+        int inotify_fd_;
+        std::atomic<bool> running_;
+        std::thread thread_;
+
+        std::atomic<Published*> current_;
+        std::atomic<uint64_t> epoch_;
+        mutable ReaderSlot slots_[MAX_READERS];
+
+        mutable std::mutex writer_mutex_;   // Serializes publish() and reclaim().
+        // Replaced versions and the epoch in which they were replaced.
+        std::vector<std::pair<Published*, uint64_t>> retired_;
+};
+
+#endif // MENU_WATCHER_HPP
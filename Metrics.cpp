@@ -0,0 +1,288 @@
+/**
+ * @file Metrics.cpp
+ * @brief This file contains the implementation of the MetricsRegistry class and its counters, gauges and
+ * histograms.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Metrics.hpp"
+#include <algorithm>
+
+namespace {
+    /**
+     * @return The histogram bucket for `value`: 0 for 0, otherwise one more than the index of its highest set bit.
+     */
+    int bucketOf(uint64_t value) {
+        int bucket = 0;
+        while (value != 0 && bucket < MetricsRegistry::BUCKET_COUNT - 1) {
+            value >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    /**
+     * Writes `text` as a JSON string literal. Metric names are plain identifiers, so only quotes and
+     * backslashes need escaping.
+     */
+    void writeJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\';
+            }
+            out << c;
+        }
+        out << '"';
+    }
+}
+
+MetricsRegistry::Counter::Counter() {
+    reset();
+}
+
+/**
+ * Adds `n` to the calling thread's shard.
+ */
+void MetricsRegistry::Counter::add(const int64_t& n) {
+    shards_[shardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+}
+
+/**
+ * @return The sum of every shard.
+ */
+int64_t MetricsRegistry::Counter::value() const {
+    int64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void MetricsRegistry::Counter::reset() {
+    for (Shard& shard : shards_) {
+        shard.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+MetricsRegistry::Gauge::Gauge() : value_(0) {}
+
+void MetricsRegistry::Gauge::set(const int64_t& value) {
+    value_.store(value, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Gauge::add(const int64_t& delta) {
+    value_.fetch_add(delta, std::memory_order_relaxed);
+}
+
+int64_t MetricsRegistry::Gauge::value() const {
+    return value_.load(std::memory_order_relaxed);
+}
+
+MetricsRegistry::Histogram::Histogram() {
+    reset();
+}
+
+/**
+ * Records one value in the calling thread's shard.
+ */
+void MetricsRegistry::Histogram::record(const uint64_t& value) {
+    Shard& shard = shards_[shardIndex()];
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+    shard.buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    // Only the owning thread raises its shard's max in the common case, so this rarely loops.
+    uint64_t seen = shard.max.load(std::memory_order_relaxed);
+    while (value > seen && !shard.max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t MetricsRegistry::Histogram::count() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t MetricsRegistry::Histogram::sum() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.sum.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t MetricsRegistry::Histogram::max() const {
+    uint64_t largest = 0;
+    for (const Shard& shard : shards_) {
+        largest = std::max(largest, shard.max.load(std::memory_order_relaxed));
+    }
+    return largest;
+}
+
+/**
+ * @param fraction A percentile as a fraction in [0, 1].
+ * @return The upper bound of the bucket containing that percentile, or 0 if nothing was recorded.
+ */
+uint64_t MetricsRegistry::Histogram::percentile(const double& fraction) const {
+    uint64_t buckets[BUCKET_COUNT] = {};
+    uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            uint64_t n = shard.buckets[b].load(std::memory_order_relaxed);
+            buckets[b] += n;
+            total += n;
+        }
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * total + 0.5));
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            uint64_t upper = b == 0 ? 0 : (uint64_t(1) << b) - 1;
+            return std::min(upper, max());
+        }
+    }
+    return max();
+}
+
+void MetricsRegistry::Histogram::reset() {
+    for (Shard& shard : shards_) {
+        shard.count.store(0, std::memory_order_relaxed);
+        shard.sum.store(0, std::memory_order_relaxed);
+        shard.max.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t>& bucket : shard.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+MetricsRegistry::ScopedTimer::ScopedTimer(Histogram& histogram)
+    : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+
+MetricsRegistry::ScopedTimer::~ScopedTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    histogram_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+MetricsRegistry::MetricsRegistry() {}
+
+/**
+ * @return The process-wide registry.
+ */
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+/**
+ * @return The shard the calling thread writes to.
+ */
+int MetricsRegistry::shardIndex() {
+    static std::atomic<int> next_shard(0);
+    thread_local int shard = next_shard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return shard;
+}
+
+/**
+ * @return The metric called `name`, created on first use. References stay valid for the life of the
+ * program.
+ */
+MetricsRegistry::Counter& MetricsRegistry::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<Counter>& slot = counters_[name];
+    if (!slot) {
+        slot.reset(new Counter());
+    }
+    return *slot;
+}
+
+MetricsRegistry::Gauge& MetricsRegistry::gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<Gauge>& slot = gauges_[name];
+    if (!slot) {
+        slot.reset(new Gauge());
+    }
+    return *slot;
+}
+
+MetricsRegistry::Histogram& MetricsRegistry::histogram(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<Histogram>& slot = histograms_[name];
+    if (!slot) {
+        slot.reset(new Histogram());
+    }
+    return *slot;
+}
+
+/**
+ * Prints every metric, sorted by name.
+ * @param out The stream to print to.
+ * @param format TEXT for one metric per line, JSON for a single object.
+ */
+void MetricsRegistry::snapshot(std::ostream& out, const Format& format) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (format == TEXT) {
+        for (const auto& entry : counters_) {
+            out << "counter " << entry.first << " " << entry.second->value() << std::endl;
+        }
+        for (const auto& entry : gauges_) {
+            out << "gauge " << entry.first << " " << entry.second->value() << std::endl;
+        }
+        for (const auto& entry : histograms_) {
+            const Histogram& h = *entry.second;
+            out << "histogram " << entry.first << " count=" << h.count() << " sum=" << h.sum()
+                << " p50=" << h.percentile(0.50) << " p90=" << h.percentile(0.90)
+                << " p99=" << h.percentile(0.99) << " max=" << h.max() << std::endl;
+        }
+        return;
+    }
+
+    out << "{\"counters\": {";
+    bool first = true;
+    for (const auto& entry : counters_) {
+        out << (first ? "" : ", ");
+        writeJsonString(out, entry.first);
+        out << ": " << entry.second->value();
+        first = false;
+    }
+    out << "}, \"gauges\": {";
+    first = true;
+    for (const auto& entry : gauges_) {
+        out << (first ? "" : ", ");
+        writeJsonString(out, entry.first);
+        out << ": " << entry.second->value();
+        first = false;
+    }
+    out << "}, \"histograms\": {";
+    first = true;
+    for (const auto& entry : histograms_) {
+        const Histogram& h = *entry.second;
+        out << (first ? "" : ", ");
+        writeJsonString(out, entry.first);
+        out << ": {\"count\": " << h.count() << ", \"sum\": " << h.sum() << ", \"p50\": " << h.percentile(0.50)
+            << ", \"p90\": " << h.percentile(0.90) << ", \"p99\": " << h.percentile(0.99)
+            << ", \"max\": " << h.max() << "}";
+        first = false;
+    }
+    out << "}}" << std::endl;
+}
+
+/**
+ * Zeroes every counter and histogram. Gauges keep their values.
+ */
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : counters_) {
+        entry.second->reset();
+    }
+    for (auto& entry : histograms_) {
+        entry.second->reset();
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * @file Metrics.hpp
+ * @brief This file contains the declaration of the MetricsRegistry class, a low-overhead counter, gauge and
+ * latency histogram registry used to instrument Kitchen.
+ *
+ * Instrumentation is compiled in only when KITCHEN_METRICS is defined (`make rebuild METRICS=1`). Without it,
+ * every KITCHEN_* macro below expands to nothing, so the hot paths are unchanged. The registry itself is always
+ * available and simply stays empty.
+ *
+ * Counters and histograms are sharded: each thread is assigned one of SHARD_COUNT cache-line-sized slots and
+ * only ever increments its own slot with a relaxed atomic add, so concurrent writers do not contend. Reading
+ * sums the shards. Each macro looks its metric up once, through a function-local static, so the registry's
+ * mutex is only taken the first time a call site runs.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+class MetricsRegistry {
+    public:
+        static const int SHARD_COUNT = 16;
+        static const int BUCKET_COUNT = 64;
+
+        /**
+         * @enum Format
+         * @brief How snapshot() prints the registry.
+         */
+        enum Format { TEXT, JSON };
+
+        /**
+         * A monotonically increasing count, e.g. the number of rejected adds.
+         */
+        class Counter {
+            public:
+                Counter();
+                /**
+                 * Adds `n` to the calling thread's shard.
+                 */
+                void add(const int64_t& n = 1);
+                /**
+                 * @return The sum of every shard.
+                 */
+                int64_t value() const;
+                void reset();
+
+            private:
+                struct alignas(64) Shard {
+                    std::atomic<int64_t> value;
+                };
+                Shard shards_[SHARD_COUNT];
+        };
+
+        /**
+         * A value that can go up and down, e.g. the number of dishes in a kitchen. Gauges hold the last value
+         * set, so they are not sharded.
+         */
+        class Gauge {
+            public:
+                Gauge();
+                void set(const int64_t& value);
+                void add(const int64_t& delta);
+                int64_t value() const;
+
+            private:
+                std::atomic<int64_t> value_;
+        };
+
+        /**
+         * A distribution of non-negative values (usually nanoseconds) in power-of-two buckets: bucket b holds
+         * values v with 2^(b-1) <= v < 2^b, and bucket 0 holds 0.
+         */
+        class Histogram {
+            public:
+                Histogram();
+                /**
+                 * Records one value in the calling thread's shard.
+                 */
+                void record(const uint64_t& value);
+                uint64_t count() const;
+                uint64_t sum() const;
+                uint64_t max() const;
+                /**
+                 * @param fraction A percentile as a fraction in [0, 1].
+                 * @return The upper bound of the bucket containing that percentile, or 0 if nothing was recorded.
+                 */
+                uint64_t percentile(const double& fraction) const;
+                void reset();
+
+            private:
+                struct alignas(64) Shard {
+                    std::atomic<uint64_t> count;
+                    std::atomic<uint64_t> sum;
+                    std::atomic<uint64_t> max;
+                    std::atomic<uint64_t> buckets[BUCKET_COUNT];
+                };
+                Shard shards_[SHARD_COUNT];
+        };
+
+        /**
+         * Records the time between its construction and destruction, in nanoseconds, into a histogram.
+         */
+        class ScopedTimer {
+            public:
+                explicit ScopedTimer(Histogram& histogram);
+                ~ScopedTimer();
+
+            private:
+                Histogram& histogram_;
+                std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * @return The process-wide registry.
+         */
+        static MetricsRegistry& instance();
+
+        /**
+         * @return The metric called `name`, created on first use. References stay valid for the life of the
+         * program.
+         */
+        Counter& counter(const std::string& name);
+        Gauge& gauge(const std::string& name);
+        Histogram& histogram(const std::string& name);
+
+        /**
+         * Prints every metric, sorted by name.
+         * @param out The stream to print to.
+         * @param format TEXT for one metric per line, JSON for a single object.
+         */
+        void snapshot(std::ostream& out, const Format& format) const;
+
+        /**
+         * Zeroes every counter and histogram. Gauges keep their values.
+         */
+        void reset();
+
+        /**
+         * @return The shard the calling thread writes to.
+         */
+        static int shardIndex();
+
+    private:
+        MetricsRegistry();
+
+        mutable std::mutex mutex_;
+        std::map<std::string, std::unique_ptr<Counter>> counters_;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges_;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms_;
+};
+
+#define KITCHEN_METRICS_CONCAT_(a, b) a##b
+#define KITCHEN_METRICS_CONCAT(a, b) KITCHEN_METRICS_CONCAT_(a, b)
+
+#ifdef KITCHEN_METRICS
+#define KITCHEN_COUNTER_ADD(name, n) \
+    do { \
+        static MetricsRegistry::Counter& kitchen_counter_ = MetricsRegistry::instance().counter(name); \
+        kitchen_counter_.add(n); \
+    } while (0)
+#define KITCHEN_GAUGE_SET(name, v) \
+    do { \
+        static MetricsRegistry::Gauge& kitchen_gauge_ = MetricsRegistry::instance().gauge(name); \
+        kitchen_gauge_.set(v); \
+    } while (0)
+#define KITCHEN_HISTOGRAM_RECORD(name, v) \
+    do { \
+        static MetricsRegistry::Histogram& kitchen_histogram_ = MetricsRegistry::instance().histogram(name); \
+        kitchen_histogram_.record(v); \
+    } while (0)
+#define KITCHEN_TIME_SCOPE(name) \
+    static MetricsRegistry::Histogram& KITCHEN_METRICS_CONCAT(kitchen_timer_histogram_, __LINE__) = \
+        MetricsRegistry::instance().histogram(name); \
+    MetricsRegistry::ScopedTimer KITCHEN_METRICS_CONCAT(kitchen_timer_, __LINE__)( \
+        KITCHEN_METRICS_CONCAT(kitchen_timer_histogram_, __LINE__))
+#else
+#define KITCHEN_COUNTER_ADD(name, n) do {} while (0)
+#define KITCHEN_GAUGE_SET(name, v) do {} while (0)
+#define KITCHEN_HISTOGRAM_RECORD(name, v) do {} while (0)
+#define KITCHEN_TIME_SCOPE(name) do {} while (0)
+#endif
+
+#endif // METRICS_HPP
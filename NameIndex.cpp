@@ -0,0 +1,258 @@
+/**
+ * @file NameIndex.cpp
+ * @brief This file contains the implementation of the NameIndex class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "NameIndex.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    const uint32_t ROOT = 0;
+}
+
+NameIndex::NameIndex() {
+    nodes_.push_back({NONE, NONE, NONE, 0, -1, 0});
+}
+
+/**
+ * Indexes `dish` under its current name. A name with characters Dish::setName() would reject is not indexed.
+ * @pre The dish is not already indexed.
+ */
+void NameIndex::insert(Dish* dish) {
+    std::string name = dish->getName();
+    for (char c : name) {
+        if (symbolOf(c) == INVALID) {
+            return;
+        }
+    }
+    uint32_t node = ROOT;
+    nodes_[ROOT].count++;
+    for (char c : name) {
+        uint8_t symbol = symbolOf(c);
+        // Find the child, or the sibling to link a new child after, keeping siblings sorted by symbol.
+        uint32_t previous = NONE;
+        uint32_t next = nodes_[node].first_child;
+        while (next != NONE && nodes_[next].symbol < symbol) {
+            previous = next;
+            next = nodes_[next].next_sibling;
+        }
+        if (next == NONE || nodes_[next].symbol != symbol) {
+            uint32_t created = static_cast<uint32_t>(nodes_.size());
+            nodes_.push_back({NONE, next, node, 0, -1, symbol});
+            if (previous == NONE) {
+                nodes_[node].first_child = created;
+            } else {
+                nodes_[previous].next_sibling = created;
+            }
+            next = created;
+        }
+        node = next;
+        nodes_[node].count++;
+    }
+    if (nodes_[node].terminal < 0) {
+        nodes_[node].terminal = static_cast<int32_t>(terminals_.size());
+        terminals_.emplace_back();
+    }
+    terminals_[nodes_[node].terminal].push_back(dish);
+    node_of_[dish] = node;
+}
+
+/**
+ * Removes `dish`, whatever its name is now. Does nothing if it is not indexed.
+ */
+void NameIndex::erase(Dish* dish) {
+    auto found = node_of_.find(dish);
+    if (found == node_of_.end()) {
+        return;
+    }
+    uint32_t node = found->second;
+    node_of_.erase(found);
+    std::vector<Dish*>& dishes = terminals_[nodes_[node].terminal];
+    dishes.erase(std::find(dishes.begin(), dishes.end(), dish));
+    for (; node != NONE; node = nodes_[node].parent) {
+        nodes_[node].count--;
+    }
+}
+
+/**
+ * @return The number of indexed dishes.
+ */
+size_t NameIndex::size() const {
+    return nodes_[ROOT].count;
+}
+
+/**
+ * @return The dishes named `name`, ignoring case.
+ */
+std::vector<Dish*> NameIndex::exact(const std::string& name) const {
+    uint32_t node = descend(name);
+    if (node == NONE || nodes_[node].terminal < 0) {
+        return {};
+    }
+    return terminals_[nodes_[node].terminal];
+}
+
+/**
+ * @param limit The most dishes to return.
+ * @return Dishes whose names start with `prefix`, ignoring case, in alphabetical order of name.
+ */
+std::vector<Dish*> NameIndex::prefix(const std::string& prefix, const size_t& limit) const {
+    KITCHEN_TIME_SCOPE("names.prefix.ns");
+    std::vector<Dish*> out;
+    uint32_t node = descend(prefix);
+    if (node != NONE) {
+        collect(node, out, limit);
+    }
+    return out;
+}
+
+/**
+ * @return The number of dishes whose names start with `prefix`, ignoring case, found without visiting them.
+ */
+size_t NameIndex::countPrefix(const std::string& prefix) const {
+    uint32_t node = descend(prefix);
+    return node == NONE ? 0 : nodes_[node].count;
+}
+
+/**
+ * @param max_distance The most single-character insertions, deletions and substitutions allowed.
+ * @param limit The most dishes to return.
+ * @return Dishes whose names are within `max_distance` edits of `query`, ignoring case, closest first and
+ * alphabetical among equals.
+ */
+std::vector<NameIndex::Match> NameIndex::fuzzy(const std::string& query, const int& max_distance,
+                                               const size_t& limit) const {
+    KITCHEN_TIME_SCOPE("names.fuzzy.ns");
+    std::vector<uint8_t> symbols;
+    for (char c : query) {
+        // A character no name can hold still occupies a position, so it costs an edit against anything.
+        symbols.push_back(symbolOf(c));
+    }
+    size_t width = symbols.size() + 1;
+    std::vector<int> rows(width);
+    for (size_t j = 0; j < width; j++) {
+        rows[j] = static_cast<int>(j);
+    }
+    // Widening the bound one edit at a time stops as soon as `limit` of the closest names are found, instead
+    // of enumerating every name within max_distance; each walk costs a fraction of the next, wider one.
+    std::vector<Match> out;
+    for (int bound = 0; bound <= max_distance; bound++) {
+        out.clear();
+        if (nodes_[ROOT].terminal >= 0 && rows[width - 1] <= bound) {
+            for (Dish* dish : terminals_[nodes_[ROOT].terminal]) {
+                out.push_back({dish, rows[width - 1]});
+            }
+        }
+        fuzzyFrom(ROOT, 0, symbols, bound, rows, out);
+        if (out.size() >= limit) {
+            break;
+        }
+    }
+    // The walk found names in alphabetical order, so a stable sort by distance keeps that order among equals.
+    std::stable_sort(out.begin(), out.end(), [](const Match& a, const Match& b) { return a.distance < b.distance; });
+    if (out.size() > limit) {
+        out.resize(limit);
+    }
+    return out;
+}
+
+/**
+ * @return The symbol of `c`: 0 for whitespace, 1 to 26 for a letter of either case, INVALID otherwise.
+ */
+uint8_t NameIndex::symbolOf(const char& c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    if (std::isalpha(u)) {
+        return static_cast<uint8_t>(std::tolower(u) - 'a' + 1);
+    }
+    return std::isspace(u) ? 0 : INVALID;
+}
+
+/**
+ * @return The child of `node` with `symbol`, or NONE.
+ */
+uint32_t NameIndex::child(const uint32_t& node, const uint8_t& symbol) const {
+    uint32_t next = nodes_[node].first_child;
+    while (next != NONE && nodes_[next].symbol < symbol) {
+        next = nodes_[next].next_sibling;
+    }
+    return next != NONE && nodes_[next].symbol == symbol ? next : NONE;
+}
+
+/**
+ * @return The node spelling `text`, or NONE if no indexed name ever started with it.
+ */
+uint32_t NameIndex::descend(const std::string& text) const {
+    uint32_t node = ROOT;
+    for (char c : text) {
+        uint8_t symbol = symbolOf(c);
+        if (symbol == INVALID) {
+            return NONE;
+        }
+        node = child(node, symbol);
+        if (node == NONE) {
+            return NONE;
+        }
+    }
+    return node;
+}
+
+/**
+ * Appends up to `limit` dishes at and below `node` to `out`, in alphabetical order.
+ */
+void NameIndex::collect(const uint32_t& node, std::vector<Dish*>& out, const size_t& limit) const {
+    if (nodes_[node].terminal >= 0) {
+        for (Dish* dish : terminals_[nodes_[node].terminal]) {
+            if (out.size() == limit) {
+                return;
+            }
+            out.push_back(dish);
+        }
+    }
+    for (uint32_t next = nodes_[node].first_child; next != NONE && out.size() < limit;
+         next = nodes_[next].next_sibling) {
+        if (nodes_[next].count > 0) {
+            collect(next, out, limit);
+        }
+    }
+}
+
+/**
+ * Continues a fuzzy search into the children of `node`, at `depth`, whose Levenshtein row is row `depth` of
+ * `rows`.
+ */
+void NameIndex::fuzzyFrom(const uint32_t& node, const size_t& depth, const std::vector<uint8_t>& query,
+                          const int& max_distance, std::vector<int>& rows, std::vector<Match>& out) const {
+    size_t width = query.size() + 1;
+    if (rows.size() < (depth + 2) * width) {
+        rows.resize((depth + 2) * width);
+    }
+    for (uint32_t next = nodes_[node].first_child; next != NONE; next = nodes_[next].next_sibling) {
+        const Node& current = nodes_[next];
+        if (current.count == 0) {
+            continue;
+        }
+        const int* above = &rows[depth * width];
+        int* row = &rows[(depth + 1) * width];
+        row[0] = above[0] + 1;
+        int best = row[0];
+        for (size_t j = 1; j < width; j++) {
+            int substitute = above[j - 1] + (query[j - 1] != current.symbol);
+            row[j] = std::min(std::min(above[j] + 1, row[j - 1] + 1), substitute);
+            best = std::min(best, row[j]);
+        }
+        if (current.terminal >= 0 && row[width - 1] <= max_distance) {
+            for (Dish* dish : terminals_[current.terminal]) {
+                out.push_back({dish, row[width - 1]});
+            }
+        }
+        // Entries only grow along a branch, so once none is within the distance no descendant can be.
+        if (best <= max_distance) {
+            fuzzyFrom(next, depth + 1, query, max_distance, rows, out);
+        }
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file NameIndex.hpp
+ * @brief This file contains the declaration of the NameIndex class, a case-insensitive trie over dish names
+ * for exact lookup, prefix autocomplete and bounded edit-distance (fuzzy) search.
+ *
+ * Dish::setName() only accepts letters and whitespace, so after folding case and treating every whitespace
+ * character as a space a name is a word over 27 symbols, and one byte per trie edge is enough. Nodes live in
+ * one vector and refer to each other by position: each keeps its children as a sibling list sorted by symbol,
+ * its parent, and the number of indexed dishes in its subtree, which lets searches skip emptied branches.
+ *
+ * Fuzzy search walks the trie with one row of the Levenshtein table per node, computed from the parent's row,
+ * so names sharing a prefix share that work, and abandons a branch as soon as every entry of its row exceeds
+ * the allowed distance; this is the Levenshtein automaton for the query, run over the trie.
+ *
+ * Serving a dish removes it from its node but keeps the node, so the trie holds every distinct name ever
+ * indexed; a name that returns reuses its nodes.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef NAME_INDEX_HPP
+#define NAME_INDEX_HPP
+
+#include "Dish.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class NameIndex {
+    public:
+        /**
+         * @struct Match
+         * @brief A fuzzy search result.
+         */
+        struct Match {
+            Dish* dish;
+            int distance;
+        };
+
+        NameIndex();
+
+        /**
+         * Indexes `dish` under its current name. A name with characters Dish::setName() would reject is not
+         * indexed.
+         * @pre The dish is not already indexed.
+         */
+        void insert(Dish* dish);
+
+        /**
+         * Removes `dish`, whatever its name is now. Does nothing if it is not indexed.
+         */
+        void erase(Dish* dish);
+
+        /**
+         * @return The number of indexed dishes.
+         */
+        size_t size() const;
+
+        /**
+         * @return The dishes named `name`, ignoring case.
+         */
+        std::vector<Dish*> exact(const std::string& name) const;
+
+        /**
+         * @param limit The most dishes to return.
+         * @return Dishes whose names start with `prefix`, ignoring case, in alphabetical order of name.
+         */
+        std::vector<Dish*> prefix(const std::string& prefix, const size_t& limit) const;
+
+        /**
+         * @return The number of dishes whose names start with `prefix`, ignoring case, found without visiting
+         * them.
+         */
+        size_t countPrefix(const std::string& prefix) const;
+
+        /**
+         * @param max_distance The most single-character insertions, deletions and substitutions allowed.
+         * @param limit The most dishes to return.
+         * @return Dishes whose names are within `max_distance` edits of `query`, ignoring case, closest first
+         * and alphabetical among equals.
+         */
+        std::vector<Match> fuzzy(const std::string& query, const int& max_distance, const size_t& limit) const;
+
+    private:
+        static const uint32_t NONE = UINT32_MAX;
+        static const uint8_t INVALID = UINT8_MAX;
+
+        struct Node {
+            uint32_t first_child;
+            uint32_t next_sibling;
+            uint32_t parent;
+            uint32_t count;         // Indexed dishes at this node and below.
+            int32_t terminal;       // Position in terminals_ of the dishes with exactly this name, or -1.
+            uint8_t symbol;
+        };
+
+        /**
+         * @return The symbol of `c`: 0 for whitespace, 1 to 26 for a letter of either case, INVALID otherwise.
+         */
+        static uint8_t symbolOf(const char& c);
+
+        /**
+         * @return The child of `node` with `symbol`, or NONE.
+         */
+        uint32_t child(const uint32_t& node, const uint8_t& symbol) const;
+
+        /**
+         * @return The node spelling `text`, or NONE if no indexed name ever started with it.
+         */
+        uint32_t descend(const std::string& text) const;
+
+        /**
+         * Appends up to `limit` dishes at and below `node` to `out`, in alphabetical order.
+         */
+        void collect(const uint32_t& node, std::vector<Dish*>& out, const size_t& limit) const;
+
+        /**
+         * Continues a fuzzy search into the children of `node`, at `depth`, whose Levenshtein row is row
+         * `depth` of `rows`.
+         */
+        void fuzzyFrom(const uint32_t& node, const size_t& depth, const std::vector<uint8_t>& query,
+                       const int& max_distance, std::vector<int>& rows, std::vector<Match>& out) const;
+
+        std::vector<Node> nodes_;
+        std::vector<std::vector<Dish*>> terminals_;
+        std::unordered_map<const Dish*, uint32_t> node_of_;
+};
+
+#endif // NAME_INDEX_HPP
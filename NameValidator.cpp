@@ -0,0 +1,98 @@
+/**
+ * @file NameValidator.cpp
+ * @brief This file contains the implementation of the NameValidator class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "NameValidator.hpp"
+#include <array>
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+    constexpr std::array<bool, 256> makeNameTable() {
+        std::array<bool, 256> table{};
+        for (int c = 'A'; c <= 'Z'; c++) {
+            table[c] = true;
+            table[c - 'A' + 'a'] = true;
+        }
+        for (int c = '\t'; c <= '\r'; c++) {
+            table[c] = true;
+        }
+        table[' '] = true;
+        return table;
+    }
+
+    // NAME_CHARACTERS[c] is std::isalpha(c) || std::isspace(c) in the "C" locale.
+    constexpr std::array<bool, 256> NAME_CHARACTERS = makeNameTable();
+
+    /**
+     * @return The position of the first invalid byte of the `size` at `begin`, starting at `position`, or
+     * `size` if there is none.
+     */
+    size_t scanTable(const unsigned char* begin, const size_t& size, size_t position) {
+        while (position < size && NAME_CHARACTERS[begin[position]]) {
+            position++;
+        }
+        return position;
+    }
+}
+
+/**
+ * @return True if every character of `name` is a letter or whitespace; true for an empty name, as
+ * Dish::isValidName().
+ */
+bool NameValidator::isValid(const std::string_view& name) {
+    return firstInvalid(name) == std::string_view::npos;
+}
+
+/**
+ * @return The position of the first character that is neither a letter nor whitespace, or
+ * std::string_view::npos if there is none.
+ */
+size_t NameValidator::firstInvalid(const std::string_view& name) {
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(name.data());
+    size_t size = name.size();
+    size_t position = 0;
+#ifdef __SSE2__
+    // Setting bit 0x20 folds A-Z onto a-z without moving any other byte into a-z. The comparisons are signed,
+    // so bytes from 0x80 up are negative and fall outside every range.
+    const __m128i fold = _mm_set1_epi8(0x20);
+    const __m128i before_a = _mm_set1_epi8('a' - 1);
+    const __m128i after_z = _mm_set1_epi8('z' + 1);
+    const __m128i before_tab = _mm_set1_epi8('\t' - 1);
+    const __m128i after_return = _mm_set1_epi8('\r' + 1);
+    const __m128i space = _mm_set1_epi8(' ');
+    for (; position + 16 <= size; position += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        __m128i folded = _mm_or_si128(bytes, fold);
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, before_a), _mm_cmplt_epi8(folded, after_z));
+        __m128i control = _mm_and_si128(_mm_cmpgt_epi8(bytes, before_tab), _mm_cmplt_epi8(bytes, after_return));
+        __m128i valid = _mm_or_si128(_mm_or_si128(letter, control), _mm_cmpeq_epi8(bytes, space));
+        int mask = _mm_movemask_epi8(valid);
+        if (mask != 0xFFFF) {
+            return position + __builtin_ctz(~mask);
+        }
+    }
+#endif
+    position = scanTable(data, size, position);
+    return position == size ? std::string_view::npos : position;
+}
+
+/**
+ * Checks a column of names in one pass.
+ * @return The indices in `names` of the invalid ones, in order.
+ */
+std::vector<size_t> NameValidator::findInvalid(const std::vector<std::string_view>& names) {
+    std::vector<size_t> invalid;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (!isValid(names[i])) {
+            invalid.push_back(i);
+        }
+    }
+    return invalid;
+}
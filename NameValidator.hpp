@@ -0,0 +1,49 @@
+/**
+ * @file NameValidator.hpp
+ * @brief This file contains the declaration of the NameValidator class, which checks dish names without going
+ * through the locale.
+ *
+ * A dish name is valid if every character is a letter or whitespace as the "C" locale defines them: A-Z, a-z,
+ * space, and the controls \t \n \v \f \r. std::isalpha and std::isspace answer that one character at a time
+ * through a locale lookup; here each byte is one load from a 256-entry table, and where SSE2 is available
+ * (every x86-64 CPU), sixteen bytes are range-checked at once, so a long name costs a few instructions per
+ * sixteen characters.
+ *
+ * findInvalid() checks a whole column of names in one pass, for loaders that report bad names in bulk rather
+ * than letting Dish::setName() turn them into "UNKNOWN" one by one. The Kitchen loader builds dishes row by
+ * row, so it leaves the check to the Dish constructor alone and rejects the rows whose name came back as
+ * "UNKNOWN"; no name is checked twice.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef NAME_VALIDATOR_HPP
+#define NAME_VALIDATOR_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+class NameValidator {
+    public:
+        /**
+         * @return True if every character of `name` is a letter or whitespace; true for an empty name, as
+         * Dish::isValidName().
+         */
+        static bool isValid(const std::string_view& name);
+
+        /**
+         * @return The position of the first character that is neither a letter nor whitespace, or
+         * std::string_view::npos if there is none.
+         */
+        static size_t firstInvalid(const std::string_view& name);
+
+        /**
+         * Checks a column of names in one pass.
+         * @return The indices in `names` of the invalid ones, in order.
+         */
+        static std::vector<size_t> findInvalid(const std::vector<std::string_view>& names);
+};
+
+#endif // NAME_VALIDATOR_HPP
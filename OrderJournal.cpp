@@ -0,0 +1,590 @@
+/**
+ * @file OrderJournal.cpp
+ * @brief This file contains the implementation of the OrderJournal class: record framing, the group-commit
+ * flusher, checkpointing and replay.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "OrderJournal.hpp"
+#include "CatalogSnapshot.hpp"
+#include "DietaryViews.hpp"
+#include "DishCodec.hpp"
+#include "Kitchen.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <typeinfo>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const char MAGIC[8] = {'K', 'J', 'O', 'U', 'R', 'N', 'A', 'L'};
+    const size_t HEADER_SIZE = sizeof(MAGIC) + sizeof(uint64_t);
+    const size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint8_t);
+    const uint32_t MAX_PAYLOAD_SIZE = 1 << 24;
+
+    struct Crc32Table {
+        uint32_t entries[256];
+
+        Crc32Table() {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+                }
+                entries[i] = crc;
+            }
+        }
+    };
+
+    const Crc32Table crc_table;
+
+    /**
+     * Continues a CRC-32 (IEEE) over `size` more bytes. Start with crc = 0.
+     */
+    uint32_t crc32(uint32_t crc, const char* data, const size_t& size) {
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) {
+            crc = crc_table.entries[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    uint32_t recordChecksum(const char* payload, const size_t& size, const uint64_t& sequence, const uint8_t& op) {
+        uint32_t crc = crc32(0, payload, size);
+        crc = crc32(crc, reinterpret_cast<const char*>(&sequence), sizeof(sequence));
+        return crc32(crc, reinterpret_cast<const char*>(&op), sizeof(op));
+    }
+
+    /**
+     * @struct ScanResult
+     * @brief The shape of a journal file as found by scan().
+     */
+    struct ScanResult {
+        bool valid = false;         // False if the file is missing or its header is wrong.
+        uint64_t base_sequence = 0;
+        uint64_t last_sequence = 0;
+        uint64_t records = 0;
+        size_t valid_end = 0;       // Offset just past the last valid record.
+        bool torn_tail = false;
+    };
+
+    /**
+     * Reads the whole file at `fd` and calls `visit` for each valid record, stopping at the first bad one.
+     */
+    ScanResult scan(const int& fd,
+                    const std::function<void(uint64_t, uint8_t, const char*, const char*)>& visit) {
+        ScanResult result;
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            return result;
+        }
+        std::vector<char> file(info.st_size);
+        size_t read_total = 0;
+        while (read_total < file.size()) {
+            ssize_t n = ::pread(fd, file.data() + read_total, file.size() - read_total, read_total);
+            if (n <= 0) {
+                return result;
+            }
+            read_total += static_cast<size_t>(n);
+        }
+        if (file.size() < HEADER_SIZE || std::memcmp(file.data(), MAGIC, sizeof(MAGIC)) != 0) {
+            return result;
+        }
+        result.valid = true;
+        std::memcpy(&result.base_sequence, file.data() + sizeof(MAGIC), sizeof(uint64_t));
+        result.last_sequence = result.base_sequence;
+
+        size_t offset = HEADER_SIZE;
+        while (offset + RECORD_HEADER_SIZE <= file.size()) {
+            const char* record = file.data() + offset;
+            uint32_t size, checksum;
+            uint64_t sequence;
+            uint8_t op;
+            std::memcpy(&size, record, sizeof(size));
+            std::memcpy(&checksum, record + 4, sizeof(checksum));
+            std::memcpy(&sequence, record + 8, sizeof(sequence));
+            std::memcpy(&op, record + 16, sizeof(op));
+            const char* payload = record + RECORD_HEADER_SIZE;
+            if (size > MAX_PAYLOAD_SIZE || size > file.size() - offset - RECORD_HEADER_SIZE
+                || recordChecksum(payload, size, sequence, op) != checksum || sequence <= result.last_sequence) {
+                break;
+            }
+            visit(sequence, op, payload, payload + size);
+            result.records++;
+            result.last_sequence = sequence;
+            offset += RECORD_HEADER_SIZE + size;
+        }
+        result.valid_end = offset;
+        result.torn_tail = offset != file.size();
+        return result;
+    }
+
+    bool writeAll(const int& fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = ::write(fd, data, size);
+            if (n <= 0) {
+                return false;
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * Syncs the directory holding `path`, so that a rename() into it survives a crash.
+     */
+    bool syncDirectory(const std::string& path) {
+        size_t slash = path.rfind('/');
+        std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = ::fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+    }
+
+    /**
+     * Puts an empty journal starting after `base_sequence` at `path`. The header is written to a temporary file
+     * that is then renamed over `path`, so a crash leaves either the old file or the new one, never an empty or
+     * half-written one.
+     * @param sync Whether to fsync the file and its directory.
+     * @return The new file, open for reading and appending, or -1.
+     */
+    int createJournal(const std::string& path, const uint64_t& base_sequence, const bool& sync) {
+        std::string temp_path = path + ".tmp";
+        int fd = ::open(temp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return -1;
+        }
+        char header[HEADER_SIZE];
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        std::memcpy(header + sizeof(MAGIC), &base_sequence, sizeof(base_sequence));
+        if (!writeAll(fd, header, sizeof(header)) || (sync && ::fsync(fd) != 0)
+            || ::rename(temp_path.c_str(), path.c_str()) != 0) {
+            ::close(fd);
+            ::unlink(temp_path.c_str());
+            return -1;
+        }
+        // Once renamed the new file is the journal, so appends must go to it even if the directory sync fails.
+        if (sync) {
+            syncDirectory(path);
+        }
+        return fd;
+    }
+
+    /**
+     * Builds the payload of a SERVE_DISH record: the dish's index followed by its operator== identity.
+     */
+    void encodeServe(std::string& out, const Dish& dish, const int& index) {
+        DishCodec::putVarint(out, static_cast<uint64_t>(index));
+        DishCodec::putString(out, dish.getName());
+        DishCodec::putVarint(out, DishCodec::zigzag(dish.getPrepTime()));
+        DishCodec::putDouble(out, dish.getPrice());
+        out.push_back(static_cast<char>(DishCodec::cuisineOf(dish)));
+    }
+
+    // Payload buffer reused by the log* functions on each thread, so logging does not allocate once warm.
+    thread_local std::string payload_buffer;
+}
+
+OrderJournal::OrderJournal()
+    : fd_(-1), next_sequence_(1), pending_sequence_(0), durable_sequence_(0), stop_(false), failed_(false) {}
+
+/**
+ * Destructor.
+ * @post Flushes pending records and closes the file.
+ */
+OrderJournal::~OrderJournal() {
+    close();
+}
+
+/**
+ * Opens `path` for appending, creating it if needed. A torn tail left by a crash is truncated away and
+ * sequence numbers continue after the last valid record. A non-empty file without a journal header is left
+ * alone and refused.
+ * @return True if the journal is ready for appends.
+ */
+bool OrderJournal::open(const std::string& path, const Options& options) {
+    close();
+    options_ = options;
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    struct stat info;
+    if (fd >= 0 && ::fstat(fd, &info) == 0 && info.st_size == 0) {
+        ::close(fd);
+        fd = -1;
+    } else if (fd < 0 && errno != ENOENT) {
+        return false;
+    }
+    ScanResult existing;
+    if (fd < 0) {
+        fd = createJournal(path, 0, options_.sync);
+        if (fd < 0) {
+            return false;
+        }
+    } else {
+        existing = scan(fd, [](uint64_t, uint8_t, const char*, const char*) {});
+        if (!existing.valid || ::ftruncate(fd, existing.valid_end) != 0 || ::lseek(fd, 0, SEEK_END) < 0) {
+            ::close(fd);
+            return false;
+        }
+    }
+    fd_ = fd;
+    path_ = path;
+    next_sequence_ = existing.last_sequence + 1;
+    pending_sequence_ = existing.last_sequence;
+    durable_sequence_ = existing.last_sequence;
+    stop_ = false;
+    failed_ = false;
+    flusher_ = std::thread(&OrderJournal::flusherLoop, this);
+    return true;
+}
+
+bool OrderJournal::open(const std::string& path) {
+    return open(path, Options());
+}
+
+/**
+ * Flushes pending records, stops the flusher thread and closes the file.
+ */
+void OrderJournal::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    flusher_.join();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool OrderJournal::isOpen() const {
+    return fd_ >= 0;
+}
+
+/**
+ * Logs a dish accepted by newOrder().
+ * @return The record's sequence number.
+ */
+uint64_t OrderJournal::logNewOrder(const Dish& dish) {
+    payload_buffer.clear();
+    DishCodec::encode(dish, payload_buffer);
+    return append(NEW_ORDER, payload_buffer);
+}
+
+/**
+ * Logs a dish removed by serveDish().
+ * @param index The dish's position in the kitchen before it was removed.
+ * @return The record's sequence number.
+ */
+uint64_t OrderJournal::logServeDish(const Dish& dish, const int& index) {
+    payload_buffer.clear();
+    encodeServe(payload_buffer, dish, index);
+    return append(SERVE_DISH, payload_buffer);
+}
+
+/**
+ * Logs a dish whose attributes reload() replaced in place.
+ * @param index The dish's position in the kitchen, which the update does not change.
+ * @return The record's sequence number.
+ */
+uint64_t OrderJournal::logUpdateDish(const Dish& dish, const int& index) {
+    payload_buffer.clear();
+    DishCodec::putVarint(payload_buffer, static_cast<uint64_t>(index));
+    DishCodec::encode(dish, payload_buffer);
+    return append(UPDATE_DISH, payload_buffer);
+}
+
+/**
+ * Logs a dietaryAdjustment() request.
+ * @return The record's sequence number.
+ */
+uint64_t OrderJournal::logDietaryAdjustment(const Dish::DietaryRequest& request) {
+    payload_buffer.clear();
+    payload_buffer.push_back(static_cast<char>(DietaryViews::keyOf(request)));
+    return append(DIETARY_ADJUSTMENT, payload_buffer);
+}
+
+/**
+ * Writes and syncs every record appended so far.
+ * @return True if everything up to the last appended sequence is durable.
+ */
+bool OrderJournal::flush() {
+    if (fd_ < 0) {
+        return false;
+    }
+    uint64_t target = lastSequence();
+    writePending();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !failed_ && durable_sequence_ >= target;
+}
+
+/**
+ * @return The sequence number of the last record appended.
+ */
+uint64_t OrderJournal::lastSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_sequence_ - 1;
+}
+
+/**
+ * @return The sequence number of the last record known to be on disk.
+ */
+uint64_t OrderJournal::durableSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return durable_sequence_;
+}
+
+/**
+ * Saves a snapshot of `kitchen` tagged with the last sequence number, then replaces the journal with an empty
+ * one starting after that sequence. The snapshot is durable before the new journal is renamed into place, so
+ * a crash at any point leaves a snapshot and journal that recover() restores in full.
+ * @pre Every mutation of `kitchen` so far was logged to this journal.
+ * @return True if the snapshot was written; the journal is only emptied in that case.
+ */
+bool OrderJournal::checkpoint(const Kitchen& kitchen, const std::string& snapshot_path) {
+    KITCHEN_TIME_SCOPE("journal.checkpoint.ns");
+    KITCHEN_TRACE_SCOPE("OrderJournal::checkpoint");
+    if (fd_ < 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> io_lock(io_mutex_);
+    if (!writePendingLocked()) {
+        return false;
+    }
+    uint64_t sequence = durableSequence();
+    if (!CatalogSnapshot::save(kitchen, snapshot_path, sequence)
+        || (options_.sync && !syncDirectory(snapshot_path))) {
+        return false;
+    }
+    // Records appended while the snapshot was written stay in pending_ and follow the new header. If the new
+    // journal cannot be created, the old one is still complete and appends continue there.
+    int fd = createJournal(path_, sequence, options_.sync);
+    if (fd < 0) {
+        return false;
+    }
+    ::close(fd_);
+    fd_ = fd;
+    return true;
+}
+
+/**
+ * Applies the records of the journal at `path` with a sequence above `after_sequence` to `kitchen`.
+ * Any journal attached to `kitchen` is detached for the duration so that replay is not re-logged.
+ * Dishes removed by replayed serves are deallocated.
+ */
+OrderJournal::ReplayStats OrderJournal::replay(const std::string& path, Kitchen& kitchen,
+                                               const uint64_t& after_sequence) {
+    KITCHEN_TIME_SCOPE("journal.replay.ns");
+    KITCHEN_TRACE_SCOPE("OrderJournal::replay");
+    ReplayStats stats;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return stats;
+    }
+    OrderJournal* attached = kitchen.getJournal();
+    kitchen.attachJournal(nullptr);
+
+    ScanResult result = scan(fd, [&](uint64_t sequence, uint8_t op, const char* payload, const char* end) {
+        if (sequence <= after_sequence) {
+            stats.skipped++;
+            return;
+        }
+        bool applied = false;
+        if (op == NEW_ORDER) {
+            Dish* dish = DishCodec::decode(payload, end);
+            if (dish != nullptr && kitchen.newOrder(dish)) {
+                applied = true;
+            } else {
+                delete dish;
+            }
+        } else if (op == SERVE_DISH) {
+            uint64_t index, prep_time;
+            std::string name;
+            double price;
+            if (DishCodec::getVarint(payload, end, index) && DishCodec::getString(payload, end, name)
+                && DishCodec::getVarint(payload, end, prep_time) && DishCodec::getDouble(payload, end, price)
+                && payload < end) {
+                int dish_prep_time = static_cast<int>(DishCodec::unzigzag(prep_time));
+                Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(static_cast<uint8_t>(*payload));
+                // The same fields Dish::operator== compares.
+                auto matches = [&](const Dish* candidate) {
+                    return candidate->getName() == name && candidate->getPrepTime() == dish_prep_time
+                        && candidate->getPrice() == price && DishCodec::cuisineOf(*candidate) == cuisine;
+                };
+                // Replay reproduces the original order of the bag, so the recorded index normally matches.
+                Dish* dish = nullptr;
+                if (index < static_cast<uint64_t>(kitchen.getCurrentSize()) && matches(kitchen.items_[index])) {
+                    dish = kitchen.items_[index];
+                } else {
+                    for (int i = 0; i < kitchen.getCurrentSize() && dish == nullptr; i++) {
+                        if (matches(kitchen.items_[i])) {
+                            dish = kitchen.items_[i];
+                        }
+                    }
+                }
+                if (dish != nullptr && kitchen.serveDish(dish)) {
+                    delete dish;
+                    applied = true;
+                }
+            }
+        } else if (op == UPDATE_DISH) {
+            uint64_t index;
+            Dish* source = nullptr;
+            if (DishCodec::getVarint(payload, end, index)) {
+                source = DishCodec::decode(payload, end);
+            }
+            if (source != nullptr && payload == end) {
+                auto matches = [&](const Dish* candidate) {
+                    return *candidate == *source && typeid(*candidate) == typeid(*source);
+                };
+                int position = -1;
+                if (index < static_cast<uint64_t>(kitchen.getCurrentSize()) && matches(kitchen.items_[index])) {
+                    position = static_cast<int>(index);
+                } else {
+                    for (int i = 0; i < kitchen.getCurrentSize() && position < 0; i++) {
+                        if (matches(kitchen.items_[i])) {
+                            position = i;
+                        }
+                    }
+                }
+                if (position >= 0) {
+                    kitchen.updateDish(position, *source);
+                    applied = true;
+                }
+            }
+            delete source;
+        } else if (op == DIETARY_ADJUSTMENT && end - payload == 1) {
+            kitchen.dietaryAdjustment(DietaryViews::requestOf(static_cast<uint8_t>(*payload)));
+            applied = true;
+        }
+        if (applied) {
+            stats.applied++;
+        } else {
+            stats.skipped++;
+        }
+    });
+    ::close(fd);
+    kitchen.attachJournal(attached);
+
+    stats.records = result.records;
+    stats.last_sequence = result.last_sequence;
+    stats.torn_tail = result.torn_tail;
+    return stats;
+}
+
+/**
+ * Rebuilds `kitchen` after a restart: loads the snapshot at `snapshot_path`, if there is one, and then
+ * replays the journal records newer than it.
+ * @pre `kitchen` is empty, or holds the catalog the journal was started from if there is no snapshot.
+ */
+OrderJournal::ReplayStats OrderJournal::recover(Kitchen& kitchen, const std::string& snapshot_path,
+                                                const std::string& journal_path) {
+    uint64_t after_sequence = 0;
+    CatalogSnapshot snapshot;
+    if (snapshot.open(snapshot_path)) {
+        OrderJournal* attached = kitchen.getJournal();
+        kitchen.attachJournal(nullptr);
+        snapshot.loadInto(kitchen);
+        kitchen.attachJournal(attached);
+        after_sequence = snapshot.getSequence();
+    }
+    return replay(journal_path, kitchen, after_sequence);
+}
+
+/**
+ * Frames `payload` as a record and adds it to the pending group. Only wakes the flusher when the group is
+ * full, so the common case is a mutex and a copy.
+ * @return The record's sequence number.
+ */
+uint64_t OrderJournal::append(const Op& op, const std::string& payload) {
+    KITCHEN_COUNTER_ADD("journal.records", 1);
+    uint8_t op_byte = op;
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    uint32_t payload_crc = crc32(0, payload.data(), payload.size());
+    bool full;
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sequence = next_sequence_++;
+        uint32_t checksum = crc32(crc32(payload_crc, reinterpret_cast<const char*>(&sequence), sizeof(sequence)),
+                                  reinterpret_cast<const char*>(&op_byte), sizeof(op_byte));
+        pending_.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        pending_.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        pending_.append(reinterpret_cast<const char*>(&sequence), sizeof(sequence));
+        pending_.push_back(static_cast<char>(op_byte));
+        pending_.append(payload);
+        pending_sequence_ = sequence;
+        full = pending_.size() >= options_.group_bytes;
+    }
+    if (full) {
+        wake_.notify_one();
+    }
+    return sequence;
+}
+
+/**
+ * Runs on the flusher thread: commits the pending group whenever it fills up or the interval elapses.
+ */
+void OrderJournal::flusherLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        wake_.wait_for(lock, std::chrono::milliseconds(options_.group_interval_ms),
+                       [this]() { return stop_ || pending_.size() >= options_.group_bytes; });
+        lock.unlock();
+        writePending();
+        lock.lock();
+    }
+    lock.unlock();
+    writePending();
+}
+
+bool OrderJournal::writePending() {
+    std::lock_guard<std::mutex> io_lock(io_mutex_);
+    return writePendingLocked();
+}
+
+/**
+ * Writes the pending group with one write() and, if enabled, one fdatasync().
+ * @pre io_mutex_ is held.
+ * @return True if the group (possibly empty) reached the disk.
+ */
+bool OrderJournal::writePendingLocked() {
+    std::string group;
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failed_) {
+            return false;
+        }
+        group.swap(pending_);
+        sequence = pending_sequence_;
+    }
+    if (group.empty()) {
+        return true;
+    }
+    KITCHEN_TIME_SCOPE("journal.group_commit.ns");
+    KITCHEN_HISTOGRAM_RECORD("journal.group_commit.bytes", group.size());
+    KITCHEN_TRACE_SCOPE("OrderJournal::groupCommit");
+    bool ok = writeAll(fd_, group.data(), group.size()) && (!options_.sync || ::fdatasync(fd_) == 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ok) {
+        failed_ = true;
+        return false;
+    }
+    durable_sequence_ = sequence;
+    return true;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file OrderJournal.hpp
+ * @brief This file contains the declaration of the OrderJournal class, an append-only write-ahead log of
+ * Kitchen mutations with group commit, checkpointing and replay.
+ *
+ * A Kitchen with an attached journal logs every accepted newOrder(), every serveDish() (including those made by
+ * the release functions), every dish reload() updates in place and every dietaryAdjustment(). Appending only copies the record into an in-memory
+ * buffer under a mutex; a background thread writes the buffer and calls fdatasync once per group, either when
+ * the buffer reaches Options::group_bytes or every Options::group_interval_ms. Orders are therefore durable a
+ * few milliseconds after they are accepted, and flush() waits for that point explicitly.
+ *
+ * File layout: a 16-byte header (magic, base sequence) followed by records
+ *
+ *     uint32 payload length | uint32 CRC-32 of payload, sequence and op | uint64 sequence | uint8 op | payload
+ *
+ * Replay stops at the first record that is truncated or fails its checksum, which is where a crash tore the
+ * last group. checkpoint() saves a CatalogSnapshot tagged with the last sequence and then renames an empty
+ * journal over the old one, so recovery is: open the snapshot, then replay only records with a higher sequence.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef ORDER_JOURNAL_HPP
+#define ORDER_JOURNAL_HPP
+
+#include "Dish.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class Kitchen;
+
+class OrderJournal {
+    public:
+        /**
+         * @enum Op
+         * @brief The mutation a record describes.
+         */
+        enum Op : uint8_t { NEW_ORDER = 1, SERVE_DISH = 2, DIETARY_ADJUSTMENT = 3, UPDATE_DISH = 4 };
+
+        /**
+         * @struct Options
+         * @brief Group commit tuning.
+         */
+        struct Options {
+            size_t group_bytes = 64 * 1024;     ///< Flush as soon as this many bytes are pending.
+            int group_interval_ms = 5;          ///< Flush pending records at least this often.
+            bool sync = true;                   ///< Call fdatasync after each group; false only for benchmarks.
+        };
+
+        /**
+         * @struct ReplayStats
+         * @brief What replay() applied.
+         */
+        struct ReplayStats {
+            uint64_t records = 0;               ///< Valid records read.
+            uint64_t applied = 0;               ///< Records newer than the checkpoint that changed the kitchen.
+            uint64_t skipped = 0;               ///< Records at or below the checkpoint, or that no longer apply.
+            uint64_t last_sequence = 0;
+            bool torn_tail = false;             ///< True if the journal ended in a partial or corrupt record.
+        };
+
+        OrderJournal();
+
+        /**
+         * Destructor.
+         * @post Flushes pending records and closes the file.
+         */
+        ~OrderJournal();
+
+        OrderJournal(const OrderJournal&) = delete;
+        OrderJournal& operator=(const OrderJournal&) = delete;
+
+        /**
+         * Opens `path` for appending, creating it if needed. A torn tail left by a crash is truncated away and
+         * sequence numbers continue after the last valid record. A non-empty file without a journal header is
+         * left alone and refused.
+         * @return True if the journal is ready for appends.
+         */
+        bool open(const std::string& path, const Options& options);
+        bool open(const std::string& path);
+
+        /**
+         * Flushes pending records, stops the flusher thread and closes the file.
+         */
+        void close();
+
+        bool isOpen() const;
+
+        /**
+         * Logs a dish accepted by newOrder().
+         * @return The record's sequence number.
+         */
+        uint64_t logNewOrder(const Dish& dish);
+
+        /**
+         * Logs a dish removed by serveDish().
+         * @param index The dish's position in the kitchen before it was removed.
+         * @return The record's sequence number.
+         */
+        uint64_t logServeDish(const Dish& dish, const int& index);
+
+        /**
+         * Logs a dish whose attributes reload() replaced in place.
+         * @param index The dish's position in the kitchen, which the update does not change.
+         * @return The record's sequence number.
+         */
+        uint64_t logUpdateDish(const Dish& dish, const int& index);
+
+        /**
+         * Logs a dietaryAdjustment() request.
+         * @return The record's sequence number.
+         */
+        uint64_t logDietaryAdjustment(const Dish::DietaryRequest& request);
+
+        /**
+         * Writes and syncs every record appended so far.
+         * @return True if everything up to the last appended sequence is durable.
+         */
+        bool flush();
+
+        /**
+         * @return The sequence number of the last record appended.
+         */
+        uint64_t lastSequence() const;
+
+        /**
+         * @return The sequence number of the last record known to be on disk.
+         */
+        uint64_t durableSequence() const;
+
+        /**
+         * Saves a snapshot of `kitchen` tagged with the last sequence number, then replaces the journal with an
+         * empty one starting after that sequence. The snapshot is durable before the new journal is renamed into
+         * place, so a crash at any point leaves a snapshot and journal that recover() restores in full.
+         * @pre Every mutation of `kitchen` so far was logged to this journal.
+         * @return True if the snapshot was written; the journal is only emptied in that case.
+         */
+        bool checkpoint(const Kitchen& kitchen, const std::string& snapshot_path);
+
+        /**
+         * Applies the records of the journal at `path` with a sequence above `after_sequence` to `kitchen`.
+         * Any journal attached to `kitchen` is detached for the duration so that replay is not re-logged.
+         * Dishes removed by replayed serves are deallocated.
+         */
+        static ReplayStats replay(const std::string& path, Kitchen& kitchen, const uint64_t& after_sequence = 0);
+
+        /**
+         * Rebuilds `kitchen` after a restart: loads the snapshot at `snapshot_path`, if there is one, and then
+         * replays the journal records newer than it.
+         * @pre `kitchen` is empty, or holds the catalog the journal was started from if there is no snapshot.
+         */
+        static ReplayStats recover(Kitchen& kitchen, const std::string& snapshot_path,
+                                   const std::string& journal_path);
+
+    private:
+        uint64_t append(const Op& op, const std::string& payload);
+        void flusherLoop();
+        bool writePending();
+        bool writePendingLocked();
+
+        int fd_;
+        std::string path_;
+        Options options_;
+        mutable std::mutex mutex_;          // Guards pending_, next_sequence_, durable_sequence_, stop_.
+        std::mutex io_mutex_;               // Serializes writes so groups reach the file in order.
+        std::condition_variable wake_;
+        std::string pending_;
+        uint64_t next_sequence_;
+        uint64_t pending_sequence_;         // Last sequence in pending_.
+        uint64_t durable_sequence_;
+        bool stop_;
+        bool failed_;
+        std::thread flusher_;
+};
+
+#endif // ORDER_JOURNAL_HPP
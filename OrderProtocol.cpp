@@ -0,0 +1,216 @@
+/**
+ * @file OrderProtocol.cpp
+ * @brief This file contains the implementation of the OrderProtocol class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "OrderProtocol.hpp"
+#include "DishCodec.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace {
+    /**
+     * Reads a zigzagged varint that must fit in an int.
+     */
+    bool getInt(const char*& cursor, const char* end, int& value) {
+        uint64_t raw;
+        if (!DishCodec::getVarint(cursor, end, raw)) {
+            return false;
+        }
+        int64_t wide = DishCodec::unzigzag(raw);
+        if (wide < INT32_MIN || wide > INT32_MAX) {
+            return false;
+        }
+        value = static_cast<int>(wide);
+        return true;
+    }
+}
+
+/**
+ * Appends a frame header for `code` whose length is filled in by endFrame().
+ * @return The offset of the header in `out`, for endFrame().
+ */
+size_t OrderProtocol::beginFrame(std::string& out, const uint8_t& code) {
+    size_t start = out.size();
+    out.append(HEADER_SIZE, '\0');
+    out.push_back(static_cast<char>(code));
+    return start;
+}
+
+/**
+ * Sets the length of the frame started at `start` to cover everything appended since.
+ */
+void OrderProtocol::endFrame(std::string& out, const size_t& start) {
+    uint32_t length = static_cast<uint32_t>(out.size() - start - HEADER_SIZE);
+    std::memcpy(&out[start], &length, sizeof(length));
+}
+
+/**
+ * Splits the next frame off a received byte stream.
+ * @param cursor The first unconsumed byte; advanced past the frame if one is returned.
+ * @param code Set to the frame's code.
+ * @param payload Set to the frame's payload, a view into the stream.
+ * @return FRAME, INCOMPLETE if more bytes are needed, or INVALID if the length is out of range.
+ */
+OrderProtocol::FrameResult OrderProtocol::nextFrame(const char*& cursor, const char* end, uint8_t& code,
+                                                    std::string_view& payload) {
+    if (end - cursor < static_cast<ptrdiff_t>(HEADER_SIZE)) {
+        return INCOMPLETE;
+    }
+    uint32_t length;
+    std::memcpy(&length, cursor, sizeof(length));
+    if (length == 0 || length > MAX_FRAME_SIZE) {
+        return INVALID;
+    }
+    if (static_cast<uint64_t>(end - cursor) < HEADER_SIZE + static_cast<uint64_t>(length)) {
+        return INCOMPLETE;
+    }
+    code = static_cast<uint8_t>(cursor[HEADER_SIZE]);
+    payload = std::string_view(cursor + HEADER_SIZE + 1, length - 1);
+    cursor += HEADER_SIZE + length;
+    return FRAME;
+}
+
+void OrderProtocol::appendNewOrder(std::string& out, const Dish& dish) {
+    size_t start = beginFrame(out, NEW_ORDER);
+    DishCodec::encode(dish, out);
+    endFrame(out, start);
+}
+
+void OrderProtocol::appendServeDish(std::string& out, const std::string_view& name) {
+    size_t start = beginFrame(out, SERVE_DISH);
+    DishCodec::putString(out, name);
+    endFrame(out, start);
+}
+
+void OrderProtocol::appendReleaseBelowPrepTime(std::string& out, const int& prep_time) {
+    size_t start = beginFrame(out, RELEASE_BELOW_PREP_TIME);
+    DishCodec::putVarint(out, DishCodec::zigzag(prep_time));
+    endFrame(out, start);
+}
+
+void OrderProtocol::appendReleaseCuisine(std::string& out, const Dish::CuisineType& cuisine) {
+    size_t start = beginFrame(out, RELEASE_CUISINE);
+    out.push_back(static_cast<char>(cuisine));
+    endFrame(out, start);
+}
+
+void OrderProtocol::appendReport(std::string& out) {
+    endFrame(out, beginFrame(out, REPORT));
+}
+
+void OrderProtocol::appendDietaryAdjustment(std::string& out, const Dish::DietaryRequest& request) {
+    size_t start = beginFrame(out, DIETARY_ADJUSTMENT);
+    out.push_back(static_cast<char>(Dish::maskOf(request)));
+    endFrame(out, start);
+}
+
+void OrderProtocol::appendQuery(std::string& out, const Query& query) {
+    size_t start = beginFrame(out, QUERY);
+    encodeQuery(out, query);
+    endFrame(out, start);
+}
+
+void OrderProtocol::encodeQuery(std::string& out, const Query& query) {
+    out.push_back(static_cast<char>(query.fields));
+    if (query.fields & Query::CUISINE) {
+        out.push_back(static_cast<char>(query.cuisine));
+    }
+    if (query.fields & Query::DISH_TYPE) {
+        out.push_back(static_cast<char>(query.dish_type));
+    }
+    if (query.fields & Query::PREP_TIME) {
+        DishCodec::putVarint(out, DishCodec::zigzag(query.prep_min));
+        DishCodec::putVarint(out, DishCodec::zigzag(query.prep_max));
+    }
+    if (query.fields & Query::PRICE) {
+        DishCodec::putDouble(out, query.price_min);
+        DishCodec::putDouble(out, query.price_max);
+    }
+    DishCodec::putVarint(out, query.limit);
+}
+
+/**
+ * Reads a Query, refusing a reversed prep-time or price range and a price bound that is not finite.
+ * @return True if a valid query was read; `cursor` is only advanced then.
+ */
+bool OrderProtocol::decodeQuery(const char*& cursor, const char* end, Query& query) {
+    const char* p = cursor;
+    if (p == end) {
+        return false;
+    }
+    query = Query();
+    query.fields = static_cast<uint8_t>(*p++);
+    if (query.fields & Query::CUISINE) {
+        if (p == end || static_cast<uint8_t>(*p) > Dish::OTHER) {
+            return false;
+        }
+        query.cuisine = static_cast<Dish::CuisineType>(static_cast<uint8_t>(*p++));
+    }
+    if (query.fields & Query::DISH_TYPE) {
+        if (p == end || static_cast<uint8_t>(*p) >= KitchenIndex::DISH_TYPE_COUNT) {
+            return false;
+        }
+        query.dish_type = static_cast<KitchenIndex::DishType>(static_cast<uint8_t>(*p++));
+    }
+    if ((query.fields & Query::PREP_TIME)
+        && (!getInt(p, end, query.prep_min) || !getInt(p, end, query.prep_max) || query.prep_min > query.prep_max)) {
+        return false;
+    }
+    if ((query.fields & Query::PRICE)
+        && (!DishCodec::getDouble(p, end, query.price_min) || !DishCodec::getDouble(p, end, query.price_max)
+            || !std::isfinite(query.price_min) || !std::isfinite(query.price_max)
+            || query.price_min > query.price_max)) {
+        return false;
+    }
+    uint64_t limit;
+    if (!DishCodec::getVarint(p, end, limit) || limit > UINT32_MAX) {
+        return false;
+    }
+    query.limit = static_cast<uint32_t>(limit);
+    cursor = p;
+    return true;
+}
+
+void OrderProtocol::encodeReport(std::string& out, const Report& report) {
+    DishCodec::putVarint(out, report.dishes);
+    DishCodec::putVarint(out, DishCodec::zigzag(report.avg_prep_time));
+    DishCodec::putDouble(out, report.elaborate_percentage);
+    for (uint64_t count : report.cuisines) {
+        DishCodec::putVarint(out, count);
+    }
+}
+
+bool OrderProtocol::decodeReport(const char*& cursor, const char* end, Report& report) {
+    const char* p = cursor;
+    uint64_t avg_prep_time;
+    if (!DishCodec::getVarint(p, end, report.dishes) || !DishCodec::getVarint(p, end, avg_prep_time)
+        || !DishCodec::getDouble(p, end, report.elaborate_percentage)) {
+        return false;
+    }
+    report.avg_prep_time = DishCodec::unzigzag(avg_prep_time);
+    for (uint64_t& count : report.cuisines) {
+        if (!DishCodec::getVarint(p, end, count)) {
+            return false;
+        }
+    }
+    cursor = p;
+    return true;
+}
+
+/**
+ * @return The request whose Dish::maskOf() is `mask`.
+ */
+Dish::DietaryRequest OrderProtocol::dietaryRequestOf(const uint8_t& mask) {
+    Dish::DietaryRequest request;
+    request.vegetarian = mask & Dish::VEGETARIAN;
+    request.vegan = mask & Dish::VEGAN;
+    request.gluten_free = mask & Dish::GLUTEN_FREE;
+    request.nut_free = mask & Dish::NUT_FREE;
+    request.low_sodium = mask & Dish::LOW_SODIUM;
+    request.low_sugar = mask & Dish::LOW_SUGAR;
+    return request;
+}
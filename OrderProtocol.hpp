@@ -0,0 +1,138 @@
+/**
+ * @file OrderProtocol.hpp
+ * @brief This file contains the declaration of the OrderProtocol class, the binary request/response framing
+ * spoken between OrderServer and its clients.
+ *
+ * Every message is a frame:
+ *
+ *     uint32 length | uint8 code | payload
+ *
+ * where `length` counts the code and payload bytes. A request's code is an Op and a response's is a Status. Integers in
+ * payloads are DishCodec varints (zigzagged where they can be negative), strings are length-prefixed and dishes
+ * are DishCodec encodings. As with DishCodec, values are in native byte order, since both ends run on one machine.
+ *
+ * Requests on one connection may be pipelined: a client can send many without waiting, and the responses
+ * come back in the order the requests were sent, one per request.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef ORDER_PROTOCOL_HPP
+#define ORDER_PROTOCOL_HPP
+
+#include "Dish.hpp"
+#include "KitchenIndex.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class OrderProtocol {
+    public:
+        static const uint32_t HEADER_SIZE = 4;
+
+        /**
+         * The largest code-plus-payload a frame may carry; a longer length is treated as a broken stream.
+         */
+        static const uint32_t MAX_FRAME_SIZE = 1 << 20;
+
+        /**
+         * @enum Op
+         * @brief The request a frame carries, and its payload.
+         */
+        enum Op : uint8_t {
+            NEW_ORDER = 1,              ///< A dish. Replies OK, or REJECTED if the kitchen refused it.
+            SERVE_DISH = 2,             ///< A dish name. Replies OK, or NOT_FOUND.
+            RELEASE_BELOW_PREP_TIME = 3,///< A prep time. Replies OK and the number of dishes released.
+            RELEASE_CUISINE = 4,        ///< A Dish::CuisineType byte. Replies OK and the number released.
+            REPORT = 5,                 ///< Nothing. Replies OK and a Report.
+            DIETARY_ADJUSTMENT = 6,     ///< A Dish::maskOf() byte. Replies OK.
+            QUERY = 7                   ///< A Query. Replies OK, the match count and up to Query::limit names;
+                                        ///< BAD_REQUEST for a reversed range or a price that is not finite.
+        };
+
+        /**
+         * @enum Status
+         * @brief The outcome a response frame carries.
+         */
+        enum Status : uint8_t { OK = 0, REJECTED = 1, NOT_FOUND = 2, BAD_REQUEST = 3 };
+
+        /**
+         * @enum FrameResult
+         * @brief What nextFrame() found.
+         */
+        enum FrameResult { FRAME, INCOMPLETE, INVALID };
+
+        /**
+         * @struct Query
+         * @brief The KitchenQuery predicates a QUERY request may set; `fields` says which are set.
+         */
+        struct Query {
+            enum Field : uint8_t { CUISINE = 1, DISH_TYPE = 2, PREP_TIME = 4, PRICE = 8 };
+
+            uint8_t fields = 0;
+            Dish::CuisineType cuisine = Dish::OTHER;
+            KitchenIndex::DishType dish_type = KitchenIndex::APPETIZER;
+            int prep_min = 0, prep_max = 0;
+            double price_min = 0, price_max = 0;
+            uint32_t limit = 0;                 ///< The most names to return.
+        };
+
+        /**
+         * @struct Report
+         * @brief The kitchen-wide figures Kitchen::kitchenReport() prints.
+         */
+        struct Report {
+            uint64_t dishes = 0;
+            int64_t avg_prep_time = 0;
+            double elaborate_percentage = 0;
+            uint64_t cuisines[Dish::OTHER + 1] = {};    ///< Dishes per Dish::CuisineType.
+        };
+
+        /**
+         * Appends a frame header for `code` whose length is filled in by endFrame().
+         * @return The offset of the header in `out`, for endFrame().
+         */
+        static size_t beginFrame(std::string& out, const uint8_t& code);
+
+        /**
+         * Sets the length of the frame started at `start` to cover everything appended since.
+         */
+        static void endFrame(std::string& out, const size_t& start);
+
+        /**
+         * Splits the next frame off a received byte stream.
+         * @param cursor The first unconsumed byte; advanced past the frame if one is returned.
+         * @param code Set to the frame's code.
+         * @param payload Set to the frame's payload, a view into the stream.
+         * @return FRAME, INCOMPLETE if more bytes are needed, or INVALID if the length is out of range.
+         */
+        static FrameResult nextFrame(const char*& cursor, const char* end, uint8_t& code, std::string_view& payload);
+
+        static void appendNewOrder(std::string& out, const Dish& dish);
+        static void appendServeDish(std::string& out, const std::string_view& name);
+        static void appendReleaseBelowPrepTime(std::string& out, const int& prep_time);
+        static void appendReleaseCuisine(std::string& out, const Dish::CuisineType& cuisine);
+        static void appendReport(std::string& out);
+        static void appendDietaryAdjustment(std::string& out, const Dish::DietaryRequest& request);
+        static void appendQuery(std::string& out, const Query& query);
+
+        static void encodeQuery(std::string& out, const Query& query);
+
+        /**
+         * Reads a Query, refusing a reversed prep-time or price range and a price bound that is not finite.
+         * @return True if a valid query was read; `cursor` is only advanced then.
+         */
+        static bool decodeQuery(const char*& cursor, const char* end, Query& query);
+        static void encodeReport(std::string& out, const Report& report);
+        static bool decodeReport(const char*& cursor, const char* end, Report& report);
+
+        /**
+         * @return The request whose Dish::maskOf() is `mask`.
+         */
+        static Dish::DietaryRequest dietaryRequestOf(const uint8_t& mask);
+};
+
+#endif // ORDER_PROTOCOL_HPP
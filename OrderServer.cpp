@@ -0,0 +1,506 @@
+/**
+ * @file OrderServer.cpp
+ * @brief This file contains the implementation of the OrderServer class: the epoll loop, batching and request
+ * execution.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "OrderServer.hpp"
+#include "DishCodec.hpp"
+#include "KitchenQuery.hpp"
+#include "Metrics.hpp"
+#include "OrderJournal.hpp"
+#include "OrderProtocol.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    /**
+     * Serves every dish in `dishes` and deallocates it.
+     * @return The number served.
+     */
+    uint64_t release(Kitchen& kitchen, const std::vector<Dish*>& dishes) {
+        // Kitchen's release functions leave the dishes they serve to the caller, who has no way to find them
+        // afterwards; a daemon that ran them would leak every released dish. The same dishes are collected from
+        // the indexes first instead, so they can be freed.
+        uint64_t released = 0;
+        for (Dish* dish : dishes) {
+            if (kitchen.serveDish(dish)) {
+                delete dish;
+                released++;
+            }
+        }
+        return released;
+    }
+}
+
+/**
+ * @param kitchen The kitchen requests are executed on; it must outlive the server.
+ */
+OrderServer::OrderServer(Kitchen& kitchen)
+    : kitchen_(kitchen), listen_fd_(-1), epoll_fd_(-1), wake_fd_(-1), stopping_(false) {}
+
+/**
+ * Destructor.
+ * @post Closes every connection and removes the socket file.
+ */
+OrderServer::~OrderServer() {
+    for (auto& entry : connections_) {
+        ::close(entry.first);
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        ::unlink(socket_path_.c_str());
+    }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+    }
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+    }
+}
+
+/**
+ * Binds and listens on `socket_path`, replacing a stale socket file left by an earlier run.
+ * @return True if the server is ready for run().
+ */
+bool OrderServer::listen(const std::string& socket_path) {
+    struct sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (listen_fd_ >= 0 || socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+    // A socket file nobody accepts on is left over from a server that did not shut down cleanly; one that
+    // accepts belongs to a running server, which is not taken over.
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool live = probe >= 0 && ::connect(probe, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0;
+    if (probe >= 0) {
+        ::close(probe);
+    }
+    if (live) {
+        return false;
+    }
+    ::unlink(socket_path.c_str());
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (listen_fd_ < 0 || epoll_fd_ < 0 || wake_fd_ < 0
+        || ::bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        return false;
+    }
+    socket_path_ = socket_path;
+    struct epoll_event listen_event = {};
+    listen_event.events = EPOLLIN;
+    listen_event.data.fd = listen_fd_;
+    struct epoll_event wake_event = {};
+    wake_event.events = EPOLLIN;
+    wake_event.data.fd = wake_fd_;
+    return ::listen(listen_fd_, SOMAXCONN) == 0
+           && ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &listen_event) == 0
+           && ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &wake_event) == 0;
+}
+
+/**
+ * Serves connections until stop() is called.
+ * @pre listen() succeeded.
+ */
+void OrderServer::run() {
+    struct epoll_event events[MAX_EVENTS];
+    std::vector<int> finished;
+    while (!stopping_) {
+        int count = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd_) {
+                acceptAll();
+                continue;
+            }
+            if (fd == wake_fd_) {
+                uint64_t value;
+                while (::read(wake_fd_, &value, sizeof(value)) < 0 && errno == EINTR) {
+                }
+                stopping_ = true;
+                continue;
+            }
+            auto found = connections_.find(fd);
+            if (found == connections_.end()) {
+                continue;
+            }
+            Connection& connection = *found->second;
+            if (events[i].events & EPOLLOUT) {
+                sendTo(connection);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                if (connection.events & EPOLLIN) {
+                    readFrom(connection);
+                } else {
+                    // Not being read because its client was not reading either, and now gone.
+                    connection.closing = true;
+                    connection.out.clear();
+                }
+            }
+            if (!connection.ready && !connection.in.empty()) {
+                // Input held back while the connection was backlogged; its output has room again.
+                connection.ready = true;
+                ready_.push_back(&connection);
+            }
+        }
+
+        executeBatch();
+        for (Connection* connection : ready_) {
+            connection->ready = false;
+            sendTo(*connection);
+        }
+        ready_.clear();
+
+        for (auto& entry : connections_) {
+            if (entry.second->closing && entry.second->out.empty()) {
+                finished.push_back(entry.first);
+            }
+        }
+        for (int fd : finished) {
+            closeConnection(fd);
+        }
+        finished.clear();
+    }
+}
+
+/**
+ * Makes run() return after its current iteration. Safe to call from another thread or a signal handler.
+ */
+void OrderServer::stop() {
+    if (wake_fd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+/**
+ * Executes one request on the kitchen and appends its response frame to `out`.
+ * @param op The request's OrderProtocol::Op.
+ * @return True if the request changed the kitchen.
+ */
+bool OrderServer::execute(const uint8_t& op, const std::string_view& payload, std::string& out) {
+    const char* cursor = payload.data();
+    const char* end = cursor + payload.size();
+    size_t start;
+    switch (op) {
+        case OrderProtocol::NEW_ORDER: {
+            Dish* dish = DishCodec::decode(cursor, end);
+            if (dish == nullptr || cursor != end) {
+                delete dish;
+                break;
+            }
+            if (kitchen_.newOrder(dish)) {
+                OrderProtocol::endFrame(out, OrderProtocol::beginFrame(out, OrderProtocol::OK));
+                return true;
+            }
+            delete dish;
+            OrderProtocol::endFrame(out, OrderProtocol::beginFrame(out, OrderProtocol::REJECTED));
+            return false;
+        }
+        case OrderProtocol::SERVE_DISH: {
+            std::string name;
+            if (!DishCodec::getString(cursor, end, name) || cursor != end) {
+                break;
+            }
+            // The name index ignores case; serving needs the dish with exactly this name.
+            for (Dish* dish : kitchen_.getNameIndex().exact(name)) {
+                if (dish->getName() == name) {
+                    kitchen_.serveDish(dish);
+                    delete dish;
+                    OrderProtocol::endFrame(out, OrderProtocol::beginFrame(out, OrderProtocol::OK));
+                    return true;
+                }
+            }
+            OrderProtocol::endFrame(out, OrderProtocol::beginFrame(out, OrderProtocol::NOT_FOUND));
+            return false;
+        }
+        case OrderProtocol::RELEASE_BELOW_PREP_TIME:
+        case OrderProtocol::RELEASE_CUISINE: {
+            std::vector<Dish*> dishes;
+            uint64_t raw;
+            if (op == OrderProtocol::RELEASE_BELOW_PREP_TIME) {
+                if (!DishCodec::getVarint(cursor, end, raw) || cursor != end) {
+                    break;
+                }
+                int64_t prep_time = DishCodec::unzigzag(raw);
+                if (prep_time > INT_MIN) {
+                    int below = static_cast<int>(std::min<int64_t>(prep_time, INT_MAX) - 1);
+                    for (Dish* dish : KitchenQuery(kitchen_).prepTime(INT_MIN, below).run()) {
+                        dishes.push_back(dish);
+                    }
+                }
+            } else {
+                if (end - cursor != 1 || static_cast<uint8_t>(*cursor) > Dish::OTHER) {
+                    break;
+                }
+                Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(static_cast<uint8_t>(*cursor));
+                KitchenQuery query(kitchen_);
+                for (Dish* dish : query.cuisine(cuisine).run()) {
+                    dishes.push_back(dish);
+                }
+            }
+            uint64_t released = release(kitchen_, dishes);
+            start = OrderProtocol::beginFrame(out, OrderProtocol::OK);
+            DishCodec::putVarint(out, released);
+            OrderProtocol::endFrame(out, start);
+            return released > 0;
+        }
+        case OrderProtocol::REPORT: {
+            if (cursor != end) {
+                break;
+            }
+            OrderProtocol::Report report;
+            report.dishes = kitchen_.getCurrentSize();
+            // The running prep time sum gives calculateAvgPrepTime()'s result without its scan of every dish.
+            report.avg_prep_time = report.dishes == 0 ? 0 : std::llround(
+                static_cast<double>(kitchen_.getPrepTimeSum()) / static_cast<double>(report.dishes));
+            report.elaborate_percentage = kitchen_.calculateElaboratePercentage();
+            for (int c = 0; c <= Dish::OTHER; c++) {
+                report.cuisines[c] = KitchenQuery(kitchen_).cuisine(static_cast<Dish::CuisineType>(c)).count();
+            }
+            start = OrderProtocol::beginFrame(out, OrderProtocol::OK);
+            OrderProtocol::encodeReport(out, report);
+            OrderProtocol::endFrame(out, start);
+            return false;
+        }
+        case OrderProtocol::DIETARY_ADJUSTMENT: {
+            if (end - cursor != 1) {
+                break;
+            }
+            kitchen_.dietaryAdjustment(OrderProtocol::dietaryRequestOf(static_cast<uint8_t>(*cursor)));
+            OrderProtocol::endFrame(out, OrderProtocol::beginFrame(out, OrderProtocol::OK));
+            return true;
+        }
+        case OrderProtocol::QUERY: {
+            OrderProtocol::Query request;
+            if (!OrderProtocol::decodeQuery(cursor, end, request) || cursor != end) {
+                break;
+            }
+            KitchenQuery query(kitchen_);
+            if (request.fields & OrderProtocol::Query::CUISINE) {
+                query.cuisine(request.cuisine);
+            }
+            if (request.fields & OrderProtocol::Query::DISH_TYPE) {
+                query.dishType(request.dish_type);
+            }
+            if (request.fields & OrderProtocol::Query::PREP_TIME) {
+                query.prepTime(request.prep_min, request.prep_max);
+            }
+            if (request.fields & OrderProtocol::Query::PRICE) {
+                query.price(request.price_min, request.price_max);
+            }
+            std::vector<const Dish*> names;
+            if (request.limit > 0) {
+                for (Dish* dish : query.run()) {
+                    names.push_back(dish);
+                    if (names.size() == request.limit) {
+                        break;
+                    }
+                }
+            }
+            start = OrderProtocol::beginFrame(out, OrderProtocol::OK);
+            DishCodec::putVarint(out, query.count());
+            DishCodec::putVarint(out, names.size());
+            for (const Dish* dish : names) {
+                DishCodec::putString(out, dish->getName());
+            }
+            OrderProtocol::endFrame(out, start);
+            return false;
+        }
+        default:
+            break;
+    }
+    stats_.bad_requests++;
+    OrderProtocol::endFrame(out, OrderProtocol::beginFrame(out, OrderProtocol::BAD_REQUEST));
+    return false;
+}
+
+const OrderServer::Stats& OrderServer::getStats() const {
+    return stats_;
+}
+
+/**
+ * Accepts every pending connection.
+ */
+void OrderServer::acceptAll() {
+    while (true) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        std::unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+        struct epoll_event event = {};
+        event.events = connection->events;
+        event.data.fd = fd;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections_[fd] = std::move(connection);
+        stats_.connections++;
+        KITCHEN_GAUGE_SET("server.connections", connections_.size());
+    }
+}
+
+/**
+ * Reads what the client has sent so far, and marks the connection ready for the batch.
+ * @post `connection` is closing if the client closed it or it failed.
+ */
+void OrderServer::readFrom(Connection& connection) {
+    // Bounded, so that one client sending without pause cannot keep the loop from the others; whatever is
+    // left is reported again by the next epoll_wait().
+    for (int reads = 0; reads < 4; reads++) {
+        size_t old_size = connection.in.size();
+        connection.in.resize(old_size + READ_SIZE);
+        ssize_t got = ::recv(connection.fd, &connection.in[old_size], READ_SIZE, 0);
+        connection.in.resize(old_size + (got > 0 ? got : 0));
+        if (got > 0) {
+            if (static_cast<size_t>(got) < READ_SIZE) {
+                break;
+            }
+        } else if (got == 0) {
+            connection.closing = true;
+            break;
+        } else if (errno != EINTR) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                connection.closing = true;
+            }
+            break;
+        }
+    }
+    if (!connection.ready && !connection.in.empty()) {
+        connection.ready = true;
+        ready_.push_back(&connection);
+    }
+}
+
+/**
+ * Executes every complete request of the ready connections, then makes the batch's mutations durable.
+ */
+void OrderServer::executeBatch() {
+    if (ready_.empty()) {
+        return;
+    }
+    KITCHEN_TIME_SCOPE("server.batch.ns");
+    KITCHEN_TRACE_SCOPE("OrderServer::batch");
+    uint64_t batch = 0;
+    bool changed = false;
+    for (Connection* connection : ready_) {
+        const char* cursor = connection->in.data();
+        const char* end = cursor + connection->in.size();
+        uint8_t op;
+        std::string_view payload;
+        // A connection whose responses are backlogged keeps the rest of its requests until they drain.
+        while (connection->out.size() < MAX_PENDING_OUTPUT) {
+            OrderProtocol::FrameResult result = OrderProtocol::nextFrame(cursor, end, op, payload);
+            if (result == OrderProtocol::INCOMPLETE) {
+                break;
+            }
+            if (result == OrderProtocol::INVALID) {
+                // The stream has lost its framing, so nothing after this point can be trusted.
+                stats_.bad_requests++;
+                connection->closing = true;
+                cursor = end;
+                break;
+            }
+            changed = execute(op, payload, connection->out) || changed;
+            batch++;
+        }
+        connection->in.erase(0, cursor - connection->in.data());
+    }
+    if (changed && kitchen_.getJournal() != nullptr) {
+        // One sync covers every mutation of the batch, and none is acknowledged before it.
+        kitchen_.getJournal()->flush();
+        stats_.journal_flushes++;
+    }
+    if (batch > 0) {
+        stats_.requests += batch;
+        stats_.batches++;
+        stats_.largest_batch = std::max(stats_.largest_batch, batch);
+        KITCHEN_COUNTER_ADD("server.requests", batch);
+        KITCHEN_HISTOGRAM_RECORD("server.batch_size", batch);
+    }
+}
+
+/**
+ * Sends as much of the connection's pending responses as the socket takes.
+ */
+void OrderServer::sendTo(Connection& connection) {
+    size_t sent = 0;
+    while (sent < connection.out.size()) {
+        ssize_t n = ::send(connection.fd, connection.out.data() + sent, connection.out.size() - sent,
+                           MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            // The client is gone; its responses have nowhere to go.
+            connection.closing = true;
+            connection.out.clear();
+            sent = 0;
+            break;
+        }
+    }
+    connection.out.erase(0, sent);
+    updateInterest(connection);
+}
+
+/**
+ * Registers for input while the connection has room for more responses, and for output while some are unsent.
+ */
+void OrderServer::updateInterest(Connection& connection) {
+    uint32_t events = 0;
+    if (!connection.closing && connection.out.size() < MAX_PENDING_OUTPUT) {
+        events |= EPOLLIN;
+    }
+    if (!connection.out.empty()) {
+        events |= EPOLLOUT;
+    }
+    if (events == connection.events) {
+        return;
+    }
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.fd = connection.fd;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.events = events;
+}
+
+void OrderServer::closeConnection(const int& fd) {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections_.erase(fd);
+    KITCHEN_GAUGE_SET("server.connections", connections_.size());
+}
@@ -0,0 +1,128 @@
+/**
+ * @file OrderServer.hpp
+ * @brief This file contains the declaration of the OrderServer class, a single-threaded daemon loop that owns a
+ * Kitchen and serves OrderProtocol requests over a Unix domain socket.
+ *
+ * The loop is one epoll set holding the listening socket, every client connection and an eventfd that stop()
+ * writes to. Each iteration:
+ *
+ *     1. reads everything available from every ready connection,
+ *     2. executes every complete request read, connection by connection and in order, as one batch,
+ *     3. if the kitchen has an OrderJournal and the batch changed the kitchen, flushes the journal once,
+ *     4. writes each connection's responses with one send().
+ *
+ * A busy server therefore pays for one journal sync and one send per connection per batch rather than per
+ * request, and clients that pipeline many requests get them all answered by the same batch. Mutations are
+ * acknowledged only once they are durable. A connection whose client stops reading is not read from again
+ * until its unsent responses drop below MAX_PENDING_OUTPUT, so a slow client cannot grow the server's memory.
+ *
+ * The kitchen is only touched from the thread that calls run().
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef ORDER_SERVER_HPP
+#define ORDER_SERVER_HPP
+
+#include "Kitchen.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class OrderServer {
+    public:
+        static const int MAX_EVENTS = 256;
+        static constexpr size_t READ_SIZE = 64 * 1024;
+        static constexpr size_t MAX_PENDING_OUTPUT = 4 << 20;
+
+        /**
+         * @struct Stats
+         * @brief Totals since the server started.
+         */
+        struct Stats {
+            uint64_t connections = 0;       ///< Connections accepted.
+            uint64_t requests = 0;
+            uint64_t bad_requests = 0;      ///< Requests answered BAD_REQUEST, and streams closed as invalid.
+            uint64_t batches = 0;           ///< Loop iterations that executed at least one request.
+            uint64_t largest_batch = 0;
+            uint64_t journal_flushes = 0;
+        };
+
+        /**
+         * @param kitchen The kitchen requests are executed on; it must outlive the server.
+         */
+        explicit OrderServer(Kitchen& kitchen);
+
+        /**
+         * Destructor.
+         * @post Closes every connection and removes the socket file.
+         */
+        ~OrderServer();
+
+        OrderServer(const OrderServer&) = delete;
+        OrderServer& operator=(const OrderServer&) = delete;
+
+        /**
+         * Binds and listens on `socket_path`, replacing a stale socket file left by an earlier run.
+         * @return True if the server is ready for run().
+         */
+        bool listen(const std::string& socket_path);
+
+        /**
+         * Serves connections until stop() is called.
+         * @pre listen() succeeded.
+         */
+        void run();
+
+        /**
+         * Makes run() return after its current iteration. Safe to call from another thread or a signal handler.
+         */
+        void stop();
+
+        /**
+         * Executes one request on the kitchen and appends its response frame to `out`.
+         * @param op The request's OrderProtocol::Op.
+         * @return True if the request changed the kitchen.
+         */
+        bool execute(const uint8_t& op, const std::string_view& payload, std::string& out);
+
+        const Stats& getStats() const;
+
+    private:
+        /**
+         * @struct Connection
+         * @brief One client: bytes received but not yet executed, and responses not yet sent.
+         */
+        struct Connection {
+            int fd;
+            std::string in;
+            std::string out;
+            uint32_t events = 0;            ///< The epoll events currently registered.
+            bool ready = false;             ///< Has unexecuted input this iteration.
+            bool closing = false;
+        };
+
+        void acceptAll();
+        void readFrom(Connection& connection);
+        void executeBatch();
+        void sendTo(Connection& connection);
+        void updateInterest(Connection& connection);
+        void closeConnection(const int& fd);
+
+        Kitchen& kitchen_;
+        std::string socket_path_;
+        int listen_fd_;
+        int epoll_fd_;
+        int wake_fd_;
+        bool stopping_;
+        std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+        std::vector<Connection*> ready_;    ///< Connections read from this iteration, in event order.
+        Stats stats_;
+};
+
+#endif // ORDER_SERVER_HPP
@@ -0,0 +1,98 @@
+/**
+ * @file QuantileSketch.cpp
+ * @brief This file contains the implementation of the QuantileSketch class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "QuantileSketch.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @param relative_accuracy The largest relative error of a reported quantile, in (0, 1).
+ */
+QuantileSketch::QuantileSketch(const double& relative_accuracy)
+    : gamma_((1 + relative_accuracy) / (1 - relative_accuracy)), log_gamma_(std::log(gamma_)), count_(0),
+      zero_count_(0), offset_(0) {}
+
+void QuantileSketch::add(const double& value) {
+    count_++;
+    if (value <= 0) {
+        zero_count_++;
+        return;
+    }
+    int bucket = bucketOf(value);
+    if (counts_.empty()) {
+        offset_ = bucket;
+        counts_.push_back(0);
+    } else if (bucket < offset_) {
+        counts_.insert(counts_.begin(), offset_ - bucket, 0);
+        offset_ = bucket;
+    } else if (bucket >= offset_ + static_cast<int>(counts_.size())) {
+        counts_.resize(bucket - offset_ + 1, 0);
+    }
+    counts_[bucket - offset_]++;
+}
+
+/**
+ * Removes one occurrence of `value`.
+ * @pre `value` was added and not yet removed.
+ */
+void QuantileSketch::remove(const double& value) {
+    if (value <= 0) {
+        if (zero_count_ > 0) {
+            zero_count_--;
+            count_--;
+        }
+        return;
+    }
+    int slot = bucketOf(value) - offset_;
+    if (slot >= 0 && slot < static_cast<int>(counts_.size()) && counts_[slot] > 0) {
+        counts_[slot]--;
+        count_--;
+    }
+}
+
+uint64_t QuantileSketch::count() const {
+    return count_;
+}
+
+/**
+ * @param fraction A quantile as a fraction in [0, 1].
+ * @return An estimate of the value with that rank, within the relative accuracy, or 0 if the sketch is empty.
+ * Ranks are rounded as in MetricsRegistry::Histogram::percentile().
+ */
+double QuantileSketch::quantile(const double& fraction) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    uint64_t rank = std::min(count_, std::max<uint64_t>(1, static_cast<uint64_t>(fraction * count_ + 0.5)));
+    uint64_t seen = zero_count_;
+    if (seen >= rank) {
+        return 0;
+    }
+    for (size_t i = 0; i < counts_.size(); i++) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            return 2 * std::pow(gamma_, offset_ + static_cast<int>(i)) / (gamma_ + 1);
+        }
+    }
+    return 0;
+}
+
+void QuantileSketch::clear() {
+    count_ = 0;
+    zero_count_ = 0;
+    offset_ = 0;
+    counts_.clear();
+}
+
+/**
+ * @return The bucket holding `value`.
+ * @pre `value` > 0.
+ */
+int QuantileSketch::bucketOf(const double& value) const {
+    return static_cast<int>(std::ceil(std::log(value) / log_gamma_));
+}
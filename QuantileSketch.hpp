@@ -0,0 +1,67 @@
+/**
+ * @file QuantileSketch.hpp
+ * @brief This file contains the declaration of the QuantileSketch class, a small streaming summary that answers
+ * quantile queries with a bounded relative error and supports removing values as well as adding them.
+ *
+ * Positive values are counted in logarithmic buckets: with gamma = (1 + a) / (1 - a) for a relative accuracy a,
+ * bucket i holds values in (gamma^(i-1), gamma^i], and a quantile is reported as the bucket's midpoint
+ * 2 * gamma^i / (gamma + 1), which is within a of every value in the bucket. Values <= 0 share one bucket and
+ * are reported as 0. Because a bucket only holds a count, remove() is a decrement, so the sketch can follow a
+ * kitchen whose dishes come and go. Memory grows with the logarithm of the value range, not with the count.
+ *
+ * MetricsRegistry::Histogram's power-of-two buckets answer to within a factor of two; this sketch is for the
+ * cases where that is too coarse, such as a p95 prep time.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef QUANTILE_SKETCH_HPP
+#define QUANTILE_SKETCH_HPP
+
+#include <cstdint>
+#include <vector>
+
+class QuantileSketch {
+    public:
+        /**
+         * @param relative_accuracy The largest relative error of a reported quantile, in (0, 1).
+         */
+        explicit QuantileSketch(const double& relative_accuracy = 0.01);
+
+        void add(const double& value);
+
+        /**
+         * Removes one occurrence of `value`.
+         * @pre `value` was added and not yet removed.
+         */
+        void remove(const double& value);
+
+        uint64_t count() const;
+
+        /**
+         * @param fraction A quantile as a fraction in [0, 1].
+         * @return An estimate of the value with that rank, within the relative accuracy, or 0 if the sketch is
+         * empty. Ranks are rounded as in MetricsRegistry::Histogram::percentile().
+         */
+        double quantile(const double& fraction) const;
+
+        void clear();
+
+    private:
+        /**
+         * @return The bucket holding `value`.
+         * @pre `value` > 0.
+         */
+        int bucketOf(const double& value) const;
+
+        double gamma_;
+        double log_gamma_;
+        uint64_t count_;
+        uint64_t zero_count_;
+        // counts_[i] is bucket offset_ + i; grown at either end as values arrive.
+        int offset_;
+        std::vector<uint64_t> counts_;
+};
+
+#endif // QUANTILE_SKETCH_HPP
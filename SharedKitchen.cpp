@@ -0,0 +1,356 @@
+/**
+ * @file SharedKitchen.cpp
+ * @brief This file contains the implementation of the SharedKitchen class: segment setup, the seqlock writer and
+ * the in-place reader.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "SharedKitchen.hpp"
+#include "Kitchen.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(SharedKitchen::Control) == 64, "shared kitchen control block layout changed");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the sequence is shared between processes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "the superseded flag is shared between processes");
+
+namespace {
+    const char MAGIC[8] = {'K', 'S', 'H', 'M', 'K', 'T', 'C', 'H'};
+}
+
+SharedKitchen::SharedKitchen()
+    : writer_(false), mapping_(nullptr), mapping_size_(0), control_(nullptr), image_(nullptr), held_(0),
+      retries_(0) {}
+
+/**
+ * Destructor.
+ * @post Unmaps the segment, and removes its name if this object created it.
+ */
+SharedKitchen::~SharedKitchen() {
+    close();
+}
+
+/**
+ * Creates the segment as its writer, replacing any segment of the same name and marking that one superseded.
+ * @param name The shared-memory name, e.g. "/kitchen".
+ * @param capacity The largest image that can be published.
+ * @return True if the segment was created and mapped.
+ */
+bool SharedKitchen::create(const std::string& name, const size_t& capacity) {
+    close();
+    // Readers still attached to a segment of the same name keep it alive until they close it, but new readers
+    // open this one; the old one is marked so that its readers find out.
+    supersede(name);
+    ::shm_unlink(name.c_str());
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t size = sizeof(Control) + capacity;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0 || !map(fd, size, true)) {
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        return false;
+    }
+    ::close(fd);
+    name_ = name;
+    writer_ = true;
+    // ftruncate() zero-filled the segment, so the magic goes in last and a reader that opens it early is refused.
+    control_->version = VERSION;
+    control_->writer_pid = static_cast<int32_t>(::getpid());
+    control_->capacity = capacity;
+    control_->sequence.store(0, std::memory_order_relaxed);
+    control_->image_size.store(0, std::memory_order_relaxed);
+    control_->superseded.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(control_->magic, MAGIC, sizeof(MAGIC));
+    return true;
+}
+
+/**
+ * Opens an existing segment read-only, as one of its readers.
+ * @return True if the segment exists and its control block is valid.
+ */
+bool SharedKitchen::open(const std::string& name) {
+    close();
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Control))
+        || !map(fd, info.st_size, false)) {
+        ::close(fd);
+        return false;
+    }
+    ::close(fd);
+    if (std::memcmp(control_->magic, MAGIC, sizeof(MAGIC)) != 0 || control_->version != VERSION
+        || control_->capacity > mapping_size_ - sizeof(Control)) {
+        close();
+        return false;
+    }
+    name_ = name;
+    return true;
+}
+
+/**
+ * Unmaps the segment. If this object created it, marks it superseded and removes its name, unless another writer
+ * has already replaced it.
+ */
+void SharedKitchen::close() {
+    snapshot_.close();
+    // If the segment was already superseded, the name belongs to the writer that replaced it.
+    bool owns_name = writer_ && control_->superseded.exchange(1, std::memory_order_acq_rel) == 0;
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+    if (owns_name) {
+        ::shm_unlink(name_.c_str());
+    }
+    name_.clear();
+    writer_ = false;
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    control_ = nullptr;
+    image_ = nullptr;
+    held_ = 0;
+}
+
+bool SharedKitchen::isOpen() const {
+    return control_ != nullptr;
+}
+
+bool SharedKitchen::isWriter() const {
+    return writer_;
+}
+
+/**
+ * Publishes every dish in `kitchen`, replacing the previous catalog.
+ * @return False if this is not the writer, the segment was superseded, or the image does not fit.
+ */
+bool SharedKitchen::publish(const Kitchen& kitchen) {
+    return publish(kitchen.toVector());
+}
+
+/**
+ * Publishes `dishes`, in order, replacing the previous catalog.
+ * @return False if this is not the writer, the segment was superseded, or the image does not fit.
+ */
+bool SharedKitchen::publish(const std::vector<Dish*>& dishes) {
+    KITCHEN_TIME_SCOPE("shared_kitchen.publish.ns");
+    KITCHEN_TRACE_SCOPE("SharedKitchen::publish");
+    if (!writer_ || isSuperseded()) {
+        return false;
+    }
+    uint64_t sequence = control_->sequence.load(std::memory_order_relaxed);
+    // The image is built privately first, so the segment is only held odd for the copy.
+    std::vector<char> image = CatalogSnapshot::serialize(dishes, sequence / 2 + 1);
+    if (image.size() > control_->capacity) {
+        return false;
+    }
+    control_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(image_, image.data(), image.size());
+    control_->image_size.store(image.size(), std::memory_order_relaxed);
+    control_->sequence.store(sequence + 2, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @return The number of catalogs published so far; the snapshot of the latest has it as its sequence.
+ */
+uint64_t SharedKitchen::getVersion() const {
+    return control_ == nullptr ? 0 : control_->sequence.load(std::memory_order_acquire) / 2;
+}
+
+/**
+ * Attaches the snapshot to the latest catalog in the segment, if it is newer than the one held. Nothing is copied
+ * but the image's header.
+ * @return True if a newer catalog was attached; false if there was none (isSuperseded() tells whether there ever
+ * will be), if the writer died or was superseded mid-publish, or if it stayed mid-publish for MAX_RETRIES attempts.
+ */
+bool SharedKitchen::refresh() {
+    KITCHEN_TIME_SCOPE("shared_kitchen.refresh.ns");
+    if (control_ == nullptr) {
+        return false;
+    }
+    for (int attempt = 0; attempt < MAX_RETRIES; attempt++) {
+        uint64_t before = control_->sequence.load(std::memory_order_acquire);
+        if (before % 2 == 0) {
+            if (before / 2 == held_) {
+                if (isSuperseded()) {
+                    KITCHEN_COUNTER_ADD("shared_kitchen.superseded", 1);
+                }
+                return false;
+            }
+            // The whole image area is mapped, so the snapshot is bounded by it rather than by image_size; the
+            // header it copies is only trusted if the version is unchanged once it has been checked.
+            bool attached = snapshot_.attach(image_, control_->capacity);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (control_->sequence.load(std::memory_order_relaxed) == before) {
+                held_ = before / 2;
+                return attached;
+            }
+        } else if (attempt == 0 && isSuperseded()) {
+            // The writer was replaced mid-publish and may never finish; the reader should reopen instead.
+            KITCHEN_COUNTER_ADD("shared_kitchen.superseded", 1);
+            return false;
+        } else if (attempt == 0 && isWriterDead()) {
+            KITCHEN_COUNTER_ADD("shared_kitchen.writer_dead", 1);
+            return false;
+        }
+        retries_++;
+        KITCHEN_COUNTER_ADD("shared_kitchen.retries", 1);
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+/**
+ * @return True if the segment still holds the catalog attached by the last refresh(), so that anything read from
+ * it since is consistent.
+ */
+bool SharedKitchen::isCurrent() const {
+    if (control_ == nullptr || !snapshot_.isOpen()) {
+        return false;
+    }
+    // Orders the reads of the image before the load of the version that vouches for them.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return control_->sequence.load(std::memory_order_relaxed) == held_ * 2;
+}
+
+/**
+ * @return True if the segment's writer has closed it or another writer has replaced it, so that no newer catalog
+ * will ever appear in it.
+ */
+bool SharedKitchen::isSuperseded() const {
+    return control_ != nullptr && control_->superseded.load(std::memory_order_acquire) != 0;
+}
+
+/**
+ * @return True if the version is odd and the writer that made it so has exited.
+ */
+bool SharedKitchen::isWriterDead() const {
+    if (control_ == nullptr || control_->sequence.load(std::memory_order_acquire) % 2 == 0) {
+        return false;
+    }
+    return ::kill(static_cast<pid_t>(control_->writer_pid), 0) != 0 && errno == ESRCH;
+}
+
+/**
+ * The attached catalog, read in place in the segment. Its size() is fixed at refresh(); anything else read from
+ * it is only meaningful if isCurrent() is still true afterwards.
+ * @return The catalog attached by the last successful refresh(); closed before the first.
+ */
+const CatalogSnapshot& SharedKitchen::snapshot() const {
+    return snapshot_;
+}
+
+/**
+ * Copies out the record of dish i.
+ * @pre i < snapshot().size()
+ * @return False, leaving `record` unspecified, if the catalog was replaced during the read.
+ */
+bool SharedKitchen::record(const size_t& i, CatalogSnapshot::Record& record) const {
+    record = snapshot_.record(i);
+    return isCurrent();
+}
+
+/**
+ * Builds dish i, as CatalogSnapshot::materialize() does.
+ * @pre i < snapshot().size()
+ * @return The new dish, owned by the caller; nullptr if the record is corrupt or the catalog was replaced during
+ * the read.
+ */
+Dish* SharedKitchen::materialize(const size_t& i) const {
+    Dish* dish = snapshot_.materialize(i);
+    if (!isCurrent()) {
+        delete dish;
+        return nullptr;
+    }
+    return dish;
+}
+
+/**
+ * Materializes every dish of the attached catalog and adds it to `kitchen` through newOrder(). Stops at the first
+ * dish read while the catalog was being replaced; the caller can compare the count with snapshot().size(),
+ * refresh() and load again.
+ * @return The number of dishes the kitchen accepted. Rejected dishes are deallocated.
+ */
+int SharedKitchen::loadInto(Kitchen& kitchen) const {
+    KITCHEN_TIME_SCOPE("shared_kitchen.loadInto.ns");
+    int accepted = 0;
+    for (size_t i = 0; i < snapshot_.size(); i++) {
+        Dish* dish = snapshot_.materialize(i);
+        if (!isCurrent()) {
+            delete dish;
+            KITCHEN_COUNTER_ADD("shared_kitchen.loadInto.torn", 1);
+            break;
+        }
+        if (dish == nullptr) {
+            continue;
+        }
+        if (kitchen.newOrder(dish)) {
+            accepted++;
+        } else {
+            delete dish;
+        }
+    }
+    return accepted;
+}
+
+/**
+ * @return The number of times refresh() tried again because the writer was publishing.
+ */
+uint64_t SharedKitchen::getRetries() const {
+    return retries_;
+}
+
+/**
+ * Marks the segment currently named `name`, if there is one this process may write, superseded.
+ */
+void SharedKitchen::supersede(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(Control))) {
+        void* mapping = ::mmap(nullptr, sizeof(Control), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            Control* control = static_cast<Control*>(mapping);
+            if (std::memcmp(control->magic, MAGIC, sizeof(MAGIC)) == 0 && control->version == VERSION) {
+                control->superseded.store(1, std::memory_order_release);
+            }
+            ::munmap(mapping, sizeof(Control));
+        }
+    }
+    ::close(fd);
+}
+
+/**
+ * Maps `size` bytes of the segment open on `fd`.
+ * @return True if it was mapped.
+ * @post control_ and image_ point into the mapping on success.
+ */
+bool SharedKitchen::map(const int& fd, const size_t& size, const bool& writable) {
+    void* mapping = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mapping_ = mapping;
+    mapping_size_ = size;
+    control_ = static_cast<Control*>(mapping);
+    image_ = static_cast<char*>(mapping) + sizeof(Control);
+    return true;
+}
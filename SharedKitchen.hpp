@@ -0,0 +1,210 @@
+/**
+ * @file SharedKitchen.hpp
+ * @brief This file contains the declaration of the SharedKitchen class, which publishes a catalog of dishes in a
+ * POSIX shared-memory segment so that every process on the machine reads the same copy.
+ *
+ * The segment holds a small control block followed by one CatalogSnapshot image. The image refers to strings
+ * and lists by offset, never by pointer, so it means the same thing at whatever address each process maps it.
+ *
+ * One process creates the segment and publishes into it; any number of others open it read-only. Publishing is
+ * guarded by a sequence lock: the writer makes the version odd, rewrites the image, and makes it even again.
+ * Readers never block the writer or each other, and never copy the image: refresh() attaches the snapshot to
+ * the segment itself, so every process reads the one copy in shared memory. Because the writer may rewrite that
+ * copy at any time, each read (materialize(), record(), loadInto()) copies out only what it returns and then
+ * checks that the version has not moved since refresh(); a read that overlapped a publish fails, and the reader
+ * calls refresh() and tries again. Checking for an update is a single load of the version, so a reader can poll
+ * as often as it likes and sees a new catalog as soon as publish() returns.
+ *
+ * A writer that dies mid-publish leaves the version odd for good. The writer records its process id in the
+ * control block, and refresh() gives up at once when the version is odd and that process no longer exists,
+ * rather than spinning through MAX_RETRIES on every call. The check cannot see through PID reuse or across PID
+ * namespaces; there a dead writer is only noticed as a refresh() that keeps running out of retries. Either way
+ * the segment stays unreadable until a new writer create()s the name again, which marks it superseded.
+ *
+ * A writer that create()s a segment under a name already in use, or close()s its own, unlinks the old segment.
+ * Readers still attached to it keep it mapped but would never see another publish, so the segment is first
+ * marked superseded: once a reader's refresh() has nothing newer to attach, isSuperseded() tells it to open() the
+ * name again rather than keep polling. A writer whose segment was superseded by another stops publishing and
+ * leaves the name to its successor.
+ *
+ * The segment's size is fixed when it is created; a catalog whose image does not fit is not published.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef SHARED_KITCHEN_HPP
+#define SHARED_KITCHEN_HPP
+
+#include "CatalogSnapshot.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Kitchen;
+
+class SharedKitchen {
+    public:
+        static const uint32_t VERSION = 3;
+        static constexpr size_t DEFAULT_CAPACITY = 64 << 20;
+
+        /**
+         * The number of times refresh() retries while the writer is mid-publish before giving up, so that a
+         * writer which died mid-publish cannot hang its readers even when its death cannot be detected.
+         */
+        static constexpr int MAX_RETRIES = 1000;
+
+        /**
+         * @struct Control
+         * @brief The start of the segment. The image follows it.
+         */
+        struct alignas(64) Control {
+            char magic[8];                          ///< "KSHMKTCH"
+            uint32_t version;
+            int32_t writer_pid;                     ///< The process that created the segment and publishes.
+            uint64_t capacity;                      ///< The bytes available for the image.
+            std::atomic<uint64_t> sequence;         ///< Odd while the writer is publishing.
+            std::atomic<uint64_t> image_size;       ///< 0 until the first publish.
+            std::atomic<uint32_t> superseded;       ///< 1 once the segment's name no longer leads to it.
+        };
+
+        SharedKitchen();
+
+        /**
+         * Destructor.
+         * @post Unmaps the segment, and removes its name if this object created it.
+         */
+        ~SharedKitchen();
+
+        SharedKitchen(const SharedKitchen&) = delete;
+        SharedKitchen& operator=(const SharedKitchen&) = delete;
+
+        /**
+         * Creates the segment as its writer, replacing any segment of the same name and marking that one
+         * superseded.
+         * @param name The shared-memory name, e.g. "/kitchen".
+         * @param capacity The largest image that can be published.
+         * @return True if the segment was created and mapped.
+         */
+        bool create(const std::string& name, const size_t& capacity = DEFAULT_CAPACITY);
+
+        /**
+         * Opens an existing segment read-only, as one of its readers.
+         * @return True if the segment exists and its control block is valid.
+         */
+        bool open(const std::string& name);
+
+        /**
+         * Unmaps the segment. If this object created it, marks it superseded and removes its name, unless
+         * another writer has already replaced it.
+         */
+        void close();
+
+        bool isOpen() const;
+        bool isWriter() const;
+
+        /**
+         * Publishes every dish in `kitchen`, replacing the previous catalog.
+         * @return False if this is not the writer, the segment was superseded, or the image does not fit.
+         */
+        bool publish(const Kitchen& kitchen);
+
+        /**
+         * Publishes `dishes`, in order, replacing the previous catalog.
+         * @return False if this is not the writer, the segment was superseded, or the image does not fit.
+         */
+        bool publish(const std::vector<Dish*>& dishes);
+
+        /**
+         * @return The number of catalogs published so far; the snapshot of the latest has it as its sequence.
+         */
+        uint64_t getVersion() const;
+
+        /**
+         * Attaches the snapshot to the latest catalog in the segment, if it is newer than the one held. Nothing
+         * is copied but the image's header.
+         * @return True if a newer catalog was attached; false if there was none (isSuperseded() tells whether
+         * there ever will be), if the writer died or was superseded mid-publish, or if it stayed mid-publish for
+         * MAX_RETRIES attempts.
+         */
+        bool refresh();
+
+        /**
+         * @return True if the segment's writer has closed it or another writer has replaced it, so that no
+         * newer catalog will ever appear in it; the reader should open() the name again.
+         */
+        bool isSuperseded() const;
+
+        /**
+         * @return True if the segment still holds the catalog attached by the last refresh(), so that anything
+         * read from it since is consistent.
+         */
+        bool isCurrent() const;
+
+        /**
+         * @return True if the version is odd and the writer that made it so has exited.
+         */
+        bool isWriterDead() const;
+
+        /**
+         * The attached catalog, read in place in the segment. Its size() is fixed at refresh(); anything else
+         * read from it is only meaningful if isCurrent() is still true afterwards.
+         * @return The catalog attached by the last successful refresh(); closed before the first.
+         */
+        const CatalogSnapshot& snapshot() const;
+
+        /**
+         * Copies out the record of dish i.
+         * @pre i < snapshot().size()
+         * @return False, leaving `record` unspecified, if the catalog was replaced during the read.
+         */
+        bool record(const size_t& i, CatalogSnapshot::Record& record) const;
+
+        /**
+         * Builds dish i, as CatalogSnapshot::materialize() does.
+         * @pre i < snapshot().size()
+         * @return The new dish, owned by the caller; nullptr if the record is corrupt or the catalog was
+         * replaced during the read.
+         */
+        Dish* materialize(const size_t& i) const;
+
+        /**
+         * Materializes every dish of the attached catalog and adds it to `kitchen` through newOrder(). Stops
+         * at the first dish read while the catalog was being replaced; the caller can compare the count with
+         * snapshot().size(), refresh() and load again.
+         * @return The number of dishes the kitchen accepted. Rejected dishes are deallocated.
+         */
+        int loadInto(Kitchen& kitchen) const;
+
+        /**
+         * @return The number of times refresh() tried again because the writer was publishing.
+         */
+        uint64_t getRetries() const;
+
+    private:
+        /**
+         * Marks the segment currently named `name`, if there is one this process may write, superseded.
+         */
+        static void supersede(const std::string& name);
+
+        /**
+         * Maps `size` bytes of the segment open on `fd`.
+         * @return True if it was mapped.
+         * @post control_ and image_ point into the mapping on success.
+         */
+        bool map(const int& fd, const size_t& size, const bool& writable);
+
+        std::string name_;
+        bool writer_;
+        void* mapping_;
+        size_t mapping_size_;
+        Control* control_;
+        char* image_;
+        uint64_t held_;
+        uint64_t retries_;
+        CatalogSnapshot snapshot_;
+};
+
+#endif // SHARED_KITCHEN_HPP
@@ -0,0 +1,308 @@
+/**
+ * @file SmallVector.cpp
+ * @brief This file contains the implementation of the SmallVector class template. It is included by
+ * SmallVector.hpp and not compiled on its own.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "SmallVector.hpp"
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <utility>
+
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector() : data_(inlineData()), size_(0), capacity_(N) {}
+
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector(std::initializer_list<T> values) : SmallVector() {
+    append(values.begin(), values.end());
+}
+
+/**
+ * Copies `values`. Implicit, so that code written against std::vector keeps passing one.
+ */
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector(const std::vector<T>& values) : SmallVector() {
+    append(values.begin(), values.end());
+}
+
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& other) : SmallVector() {
+    append(other.begin(), other.end());
+}
+
+/**
+ * Takes over `other`'s heap block, or moves its elements one by one if they are inline.
+ * @post `other` is empty.
+ */
+template <class T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept : SmallVector() {
+    *this = std::move(other);
+}
+
+template <class T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other) {
+    if (this != &other) {
+        clear();
+        append(other.begin(), other.end());
+    }
+    return *this;
+}
+
+template <class T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    release();
+    if (other.isInline()) {
+        for (size_t i = 0; i < other.size_; i++) {
+            new (data_ + i) T(std::move(other.data_[i]));
+        }
+        size_ = other.size_;
+        other.clear();
+    } else {
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = other.inlineData();
+        other.size_ = 0;
+        other.capacity_ = N;
+    }
+    return *this;
+}
+
+template <class T, size_t N>
+SmallVector<T, N>::~SmallVector() {
+    release();
+}
+
+template <class T, size_t N>
+size_t SmallVector<T, N>::size() const {
+    return size_;
+}
+
+template <class T, size_t N>
+bool SmallVector<T, N>::empty() const {
+    return size_ == 0;
+}
+
+/**
+ * @return The number of elements held before the next growth; N while inline.
+ */
+template <class T, size_t N>
+size_t SmallVector<T, N>::capacity() const {
+    return capacity_;
+}
+
+/**
+ * @return True if the elements are still inside the object.
+ */
+template <class T, size_t N>
+bool SmallVector<T, N>::isInline() const {
+    return data_ == reinterpret_cast<const T*>(inline_);
+}
+
+template <class T, size_t N>
+T* SmallVector<T, N>::data() {
+    return data_;
+}
+
+template <class T, size_t N>
+const T* SmallVector<T, N>::data() const {
+    return data_;
+}
+
+template <class T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::begin() {
+    return data_;
+}
+
+template <class T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::end() {
+    return data_ + size_;
+}
+
+template <class T, size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::begin() const {
+    return data_;
+}
+
+template <class T, size_t N>
+typename SmallVector<T, N>::const_iterator SmallVector<T, N>::end() const {
+    return data_ + size_;
+}
+
+template <class T, size_t N>
+T& SmallVector<T, N>::operator[](const size_t& index) {
+    return data_[index];
+}
+
+template <class T, size_t N>
+const T& SmallVector<T, N>::operator[](const size_t& index) const {
+    return data_[index];
+}
+
+template <class T, size_t N>
+T& SmallVector<T, N>::front() {
+    return data_[0];
+}
+
+template <class T, size_t N>
+const T& SmallVector<T, N>::front() const {
+    return data_[0];
+}
+
+template <class T, size_t N>
+T& SmallVector<T, N>::back() {
+    return data_[size_ - 1];
+}
+
+template <class T, size_t N>
+const T& SmallVector<T, N>::back() const {
+    return data_[size_ - 1];
+}
+
+template <class T, size_t N>
+void SmallVector<T, N>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template <class T, size_t N>
+void SmallVector<T, N>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+template <class T, size_t N>
+template <class... Args>
+T& SmallVector<T, N>::emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+        // The arguments may refer to an element, so the new one is built before the old ones move.
+        T value(std::forward<Args>(args)...);
+        grow(capacity_ * 2);
+        new (data_ + size_) T(std::move(value));
+    } else {
+        new (data_ + size_) T(std::forward<Args>(args)...);
+    }
+    return data_[size_++];
+}
+
+template <class T, size_t N>
+void SmallVector<T, N>::pop_back() {
+    data_[--size_].~T();
+}
+
+/**
+ * Removes the elements in [first, last), keeping the order of the rest.
+ * @return An iterator to the element that followed the removed ones.
+ */
+template <class T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::erase(const_iterator first, const_iterator last) {
+    iterator from = data_ + (first - data_);
+    if (first == last) {
+        return from;
+    }
+    iterator kept_end = std::move(data_ + (last - data_), end(), from);
+    while (end() != kept_end) {
+        pop_back();
+    }
+    return from;
+}
+
+template <class T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::erase(const_iterator position) {
+    return erase(position, position + 1);
+}
+
+/**
+ * Destroys every element. The storage is kept.
+ */
+template <class T, size_t N>
+void SmallVector<T, N>::clear() {
+    while (size_ > 0) {
+        pop_back();
+    }
+}
+
+/**
+ * Ensures room for `capacity` elements, moving them to the heap if they do not fit inline.
+ */
+template <class T, size_t N>
+void SmallVector<T, N>::reserve(const size_t& capacity) {
+    if (capacity > capacity_) {
+        grow(capacity);
+    }
+}
+
+/**
+ * @return The elements as a std::vector, in order.
+ */
+template <class T, size_t N>
+std::vector<T> SmallVector<T, N>::toVector() const {
+    return std::vector<T>(begin(), end());
+}
+
+template <class T, size_t N>
+bool SmallVector<T, N>::operator==(const SmallVector& rhs) const {
+    return size_ == rhs.size_ && std::equal(begin(), end(), rhs.begin());
+}
+
+template <class T, size_t N>
+bool SmallVector<T, N>::operator!=(const SmallVector& rhs) const {
+    return !(*this == rhs);
+}
+
+template <class T, size_t N>
+T* SmallVector<T, N>::inlineData() {
+    return reinterpret_cast<T*>(inline_);
+}
+
+/**
+ * Copies [first, last) to the end, growing first if needed.
+ */
+template <class T, size_t N>
+template <class Iterator>
+void SmallVector<T, N>::append(Iterator first, Iterator last) {
+    size_t needed = size_ + static_cast<size_t>(std::distance(first, last));
+    if (needed > capacity_) {
+        grow(std::max(needed, capacity_ * 2));
+    }
+    for (; first != last; ++first) {
+        new (data_ + size_) T(*first);
+        size_++;
+    }
+}
+
+/**
+ * Moves the elements to a heap block with room for `capacity`.
+ * @pre capacity > capacity_
+ */
+template <class T, size_t N>
+void SmallVector<T, N>::grow(const size_t& capacity) {
+    T* block = static_cast<T*>(::operator new(capacity * sizeof(T)));
+    for (size_t i = 0; i < size_; i++) {
+        new (block + i) T(std::move(data_[i]));
+        data_[i].~T();
+    }
+    if (!isInline()) {
+        ::operator delete(data_);
+    }
+    data_ = block;
+    capacity_ = capacity;
+}
+
+/**
+ * Destroys every element and frees the heap block, if any, leaving an empty inline container.
+ */
+template <class T, size_t N>
+void SmallVector<T, N>::release() {
+    clear();
+    if (!isInline()) {
+        ::operator delete(data_);
+        data_ = inlineData();
+        capacity_ = N;
+    }
+}
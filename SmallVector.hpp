@@ -0,0 +1,149 @@
+/**
+ * @file SmallVector.hpp
+ * @brief This file contains the declaration of the SmallVector class template, a vector that keeps its first N
+ * elements inside the object and only moves them to the heap when it outgrows them.
+ *
+ * Dishes hold short lists: a few ingredients, one to three side dishes. With std::vector each list is a
+ * separate heap block, so building a dish costs an allocation per list and reading one costs a pointer chase to
+ * a different cache line. A SmallVector sized for the typical list keeps the elements next to the rest of the
+ * dish and allocates only for the rare long list.
+ *
+ * Elements are contiguous either way, so iterators are plain pointers. Like std::vector, growing or moving the
+ * container invalidates them; unlike std::vector, so does moving an inline container, whose elements are moved
+ * one by one rather than handed over.
+ *
+ * Like ArrayBag, the definitions are in SmallVector.cpp, which this header includes.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+template <class T, size_t N>
+class SmallVector {
+    public:
+        typedef T value_type;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+
+        SmallVector();
+
+        SmallVector(std::initializer_list<T> values);
+
+        /**
+         * Copies `values`. Implicit, so that code written against std::vector keeps passing one.
+         */
+        SmallVector(const std::vector<T>& values);
+
+        SmallVector(const SmallVector& other);
+
+        /**
+         * Takes over `other`'s heap block, or moves its elements one by one if they are inline.
+         * @post `other` is empty.
+         */
+        SmallVector(SmallVector&& other) noexcept;
+
+        SmallVector& operator=(const SmallVector& other);
+
+        SmallVector& operator=(SmallVector&& other) noexcept;
+
+        ~SmallVector();
+
+        size_t size() const;
+
+        bool empty() const;
+
+        /**
+         * @return The number of elements held before the next growth; N while inline.
+         */
+        size_t capacity() const;
+
+        /**
+         * @return True if the elements are still inside the object.
+         */
+        bool isInline() const;
+
+        T* data();
+        const T* data() const;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+
+        T& operator[](const size_t& index);
+        const T& operator[](const size_t& index) const;
+
+        T& front();
+        const T& front() const;
+        T& back();
+        const T& back() const;
+
+        void push_back(const T& value);
+        void push_back(T&& value);
+
+        template <class... Args>
+        T& emplace_back(Args&&... args);
+
+        void pop_back();
+
+        /**
+         * Removes the elements in [first, last), keeping the order of the rest.
+         * @return An iterator to the element that followed the removed ones.
+         */
+        iterator erase(const_iterator first, const_iterator last);
+
+        iterator erase(const_iterator position);
+
+        /**
+         * Destroys every element. The storage is kept.
+         */
+        void clear();
+
+        /**
+         * Ensures room for `capacity` elements, moving them to the heap if they do not fit inline.
+         */
+        void reserve(const size_t& capacity);
+
+        /**
+         * @return The elements as a std::vector, in order.
+         */
+        std::vector<T> toVector() const;
+
+        bool operator==(const SmallVector& rhs) const;
+        bool operator!=(const SmallVector& rhs) const;
+
+    private:
+        T* inlineData();
+
+        /**
+         * Copies [first, last) to the end, growing first if needed.
+         */
+        template <class Iterator>
+        void append(Iterator first, Iterator last);
+
+        /**
+         * Moves the elements to a heap block with room for `capacity`.
+         * @pre capacity > capacity_
+         */
+        void grow(const size_t& capacity);
+
+        /**
+         * Destroys every element and frees the heap block, if any, leaving an empty inline container.
+         */
+        void release();
+
+        T* data_;
+        size_t size_;
+        size_t capacity_;
+        alignas(T) unsigned char inline_[N * sizeof(T)];
+};
+
+#include "SmallVector.cpp"
+#endif // SMALL_VECTOR_HPP
@@ -0,0 +1,200 @@
+/**
+ * @file Trace.cpp
+ * @brief This file contains the implementation of the Trace class: per-thread event buffers and the Chrome
+ * trace-event exporter.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Trace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    struct Event {
+        const char* name;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+    };
+
+    /**
+     * One thread's events. Only the owning thread writes `events` and `count`; readers load `count` with
+     * acquire ordering and then read that many events.
+     */
+    struct ThreadBuffer {
+        int tid;
+        std::unique_ptr<Event[]> events;
+        size_t capacity;
+        std::atomic<size_t> count;
+        std::atomic<uint64_t> dropped;
+
+        ThreadBuffer(int id, size_t size)
+            : tid(id), events(new Event[size]), capacity(size), count(0), dropped(0) {}
+    };
+
+    std::mutex registry_mutex;
+    // Buffers outlive their threads so that events from finished threads can still be exported.
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+    std::atomic<size_t> buffer_capacity(Trace::DEFAULT_EVENTS_PER_THREAD);
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    ThreadBuffer& localBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            registry.emplace_back(new ThreadBuffer(static_cast<int>(registry.size()) + 1,
+                                                   buffer_capacity.load(std::memory_order_relaxed)));
+            buffer = registry.back().get();
+        }
+        return *buffer;
+    }
+
+    /**
+     * Writes `text` as a JSON string literal, escaping quotes, backslashes and control characters.
+     */
+    void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\' << *c;
+            } else if (static_cast<unsigned char>(*c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                out << escaped;
+            } else {
+                out << *c;
+            }
+        }
+        out << '"';
+    }
+
+    /**
+     * Writes a nanosecond count as microseconds with three decimals, the unit trace viewers expect.
+     */
+    void writeMicros(std::ostream& out, const uint64_t& ns) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                      static_cast<unsigned long long>(ns % 1000));
+        out << text;
+    }
+}
+
+std::atomic<bool> Trace::enabled_(false);
+
+/**
+ * Starts recording.
+ * @param events_per_thread The capacity of buffers created from now on. Threads that already have a
+ * buffer keep it.
+ */
+void Trace::start(const size_t& events_per_thread) {
+    buffer_capacity.store(events_per_thread > 0 ? events_per_thread : 1, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * Stops recording. Recorded events are kept until clear().
+ */
+void Trace::stop() {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Records one complete span for the calling thread.
+ * @param name A string with static storage duration, such as a literal.
+ * @param start_ns The start time from now().
+ * @param end_ns The end time from now().
+ */
+void Trace::record(const char* name, const uint64_t& start_ns, const uint64_t& end_ns) {
+    ThreadBuffer& buffer = localBuffer();
+    size_t slot = buffer.count.load(std::memory_order_relaxed);
+    if (slot >= buffer.capacity) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events[slot] = {name, start_ns, end_ns - start_ns};
+    buffer.count.store(slot + 1, std::memory_order_release);
+}
+
+/**
+ * @return Nanoseconds since the trace clock's epoch.
+ */
+uint64_t Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+/**
+ * Writes every recorded event as a Chrome trace-event JSON document.
+ * @param out The stream to write to.
+ */
+void Trace::writeChromeJson(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+        out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+            << buffer->tid << ", \"args\": {\"name\": \"thread " << buffer->tid << "\"}}";
+        first = false;
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++) {
+            const Event& event = buffer->events[i];
+            out << ",\n{\"name\": ";
+            writeJsonString(out, event.name);
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid << ", \"ts\": ";
+            writeMicros(out, event.start_ns);
+            out << ", \"dur\": ";
+            writeMicros(out, event.duration_ns);
+            out << "}";
+        }
+    }
+    out << "\n], \"otherData\": {\"dropped_events\": " << droppedEventsLocked() << "}}" << std::endl;
+}
+
+/**
+ * Writes the Chrome trace-event JSON to `path`.
+ * @return True if the file was written.
+ */
+bool Trace::exportToFile(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    writeChromeJson(out);
+    return static_cast<bool>(out);
+}
+
+/**
+ * @return The number of events dropped because a thread's buffer was full.
+ */
+uint64_t Trace::droppedEvents() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    return droppedEventsLocked();
+}
+
+/**
+ * Discards every recorded event.
+ * @pre No thread is recording, i.e. stop() was called and in-flight spans have finished.
+ */
+void Trace::clear() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @pre registry_mutex is held.
+ * @return The number of events dropped across every buffer.
+ */
+uint64_t Trace::droppedEventsLocked() {
+    uint64_t dropped = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
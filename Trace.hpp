@@ -0,0 +1,146 @@
+/**
+ * @file Trace.hpp
+ * @brief This file contains the declaration of the Trace class and TraceSpan, a scoped timeline recorder that
+ * exports Chrome trace-event JSON (viewable in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * Spans are compiled in only when KITCHEN_TRACE is defined (`make rebuild TRACE=1`); otherwise every
+ * KITCHEN_TRACE_* macro expands to nothing. When compiled in, recording is still off until Trace::start()
+ * is called, and a span then costs a single relaxed atomic load.
+ *
+ * Each thread records into its own fixed-size buffer, which is registered once under a mutex and then written
+ * without locks: the owning thread fills the next slot and publishes it with a release store of the count.
+ * Events past the buffer's capacity are dropped and counted rather than blocking or reallocating.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+class Trace {
+    public:
+        static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 1 << 18;
+
+        /**
+         * Starts recording.
+         * @param events_per_thread The capacity of buffers created from now on. Threads that already have a
+         * buffer keep it.
+         */
+        static void start(const size_t& events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+
+        /**
+         * Stops recording. Recorded events are kept until clear().
+         */
+        static void stop();
+
+        /**
+         * @return True if spans are currently being recorded.
+         */
+        static bool enabled() {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Records one complete span for the calling thread.
+         * @param name A string with static storage duration, such as a literal.
+         * @param start_ns The start time from now().
+         * @param end_ns The end time from now().
+         */
+        static void record(const char* name, const uint64_t& start_ns, const uint64_t& end_ns);
+
+        /**
+         * @return Nanoseconds since the trace clock's epoch.
+         */
+        static uint64_t now();
+
+        /**
+         * Writes every recorded event as a Chrome trace-event JSON document.
+         * @param out The stream to write to.
+         */
+        static void writeChromeJson(std::ostream& out);
+
+        /**
+         * Writes the Chrome trace-event JSON to `path`.
+         * @return True if the file was written.
+         */
+        static bool exportToFile(const std::string& path);
+
+        /**
+         * @return The number of events dropped because a thread's buffer was full.
+         */
+        static uint64_t droppedEvents();
+
+        /**
+         * Discards every recorded event.
+         * @pre No thread is recording, i.e. stop() was called and in-flight spans have finished.
+         */
+        static void clear();
+
+    private:
+        static uint64_t droppedEventsLocked();
+
+        static std::atomic<bool> enabled_;
+};
+
+/**
+ * Records the time from its construction (or begin()) to end() or destruction as one span.
+ */
+class TraceSpan {
+    public:
+        explicit TraceSpan(const char* name) {
+            begin(name);
+        }
+
+        ~TraceSpan() {
+            end();
+        }
+
+        /**
+         * Ends the current span, if any, and starts a new one called `name`.
+         */
+        void begin(const char* name) {
+            end();
+            name_ = Trace::enabled() ? name : nullptr;
+            if (name_ != nullptr) {
+                start_ns_ = Trace::now();
+            }
+        }
+
+        /**
+         * Ends the span. Later calls do nothing until begin() is called again.
+         */
+        void end() {
+            if (name_ != nullptr) {
+                Trace::record(name_, start_ns_, Trace::now());
+                name_ = nullptr;
+            }
+        }
+
+    private:
+        const char* name_ = nullptr;
+        uint64_t start_ns_ = 0;
+};
+
+#ifdef KITCHEN_TRACE
+#define KITCHEN_TRACE_SCOPE(name) TraceSpan KITCHEN_TRACE_CONCAT(kitchen_trace_span_, __LINE__)(name)
+#define KITCHEN_TRACE_BEGIN(span, name) TraceSpan span(name)
+#define KITCHEN_TRACE_RESTART(span, name) span.begin(name)
+#define KITCHEN_TRACE_END(span) span.end()
+#else
+#define KITCHEN_TRACE_SCOPE(name) do {} while (0)
+#define KITCHEN_TRACE_BEGIN(span, name) do {} while (0)
+#define KITCHEN_TRACE_RESTART(span, name) do {} while (0)
+#define KITCHEN_TRACE_END(span) do {} while (0)
+#endif
+
+#define KITCHEN_TRACE_CONCAT_(a, b) a##b
+#define KITCHEN_TRACE_CONCAT(a, b) KITCHEN_TRACE_CONCAT_(a, b)
+
+#endif // TRACE_HPP
@@ -0,0 +1,191 @@
+/**
+ * @file ValueKitchen.cpp
+ * @brief This file contains the implementation of the ValueKitchen class.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "ValueKitchen.hpp"
+#include "DishCodec.hpp"
+#include "KitchenIndex.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+
+namespace {
+    /**
+     * Removes the dishes for which `released` is true, keeping the order of the rest.
+     * @return The number removed.
+     */
+    template <class Predicate>
+    int releaseIf(std::vector<ValueKitchen::DishValue>& dishes, Predicate released) {
+        auto kept_end = std::remove_if(dishes.begin(), dishes.end(), [&](const ValueKitchen::DishValue& value) {
+            return released(ValueKitchen::asDish(value));
+        });
+        int count = static_cast<int>(dishes.end() - kept_end);
+        dishes.erase(kept_end, dishes.end());
+        return count;
+    }
+}
+
+ValueKitchen::ValueKitchen() {}
+
+/**
+ * Reads dishes from a CSV file in the format the Kitchen constructor reads, skipping its header line and rows
+ * Kitchen::parseDish() rejects.
+ */
+ValueKitchen::ValueKitchen(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        std::unique_ptr<Dish> dish(Kitchen::parseDish(line));
+        if (dish != nullptr) {
+            newOrder(valueOf(*dish));
+        }
+    }
+}
+
+/**
+ * Copies every dish of `kitchen`, in kitchen order.
+ */
+ValueKitchen::ValueKitchen(const Kitchen& kitchen) {
+    dishes_.reserve(kitchen.getCurrentSize());
+    for (const Dish* dish : kitchen.toVector()) {
+        dishes_.push_back(valueOf(*dish));
+    }
+}
+
+/**
+ * @return A copy of `dish` as a value.
+ */
+ValueKitchen::DishValue ValueKitchen::valueOf(const Dish& dish) {
+    if (typeid(dish) == typeid(Appetizer)) {
+        return static_cast<const Appetizer&>(dish);
+    }
+    if (typeid(dish) == typeid(MainCourse)) {
+        return static_cast<const MainCourse&>(dish);
+    }
+    return static_cast<const Dessert&>(dish);
+}
+
+/**
+ * @return The dish held by `value`, for the operations every dish shares.
+ */
+const Dish& ValueKitchen::asDish(const DishValue& value) {
+    return std::visit([](const Dish& dish) -> const Dish& { return dish; }, value);
+}
+
+Dish& ValueKitchen::asDish(DishValue& value) {
+    return std::visit([](Dish& dish) -> Dish& { return dish; }, value);
+}
+
+/**
+ * Adds `dish` at the end. Unlike Kitchen, there is no capacity limit and no duplicate check, since every value
+ * is a dish of its own.
+ */
+void ValueKitchen::newOrder(DishValue dish) {
+    dishes_.push_back(std::move(dish));
+}
+
+int ValueKitchen::getCurrentSize() const {
+    return static_cast<int>(dishes_.size());
+}
+
+/**
+ * @return The dishes, in order. Valid until the kitchen is next changed.
+ */
+const std::vector<ValueKitchen::DishValue>& ValueKitchen::getDishes() const {
+    return dishes_;
+}
+
+int ValueKitchen::getPrepTimeSum() const {
+    int sum = 0;
+    for (const DishValue& value : dishes_) {
+        sum += asDish(value).getPrepTime();
+    }
+    return sum;
+}
+
+/**
+ * @return The average prep time, rounded to the nearest minute, as Kitchen::calculateAvgPrepTime().
+ */
+int ValueKitchen::calculateAvgPrepTime() const {
+    if (dishes_.empty()) {
+        return 0;
+    }
+    return static_cast<int>(std::round(static_cast<double>(getPrepTimeSum()) / dishes_.size()));
+}
+
+/**
+ * @return The number of dishes with at least 5 ingredients and a prep time of at least 60 minutes.
+ */
+int ValueKitchen::elaborateDishCount() const {
+    int count = 0;
+    for (const DishValue& value : dishes_) {
+        const Dish& dish = asDish(value);
+        count += dish.getIngredientList().size() >= 5 && dish.getPrepTime() >= 60;
+    }
+    return count;
+}
+
+/**
+ * @param cuisine_type A cuisine name, e.g. "ITALIAN".
+ */
+int ValueKitchen::tallyCuisineTypes(const std::string& cuisine_type) const {
+    int cuisine = KitchenIndex::cuisineFromName(cuisine_type);
+    int count = 0;
+    for (const DishValue& value : dishes_) {
+        count += DishCodec::cuisineOf(asDish(value)) == cuisine;
+    }
+    return count;
+}
+
+/**
+ * Releases every dish with a prep time below `prep_time`, keeping the order of the rest.
+ * @return The number of dishes released.
+ */
+int ValueKitchen::releaseDishesBelowPrepTime(const int& prep_time) {
+    return releaseIf(dishes_, [&](const Dish& dish) { return dish.getPrepTime() < prep_time; });
+}
+
+/**
+ * Releases every dish of `cuisine_type`, keeping the order of the rest.
+ * @return The number of dishes released.
+ */
+int ValueKitchen::releaseDishesOfCuisineType(const std::string& cuisine_type) {
+    int cuisine = KitchenIndex::cuisineFromName(cuisine_type);
+    return releaseIf(dishes_, [&](const Dish& dish) { return DishCodec::cuisineOf(dish) == cuisine; });
+}
+
+/**
+ * Applies `request` to every dish, as Kitchen::dietaryAdjustment().
+ */
+void ValueKitchen::dietaryAdjustment(const Dish::DietaryRequest& request) {
+    KITCHEN_TIME_SCOPE("valueKitchen.dietaryAdjustment.ns");
+    for (DishValue& value : dishes_) {
+        // The qualified call names the exact override, so it is a direct call the compiler may inline rather
+        // than a lookup through the vtable.
+        std::visit([&](auto& dish) {
+            typedef typename std::decay<decltype(dish)>::type Exact;
+            dish.Exact::dietaryAccommodations(request);
+        }, value);
+    }
+}
+
+/**
+ * Displays every dish, as Kitchen::displayMenu().
+ */
+void ValueKitchen::displayMenu() const {
+    for (const DishValue& value : dishes_) {
+        std::visit([](const auto& dish) {
+            typedef typename std::decay<decltype(dish)>::type Exact;
+            dish.Exact::display();
+        }, value);
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file ValueKitchen.hpp
+ * @brief This file contains the declaration of the ValueKitchen class, a kitchen that stores its dishes by
+ * value in one contiguous array instead of as pointers to separately allocated dishes.
+ *
+ * The Dish hierarchy is closed: every dish is an Appetizer, a MainCourse or a Dessert. A ValueKitchen holds
+ * each as a std::variant of the three and dispatches with std::visit, which switches on the variant's index
+ * and calls the subclass's own member directly. Bulk operations therefore walk memory in order, with no
+ * pointer chase per dish and no virtual call the compiler cannot inline; the branch on the index is well
+ * predicted because dish types repeat in runs.
+ *
+ * Every slot is as large as the largest alternative, a MainCourse, so the array costs more memory per dish
+ * than pointers to exact-size objects, and dishes move when the array grows or dishes are released. There is
+ * no capacity limit and no index, journal or cache; this is the representation for bulk passes over a fixed
+ * menu, while Kitchen remains the one that hands out stable `Dish*`.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef VALUE_KITCHEN_HPP
+#define VALUE_KITCHEN_HPP
+
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "Kitchen.hpp"
+#include "MainCourse.hpp"
+#include <string>
+#include <variant>
+#include <vector>
+
+class ValueKitchen {
+    public:
+        typedef std::variant<Appetizer, MainCourse, Dessert> DishValue;
+
+        ValueKitchen();
+
+        /**
+         * Reads dishes from a CSV file in the format the Kitchen constructor reads, skipping its header line
+         * and rows Kitchen::parseDish() rejects.
+         */
+        explicit ValueKitchen(const std::string& filename);
+
+        /**
+         * Copies every dish of `kitchen`, in kitchen order.
+         */
+        explicit ValueKitchen(const Kitchen& kitchen);
+
+        /**
+         * @return A copy of `dish` as a value.
+         */
+        static DishValue valueOf(const Dish& dish);
+
+        /**
+         * @return The dish held by `value`, for the operations every dish shares.
+         */
+        static const Dish& asDish(const DishValue& value);
+        static Dish& asDish(DishValue& value);
+
+        /**
+         * Adds `dish` at the end. Unlike Kitchen, there is no capacity limit and no duplicate check, since
+         * every value is a dish of its own.
+         */
+        void newOrder(DishValue dish);
+
+        int getCurrentSize() const;
+
+        /**
+         * @return The dishes, in order. Valid until the kitchen is next changed.
+         */
+        const std::vector<DishValue>& getDishes() const;
+
+        int getPrepTimeSum() const;
+
+        /**
+         * @return The average prep time, rounded to the nearest minute, as Kitchen::calculateAvgPrepTime().
+         */
+        int calculateAvgPrepTime() const;
+
+        /**
+         * @return The number of dishes with at least 5 ingredients and a prep time of at least 60 minutes.
+         */
+        int elaborateDishCount() const;
+
+        /**
+         * @param cuisine_type A cuisine name, e.g. "ITALIAN".
+         */
+        int tallyCuisineTypes(const std::string& cuisine_type) const;
+
+        /**
+         * Releases every dish with a prep time below `prep_time`, keeping the order of the rest.
+         * @return The number of dishes released.
+         */
+        int releaseDishesBelowPrepTime(const int& prep_time);
+
+        /**
+         * Releases every dish of `cuisine_type`, keeping the order of the rest.
+         * @return The number of dishes released.
+         */
+        int releaseDishesOfCuisineType(const std::string& cuisine_type);
+
+        /**
+         * Applies `request` to every dish, as Kitchen::dietaryAdjustment().
+         */
+        void dietaryAdjustment(const Dish::DietaryRequest& request);
+
+        /**
+         * Displays every dish, as Kitchen::displayMenu().
+         */
+        void displayMenu() const;
+
+    private:
+        std::vector<DishValue> dishes_;
+};
+
+#endif // VALUE_KITCHEN_HPP
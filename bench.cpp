@@ -0,0 +1,833 @@
+/**
+ * @file bench.cpp
+ * @brief Benchmark suite covering every ArrayBag and Kitchen operation at several catalog sizes.
+ *
+ * Usage: bench [--sizes N1,N2,...] [--warmup W] [--reps R] [--filter SUBSTRING] [--format text|csv|json]
+ *              [--out FILE] [--metrics FILE] [--trace FILE]
+ *
+ * Catalogs are synthetic and deterministic: dish i always has the same type, name, ingredients, prep time,
+ * price and cuisine, so runs on different commits are comparable. Sizes above Kitchen::DEFAULT_CAPACITY are
+ * skipped. The Makefile passes -DBENCH_CAPACITY=$(BENCH_CAPACITY), and the build stops if the kitchen cannot hold
+ * that many dishes, so a larger BENCH_CAPACITY needs an ArrayBag whose capacity follows -DARRAY_BAG_CAPACITY.
+ * Progress goes to stderr and the report to stdout (or --out), so the report can be redirected as-is.
+ * When built with METRICS=1, --metrics writes a JSON snapshot of the Kitchen metrics after the run.
+ * When built with TRACE=1, --trace records the run and writes it as Chrome trace-event JSON.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Benchmark.hpp"
+#include "CatalogSnapshot.hpp"
+#include "DietaryViews.hpp"
+#include "Kitchen.hpp"
+#include "KitchenCluster.hpp"
+#include "KitchenGroupBy.hpp"
+#include "KitchenQuery.hpp"
+#include "KitchenStats.hpp"
+#include "MenuReader.hpp"
+#include "MenuWatcher.hpp"
+#include "Metrics.hpp"
+#include "NameValidator.hpp"
+#include "OrderJournal.hpp"
+#include "OrderProtocol.hpp"
+#include "OrderServer.hpp"
+#include "SharedKitchen.hpp"
+#include "Trace.hpp"
+#include "ValueKitchen.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <fstream>
+#include <malloc.h>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef BENCH_CAPACITY
+// Kitchen::DEFAULT_CAPACITY is ArrayBag's, which the project's ArrayBag.hpp fixes at 100 whatever
+// -DARRAY_BAG_CAPACITY says, so a build asking for more stops here instead of
+// silently skipping the larger sizes.
+static_assert(Kitchen::DEFAULT_CAPACITY >= BENCH_CAPACITY,
+              "BENCH_CAPACITY exceeds Kitchen::DEFAULT_CAPACITY: this ArrayBag.hpp ignores -DARRAY_BAG_CAPACITY");
+#endif
+
+// Every heap allocation in the program goes through these, so the catalog cases can report how many blocks
+// and bytes a dish holds. malloc_usable_size() gives the size on release without a header of our own.
+namespace {
+    std::atomic<long> live_blocks(0);
+    std::atomic<long> live_bytes(0);
+}
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    live_blocks.fetch_add(1, std::memory_order_relaxed);
+    live_bytes.fetch_add(static_cast<long>(malloc_usable_size(block)), std::memory_order_relaxed);
+    return block;
+}
+
+void operator delete(void* block) noexcept {
+    if (block != nullptr) {
+        live_blocks.fetch_sub(1, std::memory_order_relaxed);
+        live_bytes.fetch_sub(static_cast<long>(malloc_usable_size(block)), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void operator delete(void* block, size_t) noexcept {
+    operator delete(block);
+}
+
+namespace {
+    const char* const INGREDIENTS[] = {"Tomatoes", "Basil", "Garlic", "Bread", "Chicken", "Beef", "Cheese", "Eggs",
+                                       "Flour", "Rice", "Beans", "Milk", "Butter", "Almonds", "Shrimp", "Onion",
+                                       "Pasta", "Cream", "Sugar", "Spinach"};
+    const int INGREDIENT_COUNT = sizeof(INGREDIENTS) / sizeof(INGREDIENTS[0]);
+    const char* const SERVING_STYLES[] = {"PLATED", "FAMILY_STYLE", "BUFFET"};
+    const char* const COOKING_METHODS[] = {"GRILLED", "BAKED", "BOILED", "FRIED", "STEAMED", "RAW"};
+    const char* const CATEGORIES[] = {"GRAIN", "PASTA", "LEGUME", "BREAD", "SALAD", "SOUP", "STARCHES", "VEGETABLE"};
+    const char* const FLAVOR_PROFILES[] = {"SWEET", "BITTER", "SOUR", "SALTY", "UMAMI"};
+
+    /**
+     * @param i A dish index.
+     * @return A name made only of letters and spaces, unique per index.
+     */
+    std::string dishName(int i) {
+        std::string suffix;
+        do {
+            suffix += static_cast<char>('a' + i % 26);
+            i /= 26;
+        } while (i > 0);
+        return "Dish " + suffix;
+    }
+
+    /**
+     * @param n The number of dishes.
+     * @return n newly allocated dishes, cycling through appetizers, main courses and desserts.
+     */
+    std::vector<Dish*> makeCatalog(const int& n) {
+        std::vector<Dish*> dishes;
+        dishes.reserve(n);
+        for (int i = 0; i < n; i++) {
+            std::vector<std::string> ingredients;
+            int ingredient_count = 3 + i % 4;
+            for (int k = 0; k < ingredient_count; k++) {
+                ingredients.push_back(INGREDIENTS[(i * 7 + k * 3) % INGREDIENT_COUNT]);
+            }
+            int prep_time = 5 + (i * 37) % 86;
+            double price = 3.99 + (i % 20);
+            Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(i % 7);
+
+            if (i % 3 == 0) {
+                dishes.push_back(new Appetizer(dishName(i), ingredients, prep_time, price, cuisine,
+                                               static_cast<Appetizer::ServingStyle>(i % 3), i % 8, i % 2 == 0));
+            } else if (i % 3 == 1) {
+                std::vector<MainCourse::SideDish> sides = {{"Rice", static_cast<MainCourse::Category>(i % 8)},
+                                                           {"Salad", MainCourse::SALAD}};
+                dishes.push_back(new MainCourse(dishName(i), ingredients, prep_time, price, cuisine,
+                                                static_cast<MainCourse::CookingMethod>(i % 6), "Chicken", sides, i % 2 == 0));
+            } else {
+                dishes.push_back(new Dessert(dishName(i), ingredients, prep_time, price, cuisine,
+                                             static_cast<Dessert::FlavorProfile>(i % 5), i % 10, i % 4 == 0));
+            }
+        }
+        return dishes;
+    }
+
+    /**
+     * Writes `dishes` to `path` in the format the Kitchen constructor reads, including the header line it skips.
+     */
+    void writeCatalog(const std::string& path, const std::vector<Dish*>& dishes) {
+        std::ofstream out(path);
+        out << "DishType,Name,Ingredients,PrepTime,Price,CuisineType,AdditionalAttributes\n";
+        for (const Dish* dish : dishes) {
+            const Dish::IngredientList& ingredients = dish->getIngredientList();
+            std::string type;
+            std::ostringstream extra;
+            if (const Appetizer* a = dynamic_cast<const Appetizer*>(dish)) {
+                type = "APPETIZER";
+                extra << SERVING_STYLES[a->getServingStyle()] << ';' << a->getSpicinessLevel() << ';'
+                      << (a->isVegetarian() ? "true" : "false");
+            } else if (const MainCourse* m = dynamic_cast<const MainCourse*>(dish)) {
+                type = "MAINCOURSE";
+                extra << COOKING_METHODS[m->getCookingMethod()] << ';' << m->getProteinType() << ';';
+                const MainCourse::SideDishList& sides = m->getSideDishList();
+                for (size_t s = 0; s < sides.size(); s++) {
+                    extra << (s == 0 ? "" : "|") << sides[s].name << ':' << CATEGORIES[sides[s].category];
+                }
+                extra << ';' << (m->isGlutenFree() ? "true" : "false");
+            } else if (const Dessert* d = dynamic_cast<const Dessert*>(dish)) {
+                type = "DESSERT";
+                extra << FLAVOR_PROFILES[d->getFlavorProfile()] << ';' << d->getSweetnessLevel() << ';'
+                      << (d->containsNuts() ? "true" : "false");
+            }
+            out << type << ',' << dish->getName() << ',';
+            for (size_t k = 0; k < ingredients.size(); k++) {
+                out << (k == 0 ? "" : ";") << ingredients[k];
+            }
+            out << ',' << dish->getPrepTime() << ',' << dish->getPrice() << ',' << dish->getCuisineType() << ','
+                << extra.str() << '\n';
+        }
+    }
+
+    /**
+     * @return A Kitchen on the heap holding `dishes`, added through newOrder. The kitchen owns the dishes.
+     */
+    Kitchen* makeKitchen(const std::vector<Dish*>& dishes) {
+        Kitchen* kitchen = new Kitchen();
+        for (Dish* dish : dishes) {
+            kitchen->newOrder(dish);
+        }
+        return kitchen;
+    }
+
+    /**
+     * Evicts `path` from the page cache, so the next read of it comes from the disk. Only clean pages can be
+     * evicted, so the file is synced first.
+     */
+    void dropFromPageCache(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+
+    void deleteAll(std::vector<Dish*>& dishes) {
+        for (Dish* dish : dishes) {
+            delete dish;
+        }
+        dishes.clear();
+    }
+
+    /**
+     * Registers every case at catalog size n.
+     */
+    void runCases(Benchmark& bench, const int& n) {
+        std::vector<Dish*> catalog = makeCatalog(n);
+        std::unique_ptr<ArrayBag<Dish*>> bag;
+        std::unique_ptr<Kitchen> kitchen;
+        std::vector<Dish*> dishes;
+        std::streambuf* saved_cout = nullptr;
+        NullBuffer null_buffer;
+        auto mute = [&]() { saved_cout = std::cout.rdbuf(&null_buffer); };
+        auto unmute = [&]() { std::cout.rdbuf(saved_cout); };
+        auto fillBag = [&]() {
+            bag.reset(new ArrayBag<Dish*>());
+            for (Dish* dish : catalog) {
+                bag->add(dish);
+            }
+        };
+        // Kitchens built from `dishes` own them; the kitchen cases rebuild both for every repetition.
+        auto freshKitchen = [&]() {
+            dishes = makeCatalog(n);
+            kitchen.reset(makeKitchen(dishes));
+        };
+        auto dropKitchen = [&]() { kitchen.reset(); dishes.clear(); };
+        // Served and released dishes are no longer owned by the kitchen, so they are freed here.
+        auto dropServed = [&]() {
+            std::vector<Dish*> kept = kitchen->toVector();
+            std::sort(kept.begin(), kept.end());
+            for (Dish* dish : dishes) {
+                if (!std::binary_search(kept.begin(), kept.end(), dish)) {
+                    delete dish;
+                }
+            }
+            dropKitchen();
+        };
+
+        // What a dish costs on the heap, counting the dish itself, and how long it takes to read every
+        // ingredient of every dish in an order that defeats the prefetcher, so each dish is a cold miss.
+        long blocks_before = live_blocks.load();
+        long bytes_before = live_bytes.load();
+        std::vector<Dish*> measured = makeCatalog(n);
+        std::cerr << "  catalog.memory @ " << n << ": "
+                  << static_cast<double>(live_blocks.load() - blocks_before - 1) / n << " blocks, "
+                  << static_cast<double>(live_bytes.load() - bytes_before) / n << " bytes per dish" << std::endl;
+        deleteAll(measured);
+        std::vector<Dish*> scattered = catalog;
+        for (size_t i = scattered.size(); i > 1; i--) {
+            std::swap(scattered[i - 1], scattered[(i * 2654435761u) % i]);
+        }
+        bench.run("catalog.readIngredients", n, n, nullptr,
+                  [&]() {
+                      size_t letters = 0;
+                      for (const Dish* dish : scattered) {
+                          for (const std::string& ingredient : dish->getIngredientList()) letters += ingredient[0];
+                      }
+                      if (letters == 0) std::abort();
+                  },
+                  nullptr);
+
+        bench.run("arraybag.add", n, n,
+                  [&]() { bag.reset(new ArrayBag<Dish*>()); },
+                  [&]() { for (Dish* dish : catalog) bag->add(dish); },
+                  nullptr);
+        bench.run("arraybag.add_duplicate", n, n, fillBag,
+                  [&]() { for (Dish* dish : catalog) bag->add(dish); },
+                  nullptr);
+        bench.run("arraybag.contains", n, n, fillBag,
+                  [&]() {
+                      int found = 0;
+                      for (Dish* dish : catalog) found += bag->contains(dish);
+                      if (found != n) std::abort();
+                  },
+                  nullptr);
+        bench.run("arraybag.remove", n, n, fillBag,
+                  [&]() { for (Dish* dish : catalog) bag->remove(dish); },
+                  nullptr);
+        bag.reset();
+
+        std::string path = "/tmp/kitchen_bench_" + std::to_string(getpid()) + "_" + std::to_string(n) + ".csv";
+        writeCatalog(path, catalog);
+        bench.run("kitchen.load", n, n, nullptr,
+                  [&]() { kitchen.reset(new Kitchen(path)); },
+                  [&]() { kitchen.reset(); });
+        // The same file streamed: split into fields only, and parsed into dishes that are freed at once.
+        bench.run("menureader.rows", n, n, nullptr,
+                  [&]() {
+                      MenuReader reader(path);
+                      MenuReader::Row row;
+                      int rows = 0;
+                      while (reader.next(row)) rows++;
+                      if (rows != n) std::abort();
+                  },
+                  nullptr);
+        bench.run("menureader.dishes", n, n, nullptr,
+                  [&]() {
+                      MenuReader reader(path);
+                      int rows = 0;
+                      while (Dish* dish = reader.nextDish()) {
+                          delete dish;
+                          rows++;
+                      }
+                      if (rows != n) std::abort();
+                  },
+                  nullptr);
+        // Cold-cache loads: the file is evicted before every repetition, so reading it waits on the disk. With
+        // prefetching, the next chunk is read while the current one is parsed.
+        auto evictCatalog = [&]() { dropFromPageCache(path); };
+        bench.run("kitchen.load.cold", n, n, evictCatalog,
+                  [&]() { kitchen.reset(new Kitchen(path)); },
+                  [&]() { kitchen.reset(); });
+        for (bool prefetch : {false, true}) {
+            bench.run(prefetch ? "menureader.dishes.prefetch.cold" : "menureader.dishes.cold", n, n, evictCatalog,
+                      [&]() {
+                          MenuReader reader(path, MenuReader::DEFAULT_BUFFER_SIZE, prefetch);
+                          int rows = 0;
+                          while (Dish* dish = reader.nextDish()) {
+                              delete dish;
+                              rows++;
+                          }
+                          if (rows != n) std::abort();
+                      },
+                      nullptr);
+        }
+
+        // Parsing alone, and a load in which one row in a hundred has a malformed price and is skipped.
+        std::vector<std::string> rows;
+        {
+            MenuReader reader(path);
+            std::string_view row;
+            while (reader.nextLine(row)) rows.emplace_back(row);
+        }
+        bench.run("kitchen.parseDish", n, n, nullptr,
+                  [&]() { for (const std::string& row : rows) delete Kitchen::parseDish(row); },
+                  nullptr);
+        // Name validation over a column of catalog names (under 16 characters) and of long names, the old
+        // per-character std::isalpha/std::isspace loop against the lookup table and SSE2 checks.
+        std::vector<std::string> catalog_names;
+        std::vector<std::string> long_names;
+        for (int i = 0; i < n; i++) {
+            catalog_names.push_back(dishName(i));
+            long_names.push_back(dishName(i) + " with Roasted Garlic and Wild Herbs");
+        }
+        for (const std::vector<std::string>* names : {&catalog_names, &long_names}) {
+            std::vector<std::string_view> column(names->begin(), names->end());
+            std::string suffix = names == &catalog_names ? "" : ".long";
+            bench.run("name.validate.ctype" + suffix, n, n, nullptr,
+                      [&]() {
+                          size_t invalid = 0;
+                          for (std::string_view name : column) {
+                              invalid += std::find_if(name.begin(), name.end(), [](char c) {
+                                  return !std::isalpha(c) && !std::isspace(c);
+                              }) != name.end();
+                          }
+                          if (invalid != 0) std::abort();
+                      },
+                      nullptr);
+            bench.run("name.validate.table" + suffix, n, n, nullptr,
+                      [&]() { if (!NameValidator::findInvalid(column).empty()) std::abort(); },
+                      nullptr);
+        }
+
+        std::string dirty_path = path + ".dirty";
+        uint64_t dirty_rows = 0;
+        {
+            std::ofstream dirty(dirty_path);
+            dirty << "DishType,Name,Ingredients,PrepTime,Price,CuisineType,AdditionalAttributes\n";
+            for (size_t i = 0; i < rows.size(); i++) {
+                MenuReader::Row fields;
+                if (i % 100 == 0 && MenuReader::split(rows[i], fields)) {
+                    size_t price_begin = fields.price.data() - rows[i].data();
+                    dirty << rows[i].substr(0, price_begin) << "N/A"
+                          << rows[i].substr(price_begin + fields.price.size()) << '\n';
+                    dirty_rows++;
+                } else {
+                    dirty << rows[i] << '\n';
+                }
+            }
+        }
+        bench.run("kitchen.load.dirty", n, n, nullptr,
+                  [&]() {
+                      kitchen.reset(new Kitchen(dirty_path));
+                      if (kitchen->getLoadReport().rejected != dirty_rows) std::abort();
+                  },
+                  [&]() { kitchen.reset(); });
+        std::remove(dirty_path.c_str());
+
+        // One row in a hundred gets an extra ingredient, so reload should cost about 1% of a full load.
+        std::string edited_path = path + ".edited";
+        std::vector<Dish*> edited = makeCatalog(n);
+        for (size_t i = 0; i < edited.size(); i += 100) {
+            Dish::IngredientList ingredients = edited[i]->getIngredientList();
+            ingredients.push_back("Parsley");
+            edited[i]->setIngredients(ingredients);
+        }
+        writeCatalog(edited_path, edited);
+        deleteAll(edited);
+        bench.run("kitchen.reload", n, n, [&]() { kitchen.reset(new Kitchen(path)); },
+                  [&]() { kitchen->reload(edited_path); },
+                  [&]() { kitchen.reset(); });
+        std::remove(edited_path.c_str());
+
+        // Readers pin the published kitchen while reloads build and swap in new ones.
+        std::unique_ptr<MenuWatcher> watcher(new MenuWatcher(path));
+        watcher->reloadNow();
+        bench.run("menuwatcher.pin", n, n, nullptr,
+                  [&]() {
+                      int total = 0;
+                      for (int i = 0; i < n; i++) total += watcher->pin()->getCurrentSize();
+                      if (total != n * n) std::abort();
+                  },
+                  nullptr);
+        bench.run("menuwatcher.reloadNow", n, n, nullptr, [&]() { watcher->reloadNow(); }, nullptr);
+        watcher.reset();
+        std::remove(path.c_str());
+
+        // The snapshot cases start from the same catalog as kitchen.load, so the two are directly comparable. The
+        // file is written once up front so that the read cases still run when --filter excludes snapshot.save.
+        std::string snapshot_path = path + ".snap";
+        std::unique_ptr<CatalogSnapshot> snapshot;
+        freshKitchen();
+        CatalogSnapshot::save(*kitchen, snapshot_path);
+        bench.run("snapshot.save", n, n, nullptr,
+                  [&]() { if (!CatalogSnapshot::save(*kitchen, snapshot_path)) std::abort(); },
+                  nullptr);
+        dropKitchen();
+        bench.run("snapshot.open", n, n, nullptr,
+                  [&]() {
+                      snapshot.reset(new CatalogSnapshot());
+                      if (!snapshot->open(snapshot_path) || snapshot->size() != static_cast<size_t>(n)) std::abort();
+                  },
+                  [&]() { snapshot.reset(); });
+        bench.run("snapshot.loadInto", n, n, nullptr,
+                  [&]() {
+                      snapshot.reset(new CatalogSnapshot());
+                      kitchen.reset(new Kitchen());
+                      if (!snapshot->open(snapshot_path) || snapshot->loadInto(*kitchen) != n) std::abort();
+                  },
+                  [&]() { kitchen.reset(); snapshot.reset(); });
+        bench.run("snapshot.loadInto.cold", n, n, [&]() { dropFromPageCache(snapshot_path); },
+                  [&]() {
+                      snapshot.reset(new CatalogSnapshot());
+                      kitchen.reset(new Kitchen());
+                      if (!snapshot->open(snapshot_path) || snapshot->loadInto(*kitchen) != n) std::abort();
+                  },
+                  [&]() { kitchen.reset(); snapshot.reset(); });
+        std::remove(snapshot_path.c_str());
+
+        // A reader that already holds the latest catalog only loads the version; one that does not attaches to the
+        // image in place, and loading it into a Kitchen is what every process pays instead of parsing the CSV.
+        std::unique_ptr<SharedKitchen> writer(new SharedKitchen());
+        std::unique_ptr<SharedKitchen> reader(new SharedKitchen());
+        std::string segment = "/kitchen-bench-" + std::to_string(getpid());
+        freshKitchen();
+        if (!writer->create(segment) || !writer->publish(*kitchen) || !reader->open(segment)) std::abort();
+        bench.run("shared.publish", n, n, nullptr,
+                  [&]() { if (!writer->publish(*kitchen)) std::abort(); },
+                  nullptr);
+        dropKitchen();
+        // Each repetition reopens the reader in its setup, so it starts behind whatever case ran before it.
+        auto reopenReader = [&]() { reader->close(); if (!reader->open(segment)) std::abort(); };
+        bench.run("shared.refresh", n, n, reopenReader,
+                  [&]() { if (!reader->refresh() || reader->snapshot().size() != static_cast<size_t>(n)) std::abort(); },
+                  nullptr);
+        bench.run("shared.refresh.unchanged", n, n, [&]() { reader->refresh(); },
+                  [&]() { for (int i = 0; i < n; i++) if (reader->refresh()) std::abort(); },
+                  nullptr);
+        bench.run("shared.refresh.loadInto", n, n, reopenReader,
+                  [&]() {
+                      kitchen.reset(new Kitchen());
+                      if (!reader->refresh() || reader->loadInto(*kitchen) != n) std::abort();
+                  },
+                  [&]() { kitchen.reset(); });
+        reader.reset();
+        writer.reset();
+
+        // The request handlers alone, without the socket or the event loop, as a floor for what loadgen measures.
+        freshKitchen();
+        std::unique_ptr<OrderServer> server(new OrderServer(*kitchen));
+        std::string request;
+        std::string response;
+        OrderProtocol::Query query;
+        query.fields = OrderProtocol::Query::CUISINE | OrderProtocol::Query::PREP_TIME;
+        query.cuisine = Dish::ITALIAN;
+        query.prep_max = 30;
+        query.limit = 5;
+        OrderProtocol::encodeQuery(request, query);
+        bench.run("server.execute.query", n, 1, nullptr,
+                  [&]() { response.clear(); server->execute(OrderProtocol::QUERY, request, response); },
+                  nullptr);
+        bench.run("server.execute.report", n, 1, nullptr,
+                  [&]() { response.clear(); server->execute(OrderProtocol::REPORT, "", response); },
+                  nullptr);
+        server.reset();
+        dropKitchen();
+
+        bench.run("kitchen.newOrder", n, n,
+                  [&]() { dishes = makeCatalog(n); kitchen.reset(new Kitchen()); },
+                  [&]() { for (Dish* dish : dishes) kitchen->newOrder(dish); },
+                  dropKitchen);
+        bench.run("kitchen.newOrder.sketched", n, n,
+                  [&]() { dishes = makeCatalog(n); kitchen.reset(new Kitchen()); kitchen->trackQuantiles(true); },
+                  [&]() { for (Dish* dish : dishes) kitchen->newOrder(dish); },
+                  dropKitchen);
+        // Journaled orders include the final flush, so the figure is the cost of making every order durable.
+        // As with the snapshot, the journal is written once up front for journal.replay.
+        std::string journal_path = path + ".journal";
+        std::unique_ptr<OrderJournal> journal(new OrderJournal());
+        std::remove(journal_path.c_str());
+        journal->open(journal_path);
+        dishes = makeCatalog(n);
+        kitchen.reset(new Kitchen());
+        kitchen->attachJournal(journal.get());
+        for (Dish* dish : dishes) kitchen->newOrder(dish);
+        dropKitchen();
+        journal.reset();
+        bench.run("kitchen.newOrder.journaled", n, n,
+                  [&]() {
+                      std::remove(journal_path.c_str());
+                      journal.reset(new OrderJournal());
+                      if (!journal->open(journal_path)) std::abort();
+                      dishes = makeCatalog(n);
+                      kitchen.reset(new Kitchen());
+                      kitchen->attachJournal(journal.get());
+                  },
+                  [&]() {
+                      for (Dish* dish : dishes) kitchen->newOrder(dish);
+                      if (!journal->flush()) std::abort();
+                  },
+                  [&]() { dropKitchen(); journal.reset(); });
+        bench.run("journal.replay", n, n, [&]() { kitchen.reset(new Kitchen()); },
+                  [&]() {
+                      if (OrderJournal::replay(journal_path, *kitchen).applied != static_cast<uint64_t>(n)) std::abort();
+                  },
+                  [&]() { kitchen.reset(); });
+        std::remove(journal_path.c_str());
+
+        bench.run("kitchen.serveDish", n, n, freshKitchen,
+                  [&]() { for (Dish* dish : dishes) kitchen->serveDish(dish); },
+                  dropServed);
+        bench.run("kitchen.releaseDishesBelowPrepTime", n, n, freshKitchen,
+                  [&]() { kitchen->releaseDishesBelowPrepTime(45); },
+                  dropServed);
+        bench.run("kitchen.releaseDishesOfCuisineType", n, n, freshKitchen,
+                  [&]() { kitchen->releaseDishesOfCuisineType("ITALIAN"); },
+                  dropServed);
+        // The same catalog spread over eight shards by name hash; statistics and releases run on every shard at once.
+        std::unique_ptr<KitchenCluster> cluster;
+        auto freshCluster = [&]() {
+            dishes.clear();
+            cluster.reset(new KitchenCluster(8, KitchenCluster::BY_HASH));
+            for (Dish* dish : makeCatalog(n)) {
+                if (!cluster->newOrder(dish)) dishes.push_back(dish);
+            }
+        };
+        // The cluster deletes what it holds and what it releases; only the dishes it refused are left here.
+        auto dropCluster = [&]() {
+            for (Dish* dish : dishes) delete dish;
+            cluster.reset();
+            dishes.clear();
+        };
+        bench.run("kitchen.calculateAvgPrepTime", n, n, freshKitchen,
+                  [&]() { if (kitchen->calculateAvgPrepTime() < 0) std::abort(); },
+                  dropKitchen);
+        bench.run("cluster.calculateAvgPrepTime", n, n, freshCluster,
+                  [&]() { if (cluster->calculateAvgPrepTime() < 0) std::abort(); },
+                  dropCluster);
+        bench.run("cluster.releaseDishesBelowPrepTime", n, n, freshCluster,
+                  [&]() { cluster->releaseDishesBelowPrepTime(45); },
+                  dropCluster);
+        bench.run("kitchen.dietaryAdjustment", n, n, freshKitchen,
+                  [&]() { kitchen->dietaryAdjustment({true, true, true, true, true, true}); },
+                  dropKitchen);
+        // The adjustment alone, without the kitchen's index upkeep: through each dish's vtable, then on
+        // dishes stored by value and dispatched with std::visit.
+        std::unique_ptr<ValueKitchen> values;
+        auto freshValues = [&]() {
+            values.reset(new ValueKitchen());
+            for (Dish* dish : catalog) values->newOrder(ValueKitchen::valueOf(*dish));
+        };
+        bench.run("dishes.dietaryAccommodations", n, n, [&]() { dishes = makeCatalog(n); },
+                  [&]() { for (Dish* dish : dishes) dish->dietaryAccommodations({true, true, true, true, true, true}); },
+                  [&]() { deleteAll(dishes); });
+        bench.run("valueKitchen.dietaryAdjustment", n, n, freshValues,
+                  [&]() { values->dietaryAdjustment({true, true, true, true, true, true}); },
+                  [&]() { values.reset(); });
+
+        freshKitchen();
+        bench.run("kitchen.kitchenReport", n, n, mute, [&]() { kitchen->kitchenReport(); }, unmute);
+        bench.run("kitchen.displayMenu", n, n, mute, [&]() { kitchen->displayMenu(); }, unmute);
+        freshValues();
+        bench.run("valueKitchen.displayMenu", n, n, mute, [&]() { values->displayMenu(); }, unmute);
+        values.reset();
+        bench.run("kitchen.tallyCuisineTypes", n, 7, nullptr,
+                  [&]() {
+                      for (const char* cuisine : {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"}) {
+                          if (kitchen->tallyCuisineTypes(cuisine) < 0) std::abort();
+                      }
+                  },
+                  nullptr);
+        bench.run("query.count.prepTime", n, 1, nullptr,
+                  [&]() { if (KitchenQuery(*kitchen).prepTime(20, 40).count() > static_cast<size_t>(n)) std::abort(); },
+                  nullptr);
+        bench.run("query.count.cuisine_prepTime_vegetarian", n, 1, nullptr,
+                  [&]() {
+                      KitchenQuery query(*kitchen);
+                      query.cuisine(Dish::ITALIAN).prepTime(20, 40).vegetarian(true);
+                      if (query.count() > static_cast<size_t>(n)) std::abort();
+                  },
+                  nullptr);
+        bench.run("query.run.dessert_price_ingredient", n, 1, nullptr,
+                  [&]() {
+                      KitchenQuery query(*kitchen);
+                      query.dishType(KitchenIndex::DESSERT).price(5, 10).ingredient("Sugar");
+                      size_t found = 0;
+                      for (Dish* dish : query.run()) found += dish != nullptr;
+                      if (found > static_cast<size_t>(n)) std::abort();
+                  },
+                  nullptr);
+        bench.run("stats.topK.prepTime", n, 1, nullptr,
+                  [&]() { if (KitchenStats(*kitchen).topK(KitchenStats::PREP_TIME, 10).size() > 10) std::abort(); },
+                  nullptr);
+        bench.run("stats.percentile.prepTime", n, 1, nullptr,
+                  [&]() { if (KitchenStats(*kitchen).percentile(KitchenStats::PREP_TIME, 0.95) < 0) std::abort(); },
+                  nullptr);
+        bench.run("stats.percentileByCuisine.price", n, 1, nullptr,
+                  [&]() {
+                      if (KitchenStats(*kitchen).percentileByCuisine(KitchenStats::PRICE, 0.5)[Dish::ITALIAN] < 0) std::abort();
+                  },
+                  nullptr);
+        bench.run("groupBy.cuisine_type_cookingMethod", n, 1, nullptr,
+                  [&]() {
+                      KitchenGroupBy group_by(*kitchen);
+                      group_by.by(KitchenGroupBy::CUISINE).by(KitchenGroupBy::DISH_TYPE).by(KitchenGroupBy::COOKING_METHOD);
+                      if (group_by.run().total().count != static_cast<uint64_t>(n)) std::abort();
+                  },
+                  nullptr);
+        bench.run("groupBy.cuisine_type_cookingMethod.parallel", n, 1, nullptr,
+                  [&]() {
+                      KitchenGroupBy group_by(*kitchen);
+                      group_by.by(KitchenGroupBy::CUISINE).by(KitchenGroupBy::DISH_TYPE).by(KitchenGroupBy::COOKING_METHOD);
+                      if (group_by.run(0).total().count != static_cast<uint64_t>(n)) std::abort();
+                  },
+                  nullptr);
+        kitchen->trackQuantiles(true);
+        bench.run("stats.sketch.prepTime", n, 1, nullptr,
+                  [&]() { if (kitchen->getPrepTimeSketch()->quantile(0.95) < 0) std::abort(); },
+                  nullptr);
+        // One vegan table's menu: deep copies adjusted per table, view deltas built on first use, and views
+        // shared with an earlier table.
+        const Dish::DietaryRequest vegan = {false, true, false, false, false, false};
+        bench.run("dietary.copyPerTable", n, n, nullptr,
+                  [&]() {
+                      for (Dish* dish : kitchen->toVector()) {
+                          std::unique_ptr<Dish> copy(dish->clone());
+                          copy->dietaryAccommodations(vegan);
+                      }
+                  },
+                  nullptr);
+        std::vector<Dish*> menu = kitchen->toVector();
+        std::unique_ptr<DietaryViews> views;
+        bench.run("dietary.view.cold", n, n, [&]() { views.reset(new DietaryViews()); },
+                  [&]() { for (Dish* dish : menu) views->view(dish, vegan); },
+                  [&]() { views.reset(); });
+        for (Dish* dish : menu) kitchen->dietaryView(dish, vegan);
+        bench.run("dietary.view.warm", n, n, nullptr,
+                  [&]() { for (Dish* dish : menu) kitchen->dietaryView(dish, vegan); },
+                  nullptr);
+        // Which dishes a gluten- and nut-free table can order as they are: each dish's own mask behind its
+        // pointer, against the kitchen's contiguous mask column.
+        const Dish::DietaryRequest allergies = {false, false, true, true, false, false};
+        bench.run("dietary.compatible.scan", n, 1, nullptr,
+                  [&]() {
+                      uint8_t mask = Dish::maskOf(allergies);
+                      int count = 0;
+                      for (Dish* dish : menu) count += (dish->getCompatibility() & mask) == mask;
+                      if (count > n) std::abort();
+                  },
+                  nullptr);
+        bench.run("dietary.compatible.count", n, 1, nullptr,
+                  [&]() { if (kitchen->countCompatible(allergies) > n) std::abort(); },
+                  nullptr);
+        bench.run("dietary.compatible.filter", n, 1, nullptr,
+                  [&]() { if (kitchen->filterCompatible(allergies).size() > static_cast<size_t>(n)) std::abort(); },
+                  nullptr);
+        // Order entry: a name typed in full, the first letters of one, and one with a typo.
+        std::string wanted = dishName(n / 2);
+        bench.run("names.exact.scan", n, 1, nullptr,
+                  [&]() {
+                      Dish* found = nullptr;
+                      for (Dish* dish : kitchen->toVector()) {
+                          if (dish->getName() == wanted) {
+                              found = dish;
+                              break;
+                          }
+                      }
+                      if (found == nullptr) std::abort();
+                  },
+                  nullptr);
+        bench.run("names.exact", n, 1, nullptr,
+                  [&]() { if (kitchen->getNameIndex().exact(wanted).empty()) std::abort(); },
+                  nullptr);
+        bench.run("names.prefix", n, 1, nullptr,
+                  [&]() { if (kitchen->getNameIndex().prefix("dish b", 10).empty()) std::abort(); },
+                  nullptr);
+        std::string typo = wanted;
+        typo[typo.size() - 1] = typo.back() == 'z' ? 'y' : 'z';
+        bench.run("names.fuzzy.distance2", n, 1, nullptr,
+                  [&]() { if (kitchen->getNameIndex().fuzzy(typo, 2, 10).empty()) std::abort(); },
+                  nullptr);
+        // A supplier recall: every dish listing an ingredient, by copying each dish's ingredients and by
+        // reading the posting list.
+        bench.run("ingredients.recall.scan", n, 1, nullptr,
+                  [&]() {
+                      std::vector<Dish*> recalled;
+                      for (Dish* dish : kitchen->toVector()) {
+                          const Dish::IngredientList& listed = dish->getIngredientList();
+                          if (std::find(listed.begin(), listed.end(), "Almonds") != listed.end()) {
+                              recalled.push_back(dish);
+                          }
+                      }
+                      if (recalled.size() > static_cast<size_t>(n)) std::abort();
+                  },
+                  nullptr);
+        bench.run("ingredients.recall.postings", n, 1, nullptr,
+                  [&]() {
+                      std::vector<Dish*> recalled = kitchen->getIngredientIndex().postings("Almonds");
+                      if (recalled.size() > static_cast<size_t>(n)) std::abort();
+                  },
+                  nullptr);
+        bench.run("ingredients.all", n, 1, nullptr,
+                  [&]() {
+                      if (kitchen->getIngredientIndex().all({"Sugar", "Cream"}).size() > static_cast<size_t>(n)) std::abort();
+                  },
+                  nullptr);
+        bench.run("ingredients.any", n, 1, nullptr,
+                  [&]() {
+                      if (kitchen->getIngredientIndex().any({"Almonds", "Shrimp"}).size() > static_cast<size_t>(n)) std::abort();
+                  },
+                  nullptr);
+        dropKitchen();
+
+        deleteAll(catalog);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes = {100, 1000, 10000};
+    int warmup = 2;
+    int reps = 15;
+    std::string filter;
+    std::string out_path;
+    std::string metrics_path;
+    std::string trace_path;
+    Benchmark::Format format = Benchmark::TEXT;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--sizes" && has_value) {
+            sizes.clear();
+            std::stringstream sizes_ss(argv[++i]);
+            std::string size;
+            while (std::getline(sizes_ss, size, ',')) {
+                sizes.push_back(std::atoi(size.c_str()));
+            }
+        } else if (arg == "--warmup" && has_value) {
+            warmup = std::atoi(argv[++i]);
+        } else if (arg == "--reps" && has_value) {
+            reps = std::atoi(argv[++i]);
+        } else if (arg == "--filter" && has_value) {
+            filter = argv[++i];
+        } else if (arg == "--format" && has_value) {
+            std::string name = argv[++i];
+            format = name == "json" ? Benchmark::JSON : name == "csv" ? Benchmark::CSV : Benchmark::TEXT;
+        } else if (arg == "--out" && has_value) {
+            out_path = argv[++i];
+        } else if (arg == "--metrics" && has_value) {
+            metrics_path = argv[++i];
+        } else if (arg == "--trace" && has_value) {
+            trace_path = argv[++i];
+        } else {
+            std::cerr << "usage: bench [--sizes N1,N2] [--warmup W] [--reps R] [--filter S] "
+                      << "[--format text|csv|json] [--out FILE] [--metrics FILE] [--trace FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!trace_path.empty()) {
+        Trace::start();
+    }
+    Benchmark bench(warmup, reps, filter);
+    for (int n : sizes) {
+        if (n < 1 || n > Kitchen::DEFAULT_CAPACITY) {
+            std::cerr << "bench: skipping size " << n << " (bag capacity is "
+                      << Kitchen::DEFAULT_CAPACITY << ")" << std::endl;
+            continue;
+        }
+        std::cerr << "size " << n << std::endl;
+        runCases(bench, n);
+    }
+
+    if (out_path.empty()) {
+        bench.report(std::cout, format);
+    } else {
+        std::ofstream out(out_path);
+        bench.report(out, format);
+    }
+    if (!trace_path.empty()) {
+        Trace::stop();
+        if (!Trace::exportToFile(trace_path)) {
+            std::cerr << "bench: cannot write " << trace_path << std::endl;
+        }
+    }
+    if (!metrics_path.empty()) {
+        std::ofstream metrics_out(metrics_path);
+        MetricsRegistry::instance().snapshot(metrics_out, MetricsRegistry::JSON);
+    }
+    return 0;
+}
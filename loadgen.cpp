@@ -0,0 +1,306 @@
+/**
+ * @file loadgen.cpp
+ * @brief Load generator for kitchend: drives pipelined OrderProtocol traffic and reports throughput and latency.
+ *
+ * Usage: loadgen [options]
+ *   --socket PATH        kitchend's socket (default /tmp/kitchend.sock)
+ *   --connections N      client connections, each on its own thread (default 4)
+ *   --depth D            requests kept in flight on each connection (default 32)
+ *   --seconds S          how long to send for (default 5)
+ *   --mix M              read (queries and reports), write (new orders and serves of them) or mixed, 80% reads
+ *                        (default mixed)
+ *   --seed S             base seed; connection i uses S + i (default 235)
+ *
+ * Each connection keeps `depth` requests outstanding: whenever responses arrive, the same number of new requests
+ * is sent in one write. Latency is measured per request, from the write that carried it to the read that
+ * returned its response, so it includes the time spent queued behind the other requests in flight. Written
+ * dishes are served again by the same connection, so the kitchen's size stays about the same.
+ *
+ * Example: loadgen --connections 8 --depth 64 --seconds 10 --mix write
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Appetizer.hpp"
+#include "DishCodec.hpp"
+#include "OrderProtocol.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    enum Mix { READ, WRITE, MIXED };
+
+    /**
+     * @struct Options
+     * @brief The command line.
+     */
+    struct Options {
+        std::string socket_path = "/tmp/kitchend.sock";
+        int connections = 4;
+        int depth = 32;
+        double seconds = 5;
+        Mix mix = MIXED;
+        unsigned seed = 235;
+    };
+
+    /**
+     * @struct Result
+     * @brief What one connection measured.
+     */
+    struct Result {
+        bool connected = false;
+        bool broken = false;            ///< The server closed the connection or sent a malformed response.
+        uint64_t responses = 0;
+        uint64_t not_ok = 0;            ///< Responses with a status other than OK.
+        std::vector<uint32_t> latencies_ns;
+    };
+
+    /**
+     * @return A dish name made of letters only, as Dish::setName() requires, unique to this connection and count.
+     */
+    std::string orderName(const int& connection, uint64_t count) {
+        std::string name = "Loadgen ";
+        name.push_back(static_cast<char>('A' + connection % 26));
+        name.push_back(' ');
+        do {
+            name.push_back(static_cast<char>('a' + count % 26));
+            count /= 26;
+        } while (count > 0);
+        return name;
+    }
+
+    /**
+     * @return False if the connection failed before all of `bytes` was sent.
+     */
+    bool sendAll(const int& fd, const std::string& bytes) {
+        size_t written = 0;
+        while (written < bytes.size()) {
+            ssize_t n = ::send(fd, bytes.data() + written, bytes.size() - written, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return false;
+            }
+            written += n;
+        }
+        return true;
+    }
+
+    /**
+     * Drives one connection until `deadline`, then waits for the requests still in flight.
+     */
+    void runConnection(const Options& options, const int& id, const Clock::time_point& deadline, Result& result) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        struct sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, options.socket_path.c_str(), sizeof(address.sun_path) - 1);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return;
+        }
+        result.connected = true;
+
+        std::mt19937 rng(options.seed + id);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> cuisine(0, Dish::OTHER);
+        std::uniform_int_distribution<int> prep_time(5, 120);
+        std::deque<std::string> ordered;    // Sent as NEW_ORDER and not yet served.
+        uint64_t orders = 0;
+
+        std::string out;
+        std::string in;
+        std::deque<Clock::time_point> sent;
+        char buffer[64 * 1024];
+        while (!result.broken) {
+            bool sending = Clock::now() < deadline;
+            if (!sending && sent.empty()) {
+                break;
+            }
+            if (sending) {
+                size_t added = 0;
+                while (sent.size() + added < static_cast<size_t>(options.depth)) {
+                    bool writing = options.mix == WRITE || (options.mix == MIXED && percent(rng) < 20);
+                    if (writing && !ordered.empty() && percent(rng) < 50) {
+                        OrderProtocol::appendServeDish(out, ordered.front());
+                        ordered.pop_front();
+                    } else if (writing) {
+                        std::string name = orderName(id, orders++);
+                        Appetizer dish(name, {"flour", "salt", "oil"}, prep_time(rng), 4.5,
+                                       static_cast<Dish::CuisineType>(cuisine(rng)), Appetizer::PLATED, 1, true);
+                        OrderProtocol::appendNewOrder(out, dish);
+                        ordered.push_back(name);
+                    } else if (percent(rng) < 70) {
+                        OrderProtocol::Query query;
+                        query.fields = OrderProtocol::Query::CUISINE | OrderProtocol::Query::PREP_TIME;
+                        query.cuisine = static_cast<Dish::CuisineType>(cuisine(rng));
+                        query.prep_min = 0;
+                        query.prep_max = prep_time(rng);
+                        query.limit = 5;
+                        OrderProtocol::appendQuery(out, query);
+                    } else {
+                        OrderProtocol::appendReport(out);
+                    }
+                    added++;
+                }
+                sent.insert(sent.end(), added, Clock::now());
+                result.broken = !sendAll(fd, out);
+                out.clear();
+            }
+
+            ssize_t got = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (got <= 0) {
+                result.broken = true;
+                break;
+            }
+            Clock::time_point now = Clock::now();
+            in.append(buffer, got);
+            const char* cursor = in.data();
+            const char* end = cursor + in.size();
+            uint8_t status;
+            std::string_view payload;
+            OrderProtocol::FrameResult frame;
+            while ((frame = OrderProtocol::nextFrame(cursor, end, status, payload)) == OrderProtocol::FRAME) {
+                if (sent.empty()) {
+                    result.broken = true;
+                    break;
+                }
+                result.latencies_ns.push_back(static_cast<uint32_t>(std::min<int64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - sent.front()).count(), UINT32_MAX)));
+                sent.pop_front();
+                result.responses++;
+                result.not_ok += status != OrderProtocol::OK;
+            }
+            if (frame == OrderProtocol::INVALID) {
+                result.broken = true;
+            }
+            in.erase(0, cursor - in.data());
+        }
+
+        // Dishes this connection ordered and never served are served now, outside the measurement, so that
+        // repeated runs start from the same kitchen.
+        for (const std::string& name : ordered) {
+            OrderProtocol::appendServeDish(out, name);
+        }
+        size_t pending = ordered.size();
+        if (!result.broken && pending > 0 && sendAll(fd, out)) {
+            while (pending > 0) {
+                ssize_t got = ::recv(fd, buffer, sizeof(buffer), 0);
+                if (got <= 0) {
+                    break;
+                }
+                in.append(buffer, got);
+                const char* cursor = in.data();
+                uint8_t status;
+                std::string_view payload;
+                while (pending > 0 && OrderProtocol::nextFrame(cursor, in.data() + in.size(), status, payload)
+                                          == OrderProtocol::FRAME) {
+                    pending--;
+                }
+                in.erase(0, cursor - in.data());
+            }
+        }
+        ::close(fd);
+    }
+
+    /**
+     * @pre `sorted` is sorted and not empty.
+     * @return The value of rank `fraction` in microseconds.
+     */
+    double percentileUs(const std::vector<uint32_t>& sorted, const double& fraction) {
+        size_t rank = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[rank] / 1000.0;
+    }
+
+    void usage() {
+        std::cerr << "usage: loadgen [--socket PATH] [--connections N] [--depth D] [--seconds S] "
+                  << "[--mix read|write|mixed] [--seed S]" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--socket") {
+            options.socket_path = value;
+        } else if (arg == "--connections") {
+            options.connections = std::atoi(value.c_str());
+        } else if (arg == "--depth") {
+            options.depth = std::atoi(value.c_str());
+        } else if (arg == "--seconds") {
+            options.seconds = std::atof(value.c_str());
+        } else if (arg == "--mix" && (value == "read" || value == "write" || value == "mixed")) {
+            options.mix = value == "read" ? READ : value == "write" ? WRITE : MIXED;
+        } else if (arg == "--seed") {
+            options.seed = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (options.connections < 1 || options.depth < 1 || options.seconds <= 0) {
+        usage();
+        return 1;
+    }
+
+    std::vector<Result> results(options.connections);
+    std::vector<std::thread> threads;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.seconds));
+    for (int c = 0; c < options.connections; c++) {
+        threads.emplace_back(runConnection, std::cref(options), c, deadline, std::ref(results[c]));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<uint32_t> latencies;
+    uint64_t responses = 0, not_ok = 0;
+    int connected = 0, broken = 0;
+    for (Result& result : results) {
+        connected += result.connected;
+        broken += result.broken;
+        responses += result.responses;
+        not_ok += result.not_ok;
+        latencies.insert(latencies.end(), result.latencies_ns.begin(), result.latencies_ns.end());
+    }
+    if (connected == 0) {
+        std::cerr << "loadgen: cannot connect to " << options.socket_path << std::endl;
+        return 1;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "connections " << connected << ", depth " << options.depth << ", " << elapsed << " s" << std::endl;
+    std::cout << "requests " << responses << " (" << responses / elapsed << " per second), " << not_ok
+              << " not OK, " << broken << " connections broken" << std::endl;
+    if (!latencies.empty()) {
+        std::cout << "latency us: p50 " << percentileUs(latencies, 0.50) << "  p90 " << percentileUs(latencies, 0.90)
+                  << "  p99 " << percentileUs(latencies, 0.99) << "  p99.9 " << percentileUs(latencies, 0.999)
+                  << "  max " << latencies.back() / 1000.0 << std::endl;
+    }
+    return broken == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file menugen.cpp
+ * @brief Command-line tool that writes a deterministic synthetic menu CSV of any size.
+ *
+ * Usage: menugen [options]
+ *   --rows N                 data rows to write (default 1000)
+ *   --seed S                 generator seed (default 235)
+ *   --out FILE               output file (default stdout)
+ *   --cuisines N=W,N=W,...   cuisine weights (default the six Dish cuisines plus THAI, all weight 1)
+ *   --types N=W,N=W,...      weights for APPETIZER, MAINCOURSE, DESSERT (default 1 each)
+ *   --ingredients MIN-MAX    ingredients per dish (default 3-6)
+ *   --sides MIN-MAX          side dishes per main course (default 1-3)
+ *   --prep MEAN:STDDEV       normal prep-time distribution in minutes (default 30:15)
+ *   --dup-rate P             probability that a row repeats an earlier row (default 0)
+ *   --dirty-rate P           probability that a row has one malformed number, e.g. N/A (default 0)
+ *
+ * Example: menugen --rows 50000000 --seed 7 --dup-rate 0.01 --out big_menu.csv
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "MenuGenerator.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    /**
+     * Parses `MIN<sep>MAX` into two integers; a single number sets both.
+     */
+    void parseRange(const std::string& text, const char& separator, int& low, int& high) {
+        size_t split = text.find(separator);
+        low = std::atoi(text.substr(0, split).c_str());
+        high = split == std::string::npos ? low : std::atoi(text.substr(split + 1).c_str());
+    }
+
+    void usage() {
+        std::cerr << "usage: menugen [--rows N] [--seed S] [--out FILE] [--cuisines N=W,...] [--types N=W,...]\n"
+                  << "               [--ingredients MIN-MAX] [--sides MIN-MAX] [--prep MEAN:STDDEV] [--dup-rate P]\n"
+                  << "               [--dirty-rate P]" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    MenuGenerator::Options options;
+    std::string out_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--rows") {
+            options.rows = std::atol(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--out") {
+            out_path = value;
+        } else if (arg == "--cuisines") {
+            options.cuisines = MenuGenerator::parseWeights(value);
+        } else if (arg == "--types") {
+            options.dish_types = MenuGenerator::parseWeights(value);
+        } else if (arg == "--ingredients") {
+            parseRange(value, '-', options.min_ingredients, options.max_ingredients);
+        } else if (arg == "--sides") {
+            parseRange(value, '-', options.min_side_dishes, options.max_side_dishes);
+        } else if (arg == "--prep") {
+            size_t colon = value.find(':');
+            options.prep_mean = std::atof(value.substr(0, colon).c_str());
+            options.prep_stddev = colon == std::string::npos ? 0 : std::atof(value.substr(colon + 1).c_str());
+        } else if (arg == "--dup-rate") {
+            options.duplicate_rate = std::atof(value.c_str());
+        } else if (arg == "--dirty-rate") {
+            options.dirty_rate = std::atof(value.c_str());
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    for (const MenuGenerator::Weighted& type : options.dish_types) {
+        if (type.value != "APPETIZER" && type.value != "MAINCOURSE" && type.value != "DESSERT") {
+            std::cerr << "menugen: unknown dish type " << type.value << std::endl;
+            return 1;
+        }
+    }
+
+    MenuGenerator generator(options);
+    if (out_path.empty()) {
+        std::ios::sync_with_stdio(false);
+        generator.generate(std::cout);
+    } else {
+        // A large stream buffer keeps the number of write calls low on multi-GB outputs.
+        std::vector<char> buffer(1 << 20);
+        std::ofstream out;
+        out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.open(out_path, std::ios::binary);
+        if (!out) {
+            std::cerr << "menugen: cannot open " << out_path << std::endl;
+            return 1;
+        }
+        generator.generate(out);
+        if (!out) {
+            std::cerr << "menugen: write to " << out_path << " failed" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
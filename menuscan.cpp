@@ -0,0 +1,188 @@
+/**
+ * @file menuscan.cpp
+ * @brief Command-line tool that summarizes, and optionally filters, a menu CSV of any size in constant memory.
+ *
+ * Usage: menuscan [options] menu.csv
+ *   --type T          only rows of dish type T, e.g. DESSERT
+ *   --cuisine C       only rows of cuisine C, e.g. ITALIAN
+ *   --max-prep N      only rows with a prep time of at most N minutes
+ *   --export FILE     write the matching rows, with the header line, to FILE
+ *   --buffer BYTES    read buffer size (default 65536)
+ *   --no-prefetch     read the file on the parsing thread instead of one chunk ahead on a background thread
+ *
+ * Rows are streamed through MenuReader and never become dishes, so memory stays at three read buffers (one
+ * without prefetching) however large the file is. The summary of the matching rows (counts by type and cuisine, prep time and price) goes
+ * to stdout.
+ *
+ * Example: menuscan --cuisine ITALIAN --max-prep 20 --export quick_italian.csv big_menu.csv
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "MenuReader.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+    /**
+     * @return True if `text` is a whole number, stored in `value`.
+     */
+    bool parseInt(const std::string_view& text, long& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    /**
+     * @return True if `text` is a whole, finite decimal number, stored in `value`. from_chars also reads "nan"
+     * and "inf", which are refused as Kitchen::parseDish() refuses them.
+     */
+    bool parseDouble(const std::string_view& text, double& value) {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size() && std::isfinite(value);
+    }
+
+    void usage() {
+        std::cerr << "usage: menuscan [--type T] [--cuisine C] [--max-prep N] [--export FILE] [--buffer BYTES] "
+                  << "[--no-prefetch] menu.csv" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string type;
+    std::string cuisine;
+    long max_prep = -1;
+    std::string export_path;
+    size_t buffer_size = MenuReader::DEFAULT_BUFFER_SIZE;
+    bool prefetch = true;
+    std::string menu_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            menu_path = arg;
+            continue;
+        }
+        if (arg == "--no-prefetch") {
+            prefetch = false;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--type") {
+            type = value;
+        } else if (arg == "--cuisine") {
+            cuisine = value;
+        } else if (arg == "--max-prep") {
+            max_prep = std::atol(value.c_str());
+        } else if (arg == "--export") {
+            export_path = value;
+        } else if (arg == "--buffer") {
+            buffer_size = std::strtoull(value.c_str(), nullptr, 10);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (menu_path.empty()) {
+        usage();
+        return 1;
+    }
+
+    MenuReader reader(menu_path, buffer_size, prefetch);
+    if (!reader.isOpen()) {
+        std::cerr << "menuscan: cannot open " << menu_path << std::endl;
+        return 1;
+    }
+    std::vector<char> export_buffer(1 << 20);
+    std::ofstream out;
+    if (!export_path.empty()) {
+        out.rdbuf()->pubsetbuf(export_buffer.data(), static_cast<std::streamsize>(export_buffer.size()));
+        out.open(export_path, std::ios::binary);
+        if (!out) {
+            std::cerr << "menuscan: cannot open " << export_path << std::endl;
+            return 1;
+        }
+        out << "DishType,Name,Ingredients,PrepTime,Price,CuisineType,AdditionalAttributes\n";
+    }
+
+    // Keyed by the type and cuisine names, of which a menu has a handful, so the maps stay small.
+    std::map<std::string, uint64_t, std::less<>> by_type;
+    std::map<std::string, uint64_t, std::less<>> by_cuisine;
+    uint64_t matched = 0;
+    uint64_t unparsable = 0;
+    long prep_min = 0;
+    long prep_max = 0;
+    double prep_sum = 0;
+    double price_sum = 0;
+    MenuReader::Row row;
+    while (reader.next(row)) {
+        long prep_time;
+        double price;
+        if (!parseInt(row.prep_time, prep_time) || !parseDouble(row.price, price)) {
+            unparsable++;
+            continue;
+        }
+        if ((!type.empty() && row.type != type) || (!cuisine.empty() && row.cuisine != cuisine)
+            || (max_prep >= 0 && prep_time > max_prep)) {
+            continue;
+        }
+        auto type_count = by_type.find(row.type);
+        if (type_count == by_type.end()) {
+            type_count = by_type.emplace(std::string(row.type), 0).first;
+        }
+        type_count->second++;
+        auto cuisine_count = by_cuisine.find(row.cuisine);
+        if (cuisine_count == by_cuisine.end()) {
+            cuisine_count = by_cuisine.emplace(std::string(row.cuisine), 0).first;
+        }
+        cuisine_count->second++;
+        prep_min = matched == 0 ? prep_time : std::min(prep_min, prep_time);
+        prep_max = matched == 0 ? prep_time : std::max(prep_max, prep_time);
+        prep_sum += prep_time;
+        price_sum += price;
+        matched++;
+        if (out.is_open()) {
+            out.write(row.line.data(), static_cast<std::streamsize>(row.line.size()));
+            out.put('\n');
+        }
+    }
+    if (reader.failed()) {
+        std::cerr << "menuscan: read error in " << menu_path << " after line " << reader.getLineNumber() << std::endl;
+        return 1;
+    }
+    if (out.is_open() && !out.flush()) {
+        std::cerr << "menuscan: write to " << export_path << " failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "lines read:      " << reader.getLineNumber() << " (" << reader.getBytesRead() << " bytes)\n"
+              << "malformed rows:  " << reader.getSkippedRows() + unparsable << "\n"
+              << "matching rows:   " << matched << "\n"
+              << "by type:\n";
+    for (const auto& count : by_type) {
+        std::cout << "  " << std::left << std::setw(15) << count.first << count.second << "\n";
+    }
+    std::cout << "by cuisine:\n";
+    for (const auto& count : by_cuisine) {
+        std::cout << "  " << std::left << std::setw(15) << count.first << count.second << "\n";
+    }
+    if (matched > 0) {
+        std::cout << std::fixed << std::setprecision(2)
+                  << "prep time:       avg " << prep_sum / matched << ", min " << prep_min << ", max " << prep_max
+                  << "\n"
+                  << "price:           avg " << price_sum / matched << "\n";
+    }
+    std::cout << "peak buffer:     " << reader.getBufferSize() << " bytes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file simulate.cpp
+ * @brief Command-line driver that sweeps KitchenSimulator scenarios for capacity planning.
+ *
+ * Usage: simulate [options] [menu.csv ...]
+ *   --cooks MIN-MAX     cooks per station to sweep, applied to every station independently (default 1-4)
+ *   --rates R1,R2,...   mean arrivals per minute to sweep (default 0.1,0.2,0.5)
+ *   --orders N          orders per scenario (default 2000)
+ *   --tray N            portions per BUFFET tray (default 8)
+ *   --seed S            base seed; every scenario uses the same stream for a given menu and rate (default 235)
+ *   --threads T         worker threads, 0 for one per core (default 0)
+ *
+ * Each menu file (Dishes.csv if none are given) is loaded through the Kitchen constructor; rows that are rejected,
+ * or that do not fit in the kitchen's Kitchen::DEFAULT_CAPACITY, are reported on stderr. One scenario is run for every
+ * combination of menu, arrival rate and appetizer/main/dessert staffing, and the results are
+ * printed as CSV.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Kitchen.hpp"
+#include "KitchenSimulator.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef SIM_CAPACITY
+// Kitchen::DEFAULT_CAPACITY is ArrayBag's, which the project's ArrayBag.hpp fixes at 100 whatever
+// -DARRAY_BAG_CAPACITY says, so a build asking for more stops here instead of
+// silently dropping dishes from larger menus.
+static_assert(Kitchen::DEFAULT_CAPACITY >= SIM_CAPACITY,
+              "SIM_CAPACITY exceeds Kitchen::DEFAULT_CAPACITY: this ArrayBag.hpp ignores -DARRAY_BAG_CAPACITY");
+#endif
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> menu_files;
+    int min_cooks = 1;
+    int max_cooks = 4;
+    std::vector<double> rates = {0.1, 0.2, 0.5};
+    int orders = 2000;
+    int tray = 8;
+    unsigned seed = 235;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--cooks" && has_value) {
+            std::string range = argv[++i];
+            size_t dash = range.find('-');
+            min_cooks = std::atoi(range.substr(0, dash).c_str());
+            max_cooks = dash == std::string::npos ? min_cooks : std::atoi(range.substr(dash + 1).c_str());
+        } else if (arg == "--rates" && has_value) {
+            rates.clear();
+            std::stringstream rates_ss(argv[++i]);
+            std::string rate;
+            while (std::getline(rates_ss, rate, ',')) {
+                rates.push_back(std::atof(rate.c_str()));
+            }
+        } else if (arg == "--orders" && has_value) {
+            orders = std::atoi(argv[++i]);
+        } else if (arg == "--tray" && has_value) {
+            tray = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && has_value) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--threads" && has_value) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "usage: simulate [--cooks MIN-MAX] [--rates R1,R2] [--orders N] [--tray N] "
+                      << "[--seed S] [--threads T] [menu.csv ...]" << std::endl;
+            return 1;
+        } else {
+            menu_files.push_back(arg);
+        }
+    }
+    if (menu_files.empty()) {
+        menu_files.push_back("Dishes.csv");
+    }
+    if (min_cooks < 1 || max_cooks < min_cooks) {
+        std::cerr << "simulate: --cooks must be a range of at least 1 cook" << std::endl;
+        return 1;
+    }
+
+    KitchenSimulator simulator;
+    std::vector<int> menus;
+    for (const std::string& file : menu_files) {
+        // Built with a large bag capacity, the kitchen is too big for the stack.
+        std::unique_ptr<Kitchen> kitchen(new Kitchen(file));
+        if (kitchen->isEmpty()) {
+            std::cerr << "simulate: no dishes loaded from " << file << std::endl;
+            return 1;
+        }
+        const Kitchen::ParseReport& loaded = kitchen->getLoadReport();
+        uint64_t dropped = loaded.rows - loaded.rejected - kitchen->getCurrentSize();
+        if (loaded.rejected > 0 || dropped > 0) {
+            std::cerr << "simulate: " << file << ": " << loaded.rejected << " rows rejected, " << dropped
+                      << " dishes over the capacity of " << Kitchen::DEFAULT_CAPACITY << " dropped" << std::endl;
+        }
+        menus.push_back(simulator.addMenu(file, kitchen->toVector()));
+    }
+
+    std::vector<KitchenSimulator::Scenario> scenarios;
+    for (int menu : menus) {
+        for (double rate : rates) {
+            for (int a = min_cooks; a <= max_cooks; a++) {
+                for (int m = min_cooks; m <= max_cooks; m++) {
+                    for (int d = min_cooks; d <= max_cooks; d++) {
+                        KitchenSimulator::Scenario scenario;
+                        scenario.label = simulator.getMenuLabel(menu);
+                        scenario.menu = menu;
+                        scenario.cooks[KitchenSimulator::APPETIZER_STATION] = a;
+                        scenario.cooks[KitchenSimulator::MAIN_COURSE_STATION] = m;
+                        scenario.cooks[KitchenSimulator::DESSERT_STATION] = d;
+                        scenario.arrival_rate = rate;
+                        scenario.order_count = orders;
+                        scenario.buffet_tray_size = tray;
+                        scenario.seed = seed;
+                        scenarios.push_back(scenario);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<KitchenSimulator::Result> results = simulator.runAll(scenarios, threads);
+
+    std::cout << "menu,rate,appetizer_cooks,main_cooks,dessert_cooks,orders,throughput_per_hour,"
+              << "avg_queue,max_queue,p50,p90,p99,max,util_appetizer,util_main,util_dessert" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < results.size(); i++) {
+        const KitchenSimulator::Scenario& s = scenarios[i];
+        const KitchenSimulator::Result& r = results[i];
+        std::cout << r.label << ',' << s.arrival_rate << ','
+                  << s.cooks[KitchenSimulator::APPETIZER_STATION] << ','
+                  << s.cooks[KitchenSimulator::MAIN_COURSE_STATION] << ','
+                  << s.cooks[KitchenSimulator::DESSERT_STATION] << ','
+                  << r.orders_completed << ',' << r.throughput_per_hour << ','
+                  << r.avg_queue_depth << ',' << r.max_queue_depth << ','
+                  << r.latency_p50 << ',' << r.latency_p90 << ',' << r.latency_p99 << ',' << r.latency_max << ','
+                  << r.utilization[KitchenSimulator::APPETIZER_STATION] << ','
+                  << r.utilization[KitchenSimulator::MAIN_COURSE_STATION] << ','
+                  << r.utilization[KitchenSimulator::DESSERT_STATION] << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,513 @@
+/**
+ * @file tests.cpp
+ * @brief This file contains the regression tests run by `make test`.
+ *
+ * Each test builds what it needs, from Dishes.csv or by hand, and checks it with CHECK. Every test runs even if an
+ * earlier one failed, and the program exits non-zero if any check did.
+ *
+ * @date 10/18/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Appetizer.hpp"
+#include "DishCodec.hpp"
+#include "Kitchen.hpp"
+#include "KitchenCluster.hpp"
+#include "KitchenQuery.hpp"
+#include "MainCourse.hpp"
+#include "OrderProtocol.hpp"
+#include "OrderServer.hpp"
+#include "SharedKitchen.hpp"
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+namespace {
+    int failures = 0;
+
+    void check(const bool& passed, const char* condition, const char* file, const int& line) {
+        if (!passed) {
+            std::cerr << file << ":" << line << ": CHECK(" << condition << ") failed" << std::endl;
+            failures++;
+        }
+    }
+
+    /**
+     * @return The number of dishes run() produces for `query`.
+     */
+    size_t runCount(const KitchenQuery& query) {
+        size_t produced = 0;
+        for (Dish* dish : query.run()) {
+            produced += dish != nullptr;
+        }
+        return produced;
+    }
+
+    /**
+     * A range with min > max matches nothing, whichever source the query reads from.
+     */
+    void testReversedRanges() {
+        Kitchen kitchen("Dishes.csv");
+        KitchenQuery prep(kitchen);
+        prep.prepTime(40, 20);
+        CHECK(prep.count() == 0);
+        CHECK(runCount(prep) == 0);
+
+        KitchenQuery price(kitchen);
+        price.price(9.0, 3.0);
+        CHECK(price.count() == 0);
+        CHECK(runCount(price) == 0);
+
+        KitchenQuery nan_price(kitchen);
+        nan_price.price(std::numeric_limits<double>::quiet_NaN(), 100.0);
+        CHECK(nan_price.count() == 0);
+        CHECK(runCount(nan_price) == 0);
+
+        KitchenQuery both(kitchen);
+        both.cuisine(Dish::ITALIAN).prepTime(40, 20);
+        CHECK(both.count() == 0);
+        CHECK(runCount(both) == 0);
+    }
+
+    /**
+     * @return A new appetizer called `name` priced `price`.
+     */
+    Dish* appetizer(const std::string& name, const double& price) {
+        return new Appetizer(name, {"Bread"}, 10, price, Dish::ITALIAN, Appetizer::PLATED, 1, true);
+    }
+
+    /**
+     * A NaN price, even on the first dish indexed, leaves the price index ordered for every other dish.
+     */
+    void testNanPriceIndex() {
+        Kitchen kitchen;
+        Dish* nan_dish = appetizer("Mystery Plate", std::numeric_limits<double>::quiet_NaN());
+        CHECK(kitchen.newOrder(nan_dish));
+        const char* names[] = {"Alpha", "Bravo", "Charlie", "Delta", "Echo", "Foxtrot", "Golf", "Hotel", "India",
+                               "Juliet"};
+        for (int i = 0; i < 10; i++) {
+            CHECK(kitchen.newOrder(appetizer(names[i], i + 0.5)));
+        }
+        KitchenQuery query(kitchen);
+        query.price(2, 3);
+        CHECK(query.count() == 1);
+        CHECK(runCount(query) == 1);
+        KitchenQuery all(kitchen);
+        all.price(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+        CHECK(all.count() == 10);
+        CHECK(runCount(all) == 10);
+        for (Dish* dish : all.run()) {
+            CHECK(dish != nan_dish);
+        }
+        CHECK(kitchen.serveDish(nan_dish));
+        delete nan_dish;
+        CHECK(KitchenQuery(kitchen).price(0, 100).count() == 10);
+    }
+
+    /**
+     * A price of nan, inf or infinity is a parse error in a CSV row and an invalid encoding in DishCodec.
+     */
+    void testNonFinitePrices() {
+        const char* prices[] = {"nan", "NaN", "inf", "-inf", "infinity", "1e999"};
+        for (const char* price : prices) {
+            Kitchen::ParseError error;
+            std::string row = std::string("APPETIZER,Bruschetta,Tomatoes;Basil,15,") + price + ",ITALIAN,PLATED;2;true";
+            Dish* dish = Kitchen::parseDish(row, error);
+            CHECK(dish == nullptr);
+            CHECK(error.field == "Price" && error.value == price);
+            delete dish;
+        }
+        Kitchen::ParseError error;
+        Dish* dish = Kitchen::parseDish("APPETIZER,Bruschetta,Tomatoes;Basil,15,6.99,ITALIAN,PLATED;2;true", error);
+        CHECK(dish != nullptr);
+        delete dish;
+
+        const double bad[] = {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()};
+        for (const double& price : bad) {
+            std::unique_ptr<Dish> source(appetizer("Bruschetta", price));
+            std::string bytes;
+            DishCodec::encode(*source, bytes);
+            const char* cursor = bytes.data();
+            CHECK(DishCodec::decode(cursor, bytes.data() + bytes.size()) == nullptr);
+        }
+    }
+
+    /**
+     * A range returned by run() on a temporary query outlives the query it came from.
+     */
+    void testRunOnTemporary() {
+        Kitchen kitchen("Dishes.csv");
+        size_t expected = KitchenQuery(kitchen).price(6, 8).count();
+        CHECK(expected > 0);
+        size_t produced = 0;
+        for (Dish* dish : KitchenQuery(kitchen).price(6, 8).run()) {
+            CHECK(dish->getPrice() >= 6 && dish->getPrice() <= 8);
+            produced++;
+        }
+        CHECK(produced == expected);
+        KitchenQuery::Range range = KitchenQuery(kitchen).cuisine(Dish::ITALIAN).prepTime(0, 30).run();
+        produced = 0;
+        for (Dish* dish : range) {
+            CHECK(dish->getCuisineType() == "ITALIAN" && dish->getPrepTime() <= 30);
+            produced++;
+        }
+        CHECK(produced == KitchenQuery(kitchen).cuisine(Dish::ITALIAN).prepTime(0, 30).count());
+    }
+
+    /**
+     * getIngredients() and getSideDishes() still return the std::vector copies callers were written against.
+     */
+    void testListGetters() {
+        MainCourse main_course("Grilled Salmon", {"Salmon", "Lemon", "Dill"}, 25, 18.5, Dish::FRENCH,
+                               MainCourse::GRILLED, "Fish", {{"Rice", MainCourse::STARCHES}}, true);
+        std::vector<std::string> ingredients = main_course.getIngredients();
+        std::vector<MainCourse::SideDish> sides = main_course.getSideDishes();
+        CHECK(ingredients == std::vector<std::string>({"Salmon", "Lemon", "Dill"}));
+        CHECK(sides.size() == 1 && sides[0].name == "Rice");
+        CHECK(main_course.getIngredientList().size() == ingredients.size());
+        CHECK(main_course.getSideDishList().size() == sides.size());
+    }
+
+    /**
+     * Kitchen's release functions release every qualifying dish, including the ones serveDish() moves into a
+     * freed position.
+     */
+    void testKitchenRelease() {
+        Kitchen kitchen("Dishes.csv");
+        // The release functions leave the dishes they serve to the caller.
+        std::vector<Dish*> loaded = kitchen.toVector();
+        int size = kitchen.getCurrentSize();
+        int below = KitchenQuery(kitchen).prepTime(INT_MIN, 29).count();
+        CHECK(below > 1);
+        CHECK(kitchen.releaseDishesBelowPrepTime(30) == below);
+        CHECK(kitchen.getCurrentSize() == size - below);
+        CHECK(KitchenQuery(kitchen).prepTime(INT_MIN, 29).count() == 0);
+
+        int italian = kitchen.tallyCuisineTypes("ITALIAN");
+        CHECK(italian > 1);
+        CHECK(kitchen.releaseDishesOfCuisineType("ITALIAN") == italian);
+        CHECK(kitchen.tallyCuisineTypes("ITALIAN") == 0);
+        for (Dish* dish : loaded) {
+            if (!kitchen.contains(dish)) {
+                delete dish;
+            }
+        }
+    }
+
+    /**
+     * A cluster refuses a dish equal to one it holds, whether it is ordered again or read again from a file.
+     */
+    void testClusterDuplicates() {
+        KitchenCluster cluster(4, KitchenCluster::BY_HASH, 1);
+        KitchenCluster::LoadReport first = cluster.loadFile("Dishes.csv");
+        CHECK(first.accepted > 0 && first.duplicates == 0);
+        KitchenCluster::LoadReport second = cluster.loadFile("Dishes.csv");
+        CHECK(second.accepted == 0);
+        CHECK(second.duplicates == first.accepted);
+        CHECK(cluster.getCurrentSize() == first.accepted);
+
+        std::unique_ptr<Dish> copy(appetizer("Cluster Special", 7.5));
+        CHECK(cluster.newOrder(appetizer("Cluster Special", 7.5)));
+        CHECK(!cluster.newOrder(copy.get()));
+        CHECK(cluster.newOrder(appetizer("Cluster Special", 8.5)));
+
+        KitchenCluster locations(2, KitchenCluster::BY_LOCATION, 1);
+        CHECK(locations.loadFile("Dishes.csv", 0).accepted == first.accepted);
+        CHECK(locations.loadFile("Dishes.csv", 1).accepted == first.accepted);
+    }
+
+    /**
+     * The cluster's release functions release what one kitchen holding every dish would.
+     */
+    void testClusterRelease() {
+        Kitchen kitchen("Dishes.csv");
+        KitchenCluster cluster(4, KitchenCluster::BY_HASH, 1);
+        cluster.loadFile("Dishes.csv");
+        CHECK(cluster.getCurrentSize() == kitchen.getCurrentSize());
+        int below = KitchenQuery(kitchen).prepTime(INT_MIN, 19).count();
+        CHECK(below > 0);
+        CHECK(cluster.releaseDishesBelowPrepTime(20) == below);
+        CHECK(cluster.getCurrentSize() == kitchen.getCurrentSize() - below);
+        CHECK(cluster.releaseDishesBelowPrepTime(20) == 0);
+        CHECK(cluster.releaseDishesBelowPrepTime(INT_MIN) == 0);
+
+        int italian = cluster.tallyCuisineTypes("ITALIAN");
+        CHECK(italian > 0);
+        CHECK(cluster.releaseDishesOfCuisineType("ITALIAN") == italian);
+        CHECK(cluster.tallyCuisineTypes("ITALIAN") == 0);
+        CHECK(cluster.releaseDishesOfCuisineType("NOT A CUISINE") == 0);
+    }
+
+    /**
+     * A dietary view presents the adjusted dish from a shared delta, leaves the dish alone, and reports itself
+     * invalid once the dish changes or is served.
+     */
+    void testDietaryViews() {
+        Kitchen kitchen;
+        Dish* dish = new MainCourse("Chicken Pasta", {"Chicken", "Pasta", "Cream", "Beef", "Pork"}, 30, 14.5,
+                                    Dish::ITALIAN, MainCourse::BOILED, "Chicken",
+                                    {{"Rice", MainCourse::GRAIN}, {"Salad", MainCourse::SALAD}}, false);
+        CHECK(kitchen.newOrder(dish));
+        const Dish::DietaryRequest vegan = {true, true, true, false, false, false};
+        DietaryViews::View view = kitchen.dietaryView(dish, vegan);
+        CHECK(view.isValid());
+        CHECK(&view.getDish() == dish);
+        CHECK(view.getIngredients() == std::vector<std::string>({"Beans", "Pasta", "Mushrooms"}));
+        CHECK(view.getDelta().dropped_sides == std::vector<uint32_t>({0}));
+        CHECK(dish->getIngredientList().size() == 5);
+        std::unique_ptr<Dish> adjusted = view.materialize();
+        std::unique_ptr<Dish> expected(dish->clone());
+        expected->dietaryAccommodations(vegan);
+        CHECK(adjusted->getIngredients() == expected->getIngredients());
+        CHECK(static_cast<MainCourse&>(*adjusted).getProteinType() == "Tofu");
+        CHECK(static_cast<MainCourse&>(*adjusted).getSideDishes().size() == 1);
+
+        CHECK(&kitchen.dietaryView(dish, vegan).getDelta() == &view.getDelta());
+        dish->setPrice(15.5);
+        CHECK(!view.isValid());
+        DietaryViews::View rebuilt = kitchen.dietaryView(dish, vegan);
+        CHECK(rebuilt.isValid() && &rebuilt.getDelta() != &view.getDelta());
+        CHECK(kitchen.serveDish(dish));
+        delete dish;
+        CHECK(!rebuilt.isValid());
+    }
+
+    /**
+     * @return A shared-memory name no other test run uses.
+     */
+    std::string segmentName(const std::string& test) {
+        return "/kitchen-tests-" + test + "-" + std::to_string(::getpid());
+    }
+
+    /**
+     * A reader of a segment that was replaced or closed learns so from isSuperseded(), and finds the new one by
+     * opening the name again; the replaced writer neither publishes nor removes its successor's name.
+     */
+    void testSharedSuperseded() {
+        std::string name = segmentName("superseded");
+        Kitchen kitchen("Dishes.csv");
+        std::vector<Dish*> dishes = kitchen.toVector();
+        SharedKitchen first;
+        SharedKitchen reader;
+        CHECK(first.create(name, 1 << 20) && first.publish(dishes));
+        CHECK(reader.open(name) && reader.refresh());
+        CHECK(!reader.isSuperseded());
+
+        SharedKitchen second;
+        CHECK(second.create(name, 1 << 20) && second.publish(std::vector<Dish*>(dishes.begin(), dishes.begin() + 3)));
+        CHECK(reader.isSuperseded());
+        CHECK(!reader.refresh());
+        CHECK(reader.isCurrent() && reader.snapshot().size() == dishes.size());
+        CHECK(!first.publish(dishes));
+        first.close();
+
+        CHECK(reader.open(name) && reader.refresh());
+        CHECK(!reader.isSuperseded() && reader.snapshot().size() == 3);
+        second.close();
+        CHECK(reader.isSuperseded());
+        CHECK(!reader.open(name));
+    }
+
+    /**
+     * @return `count` main courses named `prefix` followed by two letters, each with `ingredients`.
+     */
+    std::vector<Dish*> namedCourses(const std::string& prefix, const int& count,
+                                    const std::vector<std::string>& ingredients) {
+        std::vector<Dish*> dishes;
+        for (int i = 0; i < count; i++) {
+            std::string name = prefix + " " + static_cast<char>('a' + i / 26) + static_cast<char>('a' + i % 26);
+            dishes.push_back(new MainCourse(name, ingredients, 10 + i, 5.0 + i, Dish::ITALIAN, MainCourse::GRILLED,
+                                            "Beef", {{"Rice", MainCourse::STARCHES}}, false));
+        }
+        return dishes;
+    }
+
+    /**
+     * Reads the segment `name` until it has seen catalog `last`, checking that every catalog it read whole is
+     * one of the two the writer alternates between.
+     * @return The process exit status: 0 if no mixed catalog was read and at least one whole one was.
+     */
+    int readUntil(const std::string& name, const uint64_t& last) {
+        SharedKitchen reader;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (!reader.open(name)) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return 2;
+            }
+        }
+        int whole = 0;
+        while (reader.getVersion() < last || !reader.isCurrent()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return 2;
+            }
+            reader.refresh();
+            Kitchen kitchen;
+            size_t size = reader.snapshot().size();
+            int loaded = reader.loadInto(kitchen);
+            if (loaded != static_cast<int>(size) || !reader.isCurrent()) {
+                continue;
+            }
+            if (size != 50 && size != 70) {
+                return 1;
+            }
+            char initial = size == 50 ? 'A' : 'B';
+            for (Dish* dish : kitchen.toVector()) {
+                if (dish->getName()[0] != initial) {
+                    return 1;
+                }
+            }
+            whole++;
+        }
+        return whole > 0 ? 0 : 3;
+    }
+
+    /**
+     * Three reader processes poll the segment while the writer publishes 2000 catalogs; none of them ever
+     * loads a catalog mixed from two publishes.
+     */
+    void testSharedStress() {
+        const uint64_t publishes = 2000;
+        std::string name = segmentName("stress");
+        std::vector<Dish*> alpha = namedCourses("Alpha", 50, {"Salt", "Pepper"});
+        std::vector<Dish*> bravo = namedCourses("Bravo", 70, {"Sugar", "Flour", "Milk"});
+        SharedKitchen writer;
+        CHECK(writer.create(name, 1 << 20) && writer.publish(alpha));
+        std::vector<pid_t> readers;
+        for (int r = 0; r < 3; r++) {
+            pid_t pid = ::fork();
+            if (pid == 0) {
+                // The child shares the writer's objects, so it leaves without running their destructors.
+                ::_exit(readUntil(name, publishes));
+            }
+            readers.push_back(pid);
+        }
+        for (uint64_t k = 1; k < publishes; k++) {
+            CHECK(writer.publish(k % 2 == 0 ? alpha : bravo));
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+        CHECK(writer.getVersion() == publishes);
+        for (pid_t pid : readers) {
+            int status = 0;
+            CHECK(::waitpid(pid, &status, 0) == pid);
+            CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        }
+        for (Dish* dish : alpha) {
+            delete dish;
+        }
+        for (Dish* dish : bravo) {
+            delete dish;
+        }
+    }
+
+    /**
+     * A writer that dies mid-publish is noticed by refresh() on its first attempt instead of after
+     * MAX_RETRIES.
+     */
+    void testSharedDeadWriter() {
+        std::string name = segmentName("dead");
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            SharedKitchen writer;
+            std::vector<Dish*> dishes = namedCourses("Alpha", 5, {"Salt"});
+            if (!writer.create(name, 1 << 16) || !writer.publish(dishes)) {
+                ::_exit(1);
+            }
+            // Leaves the sequence odd, as a writer killed inside publish() would.
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+            void* mapping = ::mmap(nullptr, sizeof(SharedKitchen::Control), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (fd < 0 || mapping == MAP_FAILED) {
+                ::_exit(1);
+            }
+            static_cast<SharedKitchen::Control*>(mapping)->sequence.fetch_add(1);
+            ::_exit(0);
+        }
+        int status = 0;
+        CHECK(::waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        SharedKitchen reader;
+        CHECK(reader.open(name));
+        CHECK(reader.isWriterDead());
+        CHECK(!reader.refresh());
+        CHECK(reader.getRetries() == 0);
+        ::shm_unlink(name.c_str());
+    }
+
+    /**
+     * @return The status of the response OrderServer::execute() gives to QUERY `query`.
+     */
+    uint8_t queryStatus(OrderServer& server, const OrderProtocol::Query& query) {
+        std::string payload;
+        OrderProtocol::encodeQuery(payload, query);
+        std::string response;
+        server.execute(OrderProtocol::QUERY, payload, response);
+        return response.size() > OrderProtocol::HEADER_SIZE
+            ? static_cast<uint8_t>(response[OrderProtocol::HEADER_SIZE]) : 0xff;
+    }
+
+    /**
+     * A QUERY frame with a reversed range or a non-finite price is refused, instead of reaching KitchenQuery.
+     */
+    void testQueryFrameBounds() {
+        Kitchen kitchen("Dishes.csv");
+        OrderServer server(kitchen);
+        OrderProtocol::Query query;
+        query.fields = OrderProtocol::Query::PREP_TIME;
+        query.prep_min = 40;
+        query.prep_max = 20;
+        query.limit = 5;
+        CHECK(queryStatus(server, query) == OrderProtocol::BAD_REQUEST);
+        query.prep_min = 20;
+        query.prep_max = 40;
+        CHECK(queryStatus(server, query) == OrderProtocol::OK);
+
+        query.fields = OrderProtocol::Query::PRICE;
+        query.price_min = 9.0;
+        query.price_max = 3.0;
+        CHECK(queryStatus(server, query) == OrderProtocol::BAD_REQUEST);
+        query.price_min = std::numeric_limits<double>::quiet_NaN();
+        CHECK(queryStatus(server, query) == OrderProtocol::BAD_REQUEST);
+        query.price_min = 0.0;
+        query.price_max = std::numeric_limits<double>::infinity();
+        CHECK(queryStatus(server, query) == OrderProtocol::BAD_REQUEST);
+        query.price_max = 10.0;
+        CHECK(queryStatus(server, query) == OrderProtocol::OK);
+        CHECK(server.getStats().bad_requests == 4);
+    }
+}
+
+int main() {
+    const struct {
+        const char* name;
+        void (*run)();
+    } tests[] = {
+        {"reversed ranges", testReversedRanges},
+        {"query frame bounds", testQueryFrameBounds},
+        {"NaN price index", testNanPriceIndex},
+        {"non-finite prices", testNonFinitePrices},
+        {"run() on a temporary query", testRunOnTemporary},
+        {"list getters", testListGetters},
+        {"Kitchen release", testKitchenRelease},
+        {"cluster duplicates", testClusterDuplicates},
+        {"cluster release", testClusterRelease},
+        {"dietary views", testDietaryViews},
+        {"shared segment superseded", testSharedSuperseded},
+        {"shared segment stress", testSharedStress},
+        {"shared segment dead writer", testSharedDeadWriter},
+    };
+    for (const auto& test : tests) {
+        int before = failures;
+        test.run();
+        std::cout << (failures == before ? "PASS " : "FAIL ") << test.name << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}